@@ -644,6 +644,7 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/jumbo_writer.cc',
         'src/gn/label.cc',
         'src/gn/label_pattern.cc',
+        'src/gn/label_pattern_set.cc',
         'src/gn/lib_file.cc',
         'src/gn/loader.cc',
         'src/gn/location.cc',
@@ -668,6 +669,9 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/operators.cc',
         'src/gn/output_conversion.cc',
         'src/gn/output_file.cc',
+        'src/gn/output_manifest.cc',
+        'src/gn/output_writer.cc',
+        'src/gn/parse_node_arena.cc',
         'src/gn/parse_node_value_adapter.cc',
         'src/gn/parse_tree.cc',
         'src/gn/parser.cc',
@@ -684,6 +688,7 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/scheduler.cc',
         'src/gn/scope.cc',
         'src/gn/scope_per_file_provider.cc',
+        'src/gn/script_host.cc',
         'src/gn/settings.cc',
         'src/gn/setup.cc',
         'src/gn/source_dir.cc',
@@ -702,6 +707,7 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/switches.cc',
         'src/gn/target.cc',
         'src/gn/target_generator.cc',
+        'src/gn/target_graph.cc',
         'src/gn/template.cc',
         'src/gn/token.cc',
         'src/gn/tokenizer.cc',
@@ -763,6 +769,7 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/functions_unittest.cc',
         'src/gn/hash_table_base_unittest.cc',
         'src/gn/header_checker_unittest.cc',
+        'src/gn/import_manager_unittest.cc',
         'src/gn/inherited_libraries_unittest.cc',
         'src/gn/input_conversion_unittest.cc',
         'src/gn/json_project_writer_unittest.cc',
@@ -771,6 +778,7 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/rust_project_writer_unittest.cc',
         'src/gn/rust_project_writer_helpers_unittest.cc',
         'src/gn/label_pattern_unittest.cc',
+        'src/gn/label_pattern_set_unittest.cc',
         'src/gn/label_unittest.cc',
         'src/gn/loader_unittest.cc',
         'src/gn/metadata_unittest.cc',
@@ -790,6 +798,9 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/ninja_toolchain_writer_unittest.cc',
         'src/gn/operators_unittest.cc',
         'src/gn/output_conversion_unittest.cc',
+        'src/gn/output_manifest_unittest.cc',
+        'src/gn/output_writer_unittest.cc',
+        'src/gn/parse_node_arena_unittest.cc',
         'src/gn/parse_tree_unittest.cc',
         'src/gn/parser_unittest.cc',
         'src/gn/path_output_unittest.cc',
@@ -798,6 +809,7 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/runtime_deps_unittest.cc',
         'src/gn/scope_per_file_provider_unittest.cc',
         'src/gn/scope_unittest.cc',
+        'src/gn/script_host_unittest.cc',
         'src/gn/setup_unittest.cc',
         'src/gn/source_dir_unittest.cc',
         'src/gn/source_file_unittest.cc',
@@ -806,11 +818,13 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/string_utils_unittest.cc',
         'src/gn/substitution_pattern_unittest.cc',
         'src/gn/substitution_writer_unittest.cc',
+        'src/gn/target_graph_unittest.cc',
         'src/gn/target_unittest.cc',
         'src/gn/template_unittest.cc',
         'src/gn/test_with_scheduler.cc',
         'src/gn/test_with_scope.cc',
         'src/gn/tokenizer_unittest.cc',
+        'src/gn/trace_unittest.cc',
         'src/gn/unique_vector_unittest.cc',
         'src/gn/value_unittest.cc',
         'src/gn/vector_utils_unittest.cc',
@@ -820,7 +834,9 @@ def WriteGNNinja(path, platform, host, options, args_list):
         'src/gn/visual_studio_writer_unittest.cc',
         'src/gn/xcode_object_unittest.cc',
         'src/gn/xml_element_writer_unittest.cc',
+        'src/util/sys_info_unittest.cc',
         'src/util/test/gn_test.cc',
+        'src/util/worker_pool_unittest.cc',
       ], 'libs': []},
   }
 
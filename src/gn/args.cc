@@ -229,6 +229,14 @@ bool Args::DeclareArgs(const Scope::KeyValueMap& args,
   return true;
 }
 
+void Args::CopyDeclaredArgs(const Scope* source, Scope* dest) const {
+  std::lock_guard<std::mutex> lock(lock_);
+  const Scope::KeyValueMap& source_args =
+      declared_arguments_per_toolchain_[source->settings()];
+  Scope::KeyValueMap& dest_args = DeclaredArgumentsForToolchainLocked(dest);
+  dest_args.insert(source_args.begin(), source_args.end());
+}
+
 bool Args::VerifyAllOverridesUsed(Err* err) const {
   std::lock_guard<std::mutex> lock(lock_);
   Scope::KeyValueMap unused_overrides(all_overrides_);
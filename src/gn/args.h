@@ -75,6 +75,12 @@ class Args {
                    Scope* scope_to_set,
                    Err* err) const;
 
+  // Records the arguments declared so far in the toolchain of |source| as
+  // declared in the toolchain of |dest| too. Used when the result of the build
+  // config of the former is reused for the latter, instead of executing the
+  // declare_args blocks again.
+  void CopyDeclaredArgs(const Scope* source, Scope* dest) const;
+
   // Checks to see if any of the overrides ever used were never declared as
   // arguments. If there are, this returns false and sets the error.
   bool VerifyAllOverridesUsed(Err* err) const;
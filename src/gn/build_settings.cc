@@ -30,7 +30,7 @@ void BuildSettings::SetRootTargetLabel(const Label& r) {
 void BuildSettings::SetRootPath(const base::FilePath& r) {
   DCHECK(r.value()[r.value().size() - 1] != base::FilePath::kSeparators[0]);
   root_path_ = r.NormalizePathSeparatorsTo('/');
-  root_path_utf8_ = FilePathToUTF8(root_path_);
+  root_path_utf8_ = StringAtom(FilePathToUTF8(root_path_));
 }
 
 void BuildSettings::SetSecondarySourcePath(const SourceDir& d) {
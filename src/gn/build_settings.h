@@ -13,10 +13,13 @@
 
 #include "base/files/file_path.h"
 #include "gn/args.h"
+#include "gn/import_manager.h"
 #include "gn/label.h"
 #include "gn/scope.h"
+#include "gn/script_host.h"
 #include "gn/source_dir.h"
 #include "gn/source_file.h"
+#include "gn/string_atom.h"
 #include "gn/version.h"
 
 class Item;
@@ -39,7 +42,7 @@ class BuildSettings {
   // relative to this. Does not end in a [back]slash.
   const base::FilePath& root_path() const { return root_path_; }
   const base::FilePath& dotfile_name() const { return dotfile_name_; }
-  const std::string& root_path_utf8() const { return root_path_utf8_; }
+  const std::string& root_path_utf8() const { return root_path_utf8_.str(); }
   void SetRootPath(const base::FilePath& r);
   void set_dotfile_name(const base::FilePath& d) { dotfile_name_ = d; }
 
@@ -124,11 +127,21 @@ class BuildSettings {
     exec_script_whitelist_ = std::move(list);
   }
 
+  // The results of the imports that can be shared by all the toolchains.
+  SharedImports& shared_imports() const { return shared_imports_; }
+
+  // The hosts running the scripts of exec_script, or null if each script is
+  // run in a separate process.
+  ScriptHostPool* script_host_pool() const { return script_host_pool_.get(); }
+  void set_script_host_pool(std::unique_ptr<ScriptHostPool> pool) {
+    script_host_pool_ = std::move(pool);
+  }
+
  private:
   Label root_target_label_;
   base::FilePath dotfile_name_;
   base::FilePath root_path_;
-  std::string root_path_utf8_;
+  StringAtom root_path_utf8_;  // An atom so it can key memos, see OutputFile.
   base::FilePath secondary_source_path_;
   base::FilePath python_path_;
 
@@ -145,6 +158,10 @@ class BuildSettings {
 
   std::unique_ptr<SourceFileSet> exec_script_whitelist_;
 
+  // Not copied with the settings.
+  mutable SharedImports shared_imports_;
+  std::unique_ptr<ScriptHostPool> script_host_pool_;
+
   BuildSettings& operator=(const BuildSettings&) = delete;
 };
 
@@ -492,6 +492,8 @@ void Builder::ScheduleItemLoadIfNecessary(BuilderRecord* record) {
 bool Builder::ResolveItem(BuilderRecord* record, Err* err) {
   DCHECK(record->can_resolve() && !record->resolved());
 
+  ScopedTrace trace(TraceItem::TRACE_RESOLVE, record->label());
+
   if (record->type() == BuilderRecord::ITEM_TARGET) {
     Target* target = record->item()->AsTarget();
     if (!ResolveDeps(&target->public_deps(), err) ||
@@ -521,6 +523,7 @@ bool Builder::ResolveItem(BuilderRecord* record, Err* err) {
     return false;
   if (record->should_generate() && resolved_and_generated_callback_)
     resolved_and_generated_callback_(record);
+  trace.Done();
 
   // Recursively update everybody waiting on this item to be resolved.
   const BuilderRecordSet waiting_deps = record->waiting_on_resolution();
@@ -6,9 +6,12 @@
 
 #include <stddef.h>
 
+#include <algorithm>
+#include <set>
 #include <sstream>
 
 #include "base/command_line.h"
+#include "base/files/file_enumerator.h"
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
@@ -25,6 +28,7 @@
 #include "gn/switches.h"
 #include "gn/tokenizer.h"
 #include "util/build_config.h"
+#include "util/worker_pool.h"
 
 #if defined(OS_WIN)
 #include <fcntl.h>
@@ -47,6 +51,11 @@ const char kFormat_Help[] =
 
   Formats .gn file to a standard format.
 
+  An argument naming a directory formats all the .gn and .gni files found
+  below it, except in hidden directories and in build directories (those
+  containing a build.ninja file). Files are formatted in parallel, and
+  results are reported in the order of the arguments.
+
   The contents of some lists ('sources', 'deps', etc.) will be sorted to a
   canonical order. To suppress this, you can add a comment of the form "#
   NOSORT" immediately preceding the assignment. e.g.
@@ -84,6 +93,7 @@ Examples
   gn format //some/BUILD.gn //some/other/BUILD.gn //and/another/BUILD.gn
   gn format some\\BUILD.gn
   gn format /abspath/some/BUILD.gn
+  gn format --dry-run //some/dir
   gn format --stdin
   gn format --read-tree=json //rewritten/BUILD.gn
 )";
@@ -1243,6 +1253,144 @@ bool FormatJsonToString(const std::string& json, std::string* output) {
   return true;
 }
 
+namespace {
+
+// Formats the contents of |file|. On failure, |err| may refer to |file|, so it
+// must outlive any printing of the error.
+bool FormatInputFile(InputFile* file,
+                     TreeDumpMode dump_tree,
+                     std::string* output,
+                     std::string* dump_output,
+                     Err* err) {
+  // Tokenize.
+  std::vector<Token> tokens =
+      Tokenizer::Tokenize(file, err, WhitespaceTransform::kInvalidToSpace);
+  if (err->has_error())
+    return false;
+
+  // Parse.
+  std::unique_ptr<ParseNode> parse_node = Parser::Parse(tokens, err);
+  if (err->has_error())
+    return false;
+
+  DoFormat(parse_node.get(), dump_tree, output, dump_output);
+  return true;
+}
+
+bool IsBuildFileName(const base::FilePath::StringType& name) {
+  return base::EndsWith(name, FILE_PATH_LITERAL(".gn"),
+                        base::CompareCase::SENSITIVE) ||
+         base::EndsWith(name, FILE_PATH_LITERAL(".gni"),
+                        base::CompareCase::SENSITIVE);
+}
+
+bool IsSymbolicLink(const base::FileEnumerator::FileInfo& info) {
+#if defined(OS_WIN)
+  return (info.find_data().dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) !=
+         0;
+#else
+  return S_ISLNK(info.stat().st_mode);
+#endif
+}
+
+// A file to format, and what happened to it.
+struct FormatJob {
+  // How the file is reported in --dry-run mode.
+  std::string name;
+  SourceFile file;
+  base::FilePath path;
+
+  // Set when the command line argument couldn't be resolved to a file.
+  Err resolve_err;
+
+  // Set when |path| couldn't be read, with the reason in |err|.
+  bool read_failed = false;
+
+  // Holds the contents read from |path| while |err| points to them.
+  std::unique_ptr<InputFile> input;
+  Err err;
+
+  std::string dump_output;
+  bool differs = false;
+  bool written = false;
+};
+
+void RunFormatJob(FormatJob* job, TreeDumpMode dump_tree, bool dry_run) {
+  std::string original_contents;
+  if (!base::ReadFileToString(job->path, &original_contents)) {
+    job->read_failed = true;
+    job->err = Err(Location(),
+                   std::string("Couldn't read \"") + FilePathToUTF8(job->path));
+    return;
+  }
+
+  // Naming the input makes errors point to the file.
+  job->input = std::make_unique<InputFile>(job->file);
+  job->input->SetContents(original_contents);
+  std::string output;
+  if (!FormatInputFile(job->input.get(), dump_tree, &output, &job->dump_output,
+                       &job->err))
+    return;
+  job->input.reset();
+  if (dump_tree != TreeDumpMode::kInactive || original_contents == output)
+    return;
+
+  job->differs = true;
+  if (dry_run)
+    return;
+
+  // Update the file in-place.
+  if (base::WriteFile(job->path, output.data(),
+                      static_cast<int>(output.size())) == -1) {
+    job->err = Err(Location(),
+                   std::string("Failed to write formatted output back to \"") +
+                       FilePathToUTF8(job->path) + std::string("\"."));
+    return;
+  }
+  job->written = true;
+}
+
+}  // namespace
+
+void FindBuildFiles(const base::FilePath& dir,
+                    const base::FilePath& relative_dir,
+                    std::vector<base::FilePath>* files) {
+  std::vector<base::FilePath::StringType> file_names;
+  std::vector<base::FilePath::StringType> dir_names;
+  int file_type =
+      base::FileEnumerator::FILES | base::FileEnumerator::DIRECTORIES;
+#if !defined(OS_WIN)
+  file_type |= base::FileEnumerator::SHOW_SYM_LINKS;
+#endif
+  base::FileEnumerator traversal(dir, false, file_type);
+  for (base::FilePath current = traversal.Next(); !current.empty();
+       current = traversal.Next()) {
+    // Following links could loop, or reach and write a file twice.
+    base::FileEnumerator::FileInfo info = traversal.GetInfo();
+    if (IsSymbolicLink(info))
+      continue;
+    base::FilePath::StringType name = current.BaseName().value();
+    if (info.IsDirectory()) {
+      if (name[0] != FILE_PATH_LITERAL('.'))
+        dir_names.push_back(std::move(name));
+    } else if (IsBuildFileName(name)) {
+      file_names.push_back(std::move(name));
+    }
+  }
+
+  std::sort(file_names.begin(), file_names.end());
+  for (const auto& name : file_names)
+    files->push_back(relative_dir.Append(name));
+
+  std::sort(dir_names.begin(), dir_names.end());
+  for (const auto& name : dir_names) {
+    base::FilePath sub_dir = dir.Append(name);
+    if (base::PathExists(sub_dir.Append(FILE_PATH_LITERAL("build.ninja"))))
+      continue;
+    FindBuildFiles(sub_dir, relative_dir.Append(name), files);
+  }
+}
+
 bool FormatStringToString(const std::string& input,
                           TreeDumpMode dump_tree,
                           std::string* output,
@@ -1251,22 +1399,10 @@ bool FormatStringToString(const std::string& input,
   InputFile file(source_file);
   file.SetContents(input);
   Err err;
-  // Tokenize.
-  std::vector<Token> tokens =
-      Tokenizer::Tokenize(&file, &err, WhitespaceTransform::kInvalidToSpace);
-  if (err.has_error()) {
+  if (!FormatInputFile(&file, dump_tree, output, dump_output, &err)) {
     err.PrintToStdout();
     return false;
   }
-
-  // Parse.
-  std::unique_ptr<ParseNode> parse_node = Parser::Parse(tokens, &err);
-  if (err.has_error()) {
-    err.PrintToStdout();
-    return false;
-  }
-
-  DoFormat(parse_node.get(), dump_tree, output, dump_output);
   return true;
 }
 
@@ -1374,61 +1510,97 @@ int RunFormat(const std::vector<std::string>& args) {
     return 0;
   }
 
-  // TODO(scottmg): Eventually, this list of files should be processed in
-  // parallel.
-  int exit_code = 0;
+  // Expand the arguments to the list of files to format, then format them in
+  // parallel. The results are reported in the order of the list.
+  std::vector<FormatJob> jobs;
   for (const auto& arg : args) {
     Err err;
-    SourceFile file = source_dir.ResolveRelativeFile(Value(nullptr, arg), &err);
-    if (err.has_error()) {
-      err.PrintToStdout();
-      exit_code = 1;
+    SourceDir dir = source_dir.ResolveRelativeDir(Value(nullptr, arg), &err);
+    base::FilePath dir_path;
+    if (!err.has_error())
+      dir_path = setup.build_settings().GetFullPath(dir);
+    if (!dir_path.empty() && base::DirectoryExists(dir_path)) {
+      std::string prefix = arg;
+      if (!base::EndsWith(prefix, "/", base::CompareCase::SENSITIVE))
+        prefix.push_back('/');
+      std::vector<base::FilePath> files;
+      FindBuildFiles(dir_path, base::FilePath(), &files);
+      for (const auto& file : files) {
+        std::string relative =
+            FilePathToUTF8(file.NormalizePathSeparatorsTo('/'));
+        FormatJob& job = jobs.emplace_back();
+        job.name = prefix + relative;
+        job.file =
+            dir.ResolveRelativeFile(Value(nullptr, relative), &job.resolve_err);
+        job.path = dir_path.Append(file);
+      }
       continue;
     }
 
-    base::FilePath to_format = setup.build_settings().GetFullPath(file);
-    std::string original_contents;
-    if (!base::ReadFileToString(to_format, &original_contents)) {
-      Err(Location(),
-          std::string("Couldn't read \"") + FilePathToUTF8(to_format))
-          .PrintToStdout();
+    FormatJob& job = jobs.emplace_back();
+    job.name = arg;
+    job.file =
+        source_dir.ResolveRelativeFile(Value(nullptr, arg), &job.resolve_err);
+    if (!job.resolve_err.has_error())
+      job.path = setup.build_settings().GetFullPath(job.file);
+  }
+
+  // Overlapping arguments, like a directory and a file in it, name some files
+  // more than once. Only the first job of a file is kept, since concurrent
+  // jobs could read it while another one rewrites it.
+  std::set<base::FilePath> seen_paths;
+  size_t kept = 0;
+  for (FormatJob& job : jobs) {
+    if (!job.resolve_err.has_error()) {
+      base::FilePath key = base::MakeAbsoluteFilePath(job.path);
+      if (key.empty())
+        key = job.path;  // Doesn't exist, reading it will fail.
+      if (!seen_paths.insert(std::move(key)).second)
+        continue;
+    }
+    if (&jobs[kept] != &job)
+      jobs[kept] = std::move(job);
+    kept++;
+  }
+  jobs.resize(kept);
+
+  {
+    TaskGroup tasks(WorkerPool::Get());
+    for (FormatJob& job : jobs) {
+      if (job.resolve_err.has_error())
+        continue;
+      FormatJob* job_ptr = &job;
+      tasks.PostTask([job_ptr, dump_tree, dry_run]() {
+        RunFormatJob(job_ptr, dump_tree, dry_run);
+      });
+    }
+  }
+
+  int exit_code = 0;
+  for (const FormatJob& job : jobs) {
+    if (job.resolve_err.has_error()) {
+      job.resolve_err.PrintToStdout();
       exit_code = 1;
       continue;
     }
-
-    std::string output_string;
-    std::string dump_output_string;
-    if (!FormatStringToString(original_contents, dump_tree, &output_string,
-                              &dump_output_string)) {
+    if (job.read_failed) {
+      // Failed to read the file.
+      job.err.PrintToStdout();
       exit_code = 1;
       continue;
     }
-    printf("%s", dump_output_string.c_str());
-    if (dump_tree == TreeDumpMode::kInactive) {
-      if (dry_run) {
-        if (original_contents != output_string) {
-          printf("%s\n", arg.c_str());
-          exit_code = 2;
-        }
-        continue;
-      }
-      // Update the file in-place.
-      if (original_contents != output_string) {
-        if (base::WriteFile(to_format, output_string.data(),
-                            static_cast<int>(output_string.size())) == -1) {
-          Err(Location(),
-              std::string("Failed to write formatted output back to \"") +
-                  FilePathToUTF8(to_format) + std::string("\"."))
-              .PrintToStdout();
-          exit_code = 1;
-          continue;
-        }
-        if (!quiet) {
-          printf("Wrote formatted to '%s'.\n",
-                 FilePathToUTF8(to_format).c_str());
-        }
-      }
+    printf("%s", job.dump_output.c_str());
+    if (job.err.has_error()) {
+      job.err.PrintToStdout();
+      exit_code = 1;
+      continue;
+    }
+    if (job.differs && dry_run) {
+      printf("%s\n", job.name.c_str());
+      exit_code = 2;
     }
+    if (job.written && !quiet)
+      printf("Wrote formatted to '%s'.\n", FilePathToUTF8(job.path).c_str());
   }
 
   return exit_code;
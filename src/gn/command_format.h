@@ -6,6 +6,11 @@
 #define TOOLS_GN_COMAND_FORMAT_H_
 
 #include <string>
+#include <vector>
+
+namespace base {
+class FilePath;
+}
 
 class Setup;
 class SourceFile;
@@ -31,6 +36,14 @@ bool FormatStringToString(const std::string& input,
                           std::string* output,
                           std::string* dump_output);
 
+// Appends to |files| the .gn and .gni files below |dir|, as paths relative to
+// it with |relative_dir| prepended, in a stable order. Hidden directories
+// (".git", etc.), build directories, recognized by their build.ninja file, and
+// symbolic links are skipped.
+void FindBuildFiles(const base::FilePath& dir,
+                    const base::FilePath& relative_dir,
+                    std::vector<base::FilePath>* files);
+
 }  // namespace commands
 
 #endif  // TOOLS_GN_COMAND_FORMAT_H_
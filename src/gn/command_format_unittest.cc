@@ -4,14 +4,23 @@
 
 #include "gn/command_format.h"
 
+#include "base/command_line.h"
 #include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/strings/string_util.h"
 #include "gn/commands.h"
+#include "gn/filesystem_utils.h"
 #include "gn/setup.h"
 #include "gn/test_with_scheduler.h"
+#include "util/build_config.h"
 #include "util/exe_path.h"
 #include "util/test/test.h"
 
+#if !defined(OS_WIN)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 using FormatTest = TestWithScheduler;
 
 #define FORMAT_TEST(n)                                                      \
@@ -136,3 +145,172 @@ FORMAT_TEST(080)
 FORMAT_TEST(081)
 FORMAT_TEST(082)
 FORMAT_TEST(083)
+
+namespace {
+
+void WriteTestFile(const base::FilePath& path) {
+  ASSERT_TRUE(base::CreateDirectory(path.DirName()));
+  ASSERT_EQ(0, base::WriteFile(path, "", 0));
+}
+
+std::vector<std::string> FindBuildFilesAsStrings(const base::FilePath& dir) {
+  std::vector<base::FilePath> files;
+  commands::FindBuildFiles(dir, base::FilePath(), &files);
+  std::vector<std::string> result;
+  for (const auto& file : files)
+    result.push_back(FilePathToUTF8(file.NormalizePathSeparatorsTo('/')));
+  return result;
+}
+
+}  // namespace
+
+TEST_F(FormatTest, FindBuildFiles) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath root = temp_dir.GetPath();
+
+  // Created out of order to check that the result is sorted, files before
+  // sub directories.
+  WriteTestFile(root.AppendASCII("z").AppendASCII("BUILD.gn"));
+  WriteTestFile(root.AppendASCII("b.gni"));
+  WriteTestFile(root.AppendASCII("a").AppendASCII("c").AppendASCII("x.gni"));
+  WriteTestFile(root.AppendASCII("a").AppendASCII("BUILD.gn"));
+  WriteTestFile(root.AppendASCII("BUILD.gn"));
+
+  // Not build files.
+  WriteTestFile(root.AppendASCII("a").AppendASCII("foo.cc"));
+  WriteTestFile(root.AppendASCII("a").AppendASCII("foo.gn.orig"));
+
+  // Hidden directories are skipped.
+  WriteTestFile(root.AppendASCII(".git").AppendASCII("BUILD.gn"));
+
+  // So are build directories, recognized by their build.ninja.
+  WriteTestFile(root.AppendASCII("out").AppendASCII("build.ninja"));
+  WriteTestFile(root.AppendASCII("out").AppendASCII("args.gn"));
+
+  std::vector<std::string> expected = {"BUILD.gn", "b.gni", "a/BUILD.gn",
+                                       "a/c/x.gni", "z/BUILD.gn"};
+  EXPECT_EQ(expected, FindBuildFilesAsStrings(root));
+
+  // The relative directory is prepended to the results.
+  std::vector<base::FilePath> files;
+  commands::FindBuildFiles(root.AppendASCII("a"),
+                           base::FilePath(FILE_PATH_LITERAL("a")), &files);
+  ASSERT_EQ(2u, files.size());
+  EXPECT_EQ("a/BUILD.gn",
+            FilePathToUTF8(files[0].NormalizePathSeparatorsTo('/')));
+  EXPECT_EQ("a/c/x.gni",
+            FilePathToUTF8(files[1].NormalizePathSeparatorsTo('/')));
+}
+
+#if !defined(OS_WIN)
+TEST_F(FormatTest, FindBuildFilesSkipsSymbolicLinks) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath root = temp_dir.GetPath();
+
+  WriteTestFile(root.AppendASCII("a").AppendASCII("BUILD.gn"));
+
+  // A link back to the root would recurse forever if followed, and a link to
+  // a file would format it twice.
+  base::FilePath dir = root.AppendASCII("a");
+  ASSERT_TRUE(base::CreateSymbolicLink(root, dir.AppendASCII("loop")));
+  ASSERT_TRUE(base::CreateSymbolicLink(dir.AppendASCII("BUILD.gn"),
+                                       root.AppendASCII("link.gn")));
+
+  std::vector<std::string> expected = {"a/BUILD.gn"};
+  EXPECT_EQ(expected, FindBuildFilesAsStrings(root));
+}
+#endif
+
+#if !defined(OS_WIN)
+namespace {
+
+// Runs "gn format" with |args|, in --dry-run mode if |dry_run|, storing what
+// it printed in |output|.
+int RunFormatAndCaptureOutput(const std::vector<std::string>& args,
+                              bool dry_run,
+                              const base::FilePath& output_file,
+                              std::string* output) {
+  base::CommandLine* cmdline = base::CommandLine::ForCurrentProcess();
+  base::CommandLine saved_cmdline = *cmdline;
+  if (dry_run)
+    cmdline->AppendSwitch("dry-run");
+
+  fflush(stdout);
+  int saved_stdout = dup(STDOUT_FILENO);
+  int fd = open(output_file.value().c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+                0600);
+  dup2(fd, STDOUT_FILENO);
+  close(fd);
+
+  int exit_code = commands::RunFormat(args);
+
+  fflush(stdout);
+  dup2(saved_stdout, STDOUT_FILENO);
+  close(saved_stdout);
+  *cmdline = saved_cmdline;
+
+  base::ReadFileToString(output_file, output);
+  return exit_code;
+}
+
+}  // namespace
+
+TEST_F(FormatTest, RunFormatOverlappingArguments) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath root = temp_dir.GetPath();
+
+  // Large enough that concurrent jobs rewriting the same file would likely
+  // read it partially written.
+  std::string input;
+  std::string expected;
+  for (int i = 0; i < 2000; i++) {
+    std::string name = "t" + std::to_string(i);
+    input += "group(\"" + name + "\"){deps=[\":b\",\":a\"]}\n";
+    expected += "group(\"" + name +
+                "\") {\n  deps = [\n    \":a\",\n    \":b\",\n  ]\n}\n";
+  }
+  base::FilePath file = root.AppendASCII("a").AppendASCII("BUILD.gn");
+  ASSERT_TRUE(base::CreateDirectory(file.DirName()));
+  ASSERT_EQ(static_cast<int>(input.size()),
+            base::WriteFile(file, input.data(), input.size()));
+
+  base::FilePath old_current_dir;
+  ASSERT_TRUE(base::GetCurrentDirectory(&old_current_dir));
+  ASSERT_TRUE(base::SetCurrentDirectory(root));
+
+  // The directory, the file relative to the current directory and the file
+  // relative to the source root all name the same file.
+  std::vector<std::string> args;
+  for (int i = 0; i < 10; i++) {
+    args.push_back("a");
+    args.push_back("a/BUILD.gn");
+    args.push_back("//a/BUILD.gn");
+  }
+  base::FilePath output_file = temp_dir.GetPath().AppendASCII("output.txt");
+
+  // The file is only checked once, and reported under the name of its first
+  // occurrence.
+  std::string output;
+  int dry_run_exit_code =
+      RunFormatAndCaptureOutput(args, true, output_file, &output);
+
+  // It is also written once, rather than by several concurrent jobs.
+  std::string write_output;
+  int exit_code =
+      RunFormatAndCaptureOutput(args, false, output_file, &write_output);
+  ASSERT_TRUE(base::SetCurrentDirectory(old_current_dir));
+
+  EXPECT_EQ(2, dry_run_exit_code);
+  EXPECT_EQ("a/BUILD.gn\n", output);
+
+  EXPECT_EQ(0, exit_code);
+  EXPECT_EQ("Wrote formatted to '" + FilePathToUTF8(file) + "'.\n",
+            write_output);
+  std::string formatted;
+  ASSERT_TRUE(base::ReadFileToString(file, &formatted));
+  EXPECT_EQ(expected, formatted);
+}
+#endif  // !defined(OS_WIN)
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 
 #include "base/command_line.h"
@@ -17,14 +19,18 @@
 #include "gn/ninja_target_writer.h"
 #include "gn/ninja_tools.h"
 #include "gn/ninja_writer.h"
+#include "gn/output_manifest.h"
+#include "gn/output_writer.h"
 #include "gn/qt_creator_writer.h"
 #include "gn/runtime_deps.h"
 #include "gn/rust_project_writer.h"
 #include "gn/scheduler.h"
 #include "gn/setup.h"
 #include "gn/standard_out.h"
+#include "gn/string_output_buffer.h"
 #include "gn/switches.h"
 #include "gn/target.h"
+#include "gn/trace.h"
 #include "gn/visual_studio_writer.h"
 #include "gn/xcode_writer.h"
 
@@ -32,6 +38,9 @@ namespace commands {
 
 namespace {
 
+// Name of the OutputManifest file in the build directory.
+const char kOutputManifestFile[] = ".gn_outputs";
+
 const char kSwitchCheck[] = "check";
 const char kSwitchCleanStale[] = "clean-stale";
 const char kSwitchFilters[] = "filters";
@@ -63,22 +72,67 @@ const char kSwitchExportCompileCommands[] = "export-compile-commands";
 const char kSwitchExportRustProject[] = "export-rust-project";
 const char kSwitchJumboStats[] = "jumbo-stats";
 
-// Collects Ninja rules for each toolchain. The lock protectes the rules.
-struct TargetWriteInfo {
-  std::mutex lock;
-  NinjaWriter::PerToolchainRules rules;
+// Collects Ninja rules for each toolchain. Every worker thread streams the
+// rules of the targets it writes into its own output buffer, so the lock is
+// only taken the first time a given thread writes a target.
+class TargetWriteInfo {
+ public:
+  TargetWriteInfo() : id_(next_id_++) {}
+
+  // Called on worker threads.
+  void AddTarget(const Target* target) {
+    ThreadRules* thread_rules = GetThreadRules();
+    size_t begin = thread_rules->buffer.size();
+    NinjaTargetWriter::RunAndWriteFile(target, &thread_rules->buffer);
+    size_t end = thread_rules->buffer.size();
+    DCHECK_LT(begin, end);
+    thread_rules->rules.push_back({target, &thread_rules->buffer, begin, end});
+  }
+
+  // Returns the rules of all targets grouped by toolchain, in no particular
+  // order. Must only be called once all targets have been written. The
+  // returned rules point to storage owned by this object.
+  NinjaWriter::PerToolchainRules GetRules() const {
+    NinjaWriter::PerToolchainRules result;
+    std::lock_guard<std::mutex> lock(lock_);
+    for (const auto& thread_rules : threads_) {
+      for (const NinjaWriter::TargetRules& rules : thread_rules->rules)
+        result[rules.target->toolchain()].push_back(rules);
+    }
+    return result;
+  }
+
+ private:
+  struct ThreadRules {
+    StringOutputBuffer buffer;
+    std::vector<NinjaWriter::TargetRules> rules;
+  };
+
+  ThreadRules* GetThreadRules() {
+    // Cached per thread, keyed by the unique id of the owning object.
+    thread_local int cached_id = 0;
+    thread_local ThreadRules* cached_rules = nullptr;
+    if (cached_id != id_) {
+      std::lock_guard<std::mutex> lock(lock_);
+      threads_.push_back(std::make_unique<ThreadRules>());
+      cached_rules = threads_.back().get();
+      cached_id = id_;
+    }
+    return cached_rules;
+  }
+
+  static std::atomic<int> next_id_;
+  const int id_;
+
+  mutable std::mutex lock_;
+  std::vector<std::unique_ptr<ThreadRules>> threads_;
 };
 
+std::atomic<int> TargetWriteInfo::next_id_{1};
+
 // Called on worker thread to write the ninja file.
 void BackgroundDoWrite(TargetWriteInfo* write_info, const Target* target) {
-  std::string rule = NinjaTargetWriter::RunAndWriteFile(target);
-  DCHECK(!rule.empty());
-
-  {
-    std::lock_guard<std::mutex> lock(write_info->lock);
-    write_info->rules[target->toolchain()].emplace_back(target,
-                                                        std::move(rule));
-  }
+  write_info->AddTarget(target);
 }
 
 // Called on the main thread.
@@ -201,6 +255,7 @@ bool RunIdeWriter(const std::string& ide,
       base::CommandLine::ForCurrentProcess();
   bool quiet = command_line->HasSwitch(switches::kQuiet);
   base::ElapsedTimer timer;
+  ScopedTrace trace(TraceItem::TRACE_IDE_WRITE, ide);
 
   if (ide == kSwitchIdeValueEclipse) {
     bool res = EclipseWriter::RunAndWriteFile(build_settings, builder, err);
@@ -333,6 +388,7 @@ bool RunRustProjectWriter(const BuildSettings* build_settings,
   base::ElapsedTimer timer;
 
   std::string file_name = "rust-project.json";
+  ScopedTrace trace(TraceItem::TRACE_IDE_WRITE, file_name);
   bool res = RustProjectWriter::RunAndWriteFiles(build_settings, builder,
                                                  file_name, quiet, err);
   if (res && !quiet) {
@@ -352,6 +408,7 @@ bool RunCompileCommandsWriter(const BuildSettings* build_settings,
   base::ElapsedTimer timer;
 
   std::string file_name = "compile_commands.json";
+  ScopedTrace trace(TraceItem::TRACE_IDE_WRITE, file_name);
   std::string target_filters =
       command_line->GetSwitchValueASCII(kSwitchExportCompileCommands);
 
@@ -628,6 +685,14 @@ int RunGen(const std::vector<std::string>& args) {
       setup->set_check_system_includes(true);
   }
 
+  // Lets the outputs that didn't change be recognized without reading them.
+  // Deliberately leaked like the setup.
+  base::FilePath output_manifest_file =
+      setup->build_settings().GetFullPath(SourceFile(
+          setup->build_settings().build_dir().value() + kOutputManifestFile));
+  g_output_manifest = new OutputManifest();
+  g_output_manifest->Load(output_manifest_file);
+
   // Cause the load to also generate the ninja files for each target.
   TargetWriteInfo write_info;
   setup->builder().set_resolved_and_generated_callback(
@@ -635,9 +700,22 @@ int RunGen(const std::vector<std::string>& args) {
         ItemResolvedAndGeneratedCallback(&write_info, record);
       });
 
+  // The target ninja files are written in the background while the load
+  // goes on.
+  OutputWriter output_writer;
+  g_output_writer = &output_writer;
+
   // Do the actual load. This will also write out the target ninja files.
-  if (!setup->Run())
+  bool load_succeeded = setup->Run();
+  Err write_err;
+  bool write_succeeded = output_writer.Flush(&write_err);
+  g_output_writer = nullptr;
+  if (!load_succeeded)
+    return 1;
+  if (!write_succeeded) {
+    write_err.PrintToStdout();
     return 1;
+  }
 
   int jumbo_allowed_count = 0;
   int jumbo_disallowed_count = 0;
@@ -645,22 +723,23 @@ int RunGen(const std::vector<std::string>& args) {
 
   // Sort the targets in each toolchain according to their label. This makes
   // the ninja files have deterministic content.
-  for (auto& cur_toolchain : write_info.rules) {
+  NinjaWriter::PerToolchainRules rules = write_info.GetRules();
+  for (auto& cur_toolchain : rules) {
     std::sort(cur_toolchain.second.begin(), cur_toolchain.second.end(),
-              [](const NinjaWriter::TargetRulePair& a,
-                 const NinjaWriter::TargetRulePair& b) {
-                return a.first->label() < b.first->label();
+              [](const NinjaWriter::TargetRules& a,
+                 const NinjaWriter::TargetRules& b) {
+                return a.target->label() < b.target->label();
               });
 
     if (command_line->HasSwitch(kSwitchJumboStats)) {
-      for (const NinjaWriter::TargetRulePair& rule : cur_toolchain.second) {
-        if (rule.first->is_jumbo_configured()) {
-          if (rule.first->is_jumbo_allowed())
+      for (const NinjaWriter::TargetRules& rule : cur_toolchain.second) {
+        if (rule.target->is_jumbo_configured()) {
+          if (rule.target->is_jumbo_allowed())
             ++jumbo_allowed_count;
           else
             ++jumbo_disallowed_count;
-        } else if (rule.first->IsBinary()) {
-          jumbo_not_configured_targets.insert(rule.first);
+        } else if (rule.target->IsBinary()) {
+          jumbo_not_configured_targets.insert(rule.target);
         }
       }
     }
@@ -669,7 +748,7 @@ int RunGen(const std::vector<std::string>& args) {
   Err err;
   // Write the root ninja files.
   if (!NinjaWriter::RunAndWriteFiles(&setup->build_settings(), setup->builder(),
-                                     write_info.rules, &err)) {
+                                     rules, &err)) {
     err.PrintToStdout();
     return 1;
   }
@@ -712,6 +791,11 @@ int RunGen(const std::vector<std::string>& args) {
     return 1;
   }
 
+  if (!g_output_manifest->Save(output_manifest_file, &err)) {
+    err.PrintToStdout();
+    return 1;
+  }
+
   TickDelta elapsed_time = timer.Elapsed();
 
   if (!command_line->HasSwitch(switches::kQuiet)) {
@@ -746,8 +830,8 @@ int RunGen(const std::vector<std::string>& args) {
     OutputString("Done. ", DECORATION_GREEN);
 
     size_t targets_collected = 0;
-    for (const auto& rules : write_info.rules)
-      targets_collected += rules.second.size();
+    for (const auto& cur_toolchain : rules)
+      targets_collected += cur_toolchain.second.size();
 
     std::string stats =
         "Made " + base::NumberToString(targets_collected) + " targets from " +
@@ -5,12 +5,14 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <vector>
 
 #include "base/command_line.h"
 #include "base/strings/stringprintf.h"
 #include "gn/commands.h"
 #include "gn/setup.h"
 #include "gn/standard_out.h"
+#include "gn/target_graph.h"
 
 namespace commands {
 
@@ -24,7 +26,7 @@ enum class DepType { NONE, PUBLIC, PRIVATE, DATA };
 //    [0] = A, NONE (this has no dep type since nobody depends on it)
 //    [1] = B, PUBLIC
 //    [2] = C, PRIVATE
-using TargetDep = std::pair<const Target*, DepType>;
+using TargetDep = std::pair<TargetGraph::Id, DepType>;
 using PathVector = std::vector<TargetDep>;
 
 // How to search.
@@ -41,19 +43,30 @@ struct Options {
   bool with_data;
 };
 
-using WorkQueue = std::list<PathVector>;
+// The queue of the breadth-first search stores each path as its last target
+// and the index of the entry for the rest of the path.
+struct QueueEntry {
+  TargetGraph::Id id;
+  DepType type;
+  size_t parent;
+};
+
+const size_t kNoParent = static_cast<size_t>(-1);
 
 struct Stats {
-  Stats() : public_paths(0), other_paths(0) {}
+  explicit Stats(size_t target_count)
+      : public_paths(0),
+        other_paths(0),
+        found_paths(target_count, DepType::NONE) {}
 
   int total_paths() const { return public_paths + other_paths; }
 
   int public_paths;
   int other_paths;
 
-  // Stores targets that have a path to the destination, and whether that
-  // path is public, private, or data.
-  std::map<const Target*, DepType> found_paths;
+  // Stores, for each target ID, whether the target has a path to the
+  // destination that is public, private, or data. NONE means no path is known.
+  std::vector<DepType> found_paths;
 };
 
 // If the implicit_last_dep is not "none", this type indicates the
@@ -96,15 +109,20 @@ const char* StringForDepType(DepType type) {
 
 // Prints the given path. If the implicit_last_dep is not "none", the last
 // dependency will show an elided dependency with the given annotation.
-void PrintPath(const PathVector& path, DepType implicit_last_dep) {
+void PrintPath(const TargetGraph& graph,
+               const PathVector& path,
+               DepType implicit_last_dep) {
   if (path.empty())
     return;
 
   // Don't print toolchains unless they differ from the first target.
-  const Label& default_toolchain = path[0].first->label().GetToolchainLabel();
+  const Label& default_toolchain =
+      graph.target(path[0].first)->label().GetToolchainLabel();
 
   for (size_t i = 0; i < path.size(); i++) {
-    OutputString(path[i].first->label().GetUserVisibleName(default_toolchain));
+    OutputString(graph.target(path[i].first)
+                     ->label()
+                     .GetUserVisibleName(default_toolchain));
 
     // Output dependency type.
     if (i == path.size() - 1) {
@@ -151,8 +169,8 @@ void InsertTargetsIntoFoundPaths(const PathVector& path,
     // Don't overwrite an existing one. The algorithm works by first doing
     // public, then private, then data, so anything already there is guaranteed
     // at least as good as our addition.
-    if (stats->found_paths.find(pair.first) == stats->found_paths.end()) {
-      stats->found_paths.insert(std::make_pair(pair.first, type));
+    if (stats->found_paths[pair.first] == DepType::NONE) {
+      stats->found_paths[pair.first] = type;
       inserted = true;
     }
   }
@@ -166,31 +184,38 @@ void InsertTargetsIntoFoundPaths(const PathVector& path,
   }
 }
 
-void BreadthFirstSearch(const Target* from,
-                        const Target* to,
+// Returns the path ending at the given entry of the queue.
+PathVector GetPath(const std::vector<QueueEntry>& queue, size_t index) {
+  PathVector path;
+  for (; index != kNoParent; index = queue[index].parent)
+    path.emplace_back(queue[index].id, queue[index].type);
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+void BreadthFirstSearch(const TargetGraph& graph,
+                        TargetGraph::Id from,
+                        TargetGraph::Id to,
                         PrivateDeps private_deps,
                         DataDeps data_deps,
                         PrintWhat print_what,
                         Stats* stats) {
-  // Seed the initial stack with just the "from" target.
-  PathVector initial_stack;
-  initial_stack.emplace_back(from, DepType::NONE);
-  WorkQueue work_queue;
-  work_queue.push_back(initial_stack);
+  // Seed the queue with just the "from" target. Entries are never removed so
+  // that the paths can be rebuilt from them.
+  std::vector<QueueEntry> queue;
+  queue.push_back({from, DepType::NONE, kNoParent});
 
   // Track checked targets to avoid checking the same once more than once.
-  TargetSet visited;
-
-  while (!work_queue.empty()) {
-    PathVector current_path = work_queue.front();
-    work_queue.pop_front();
+  std::vector<bool> visited(graph.size());
 
-    const Target* current_target = current_path.back().first;
+  for (size_t current = 0; current < queue.size(); current++) {
+    TargetGraph::Id current_target = queue[current].id;
 
     if (current_target == to) {
       // Found a new path.
+      PathVector current_path = GetPath(queue, current);
       if (stats->total_paths() == 0 || print_what == PrintWhat::ALL)
-        PrintPath(current_path, DepType::NONE);
+        PrintPath(graph, current_path, DepType::NONE);
 
       // Insert all nodes on the path into the found paths list. Since we're
       // doing search breadth first, we know that the current path is the best
@@ -203,16 +228,15 @@ void BreadthFirstSearch(const Target* from,
       // Doing this here will mean that the output is sorted by length of items
       // printed (with the redundant parts of the path omitted) rather than
       // complete path length.
-      const auto& found_current_target =
-          stats->found_paths.find(current_target);
-      if (found_current_target != stats->found_paths.end()) {
+      DepType found_type = stats->found_paths[current_target];
+      if (found_type != DepType::NONE) {
+        PathVector current_path = GetPath(queue, current);
         if (stats->total_paths() == 0 || print_what == PrintWhat::ALL)
-          PrintPath(current_path, found_current_target->second);
+          PrintPath(graph, current_path, found_type);
 
         // Insert all nodes on the path into the found paths list since we know
         // everything along this path also leads to the destination.
-        InsertTargetsIntoFoundPaths(current_path, found_current_target->second,
-                                    stats);
+        InsertTargetsIntoFoundPaths(current_path, found_type, stats);
         continue;
       }
     }
@@ -220,47 +244,51 @@ void BreadthFirstSearch(const Target* from,
     // If we've already checked this one, stop. This should be after the above
     // check for a known-good check, because known-good ones will always have
     // been previously visited.
-    if (!visited.add(current_target))
+    if (visited[current_target])
       continue;
-
-    // Add public deps for this target to the queue.
-    for (const auto& pair : current_target->public_deps()) {
-      work_queue.push_back(current_path);
-      work_queue.back().push_back(TargetDep(pair.ptr, DepType::PUBLIC));
-    }
-
-    if (private_deps == PrivateDeps::INCLUDE) {
-      // Add private deps.
-      for (const auto& pair : current_target->private_deps()) {
-        work_queue.push_back(current_path);
-        work_queue.back().push_back(TargetDep(pair.ptr, DepType::PRIVATE));
-      }
-    }
-
-    if (data_deps == DataDeps::INCLUDE) {
-      // Add data deps.
-      for (const auto& pair : current_target->data_deps()) {
-        work_queue.push_back(current_path);
-        work_queue.back().push_back(TargetDep(pair.ptr, DepType::DATA));
+    visited[current_target] = true;
+
+    // Add the deps for this target to the queue: public ones first, then
+    // private and data ones if requested.
+    for (const TargetGraph::Edge& edge : graph.deps(current_target)) {
+      DepType type;
+      switch (edge.kind) {
+        case TargetGraph::EdgeKind::kPublic:
+          type = DepType::PUBLIC;
+          break;
+        case TargetGraph::EdgeKind::kPrivate:
+          if (private_deps != PrivateDeps::INCLUDE)
+            continue;
+          type = DepType::PRIVATE;
+          break;
+        case TargetGraph::EdgeKind::kData:
+          if (data_deps != DataDeps::INCLUDE)
+            continue;
+          type = DepType::DATA;
+          break;
+        default:
+          continue;
       }
+      queue.push_back({edge.id, type, current});
     }
   }
 }
 
-void DoSearch(const Target* from,
-              const Target* to,
+void DoSearch(const TargetGraph& graph,
+              TargetGraph::Id from,
+              TargetGraph::Id to,
               const Options& options,
               Stats* stats) {
-  BreadthFirstSearch(from, to, PrivateDeps::EXCLUDE, DataDeps::EXCLUDE,
+  BreadthFirstSearch(graph, from, to, PrivateDeps::EXCLUDE, DataDeps::EXCLUDE,
                      options.print_what, stats);
   if (!options.public_only) {
     // Check private deps.
-    BreadthFirstSearch(from, to, PrivateDeps::INCLUDE, DataDeps::EXCLUDE,
-                       options.print_what, stats);
+    BreadthFirstSearch(graph, from, to, PrivateDeps::INCLUDE,
+                       DataDeps::EXCLUDE, options.print_what, stats);
     if (options.with_data) {
       // Check data deps.
-      BreadthFirstSearch(from, to, PrivateDeps::INCLUDE, DataDeps::INCLUDE,
-                         options.print_what, stats);
+      BreadthFirstSearch(graph, from, to, PrivateDeps::INCLUDE,
+                         DataDeps::INCLUDE, options.print_what, stats);
     }
   }
 }
@@ -347,13 +375,17 @@ int RunPath(const std::vector<std::string>& args) {
     return 1;
   }
 
-  Stats stats;
-  DoSearch(target1, target2, options, &stats);
+  TargetGraph graph(setup->builder().GetAllResolvedTargets());
+  TargetGraph::Id id1 = graph.GetId(target1);
+  TargetGraph::Id id2 = graph.GetId(target2);
+
+  Stats stats(graph.size());
+  DoSearch(graph, id1, id2, options, &stats);
   if (stats.total_paths() == 0) {
     // If we don't find a path going "forwards", try the reverse direction.
     // Deps can only go in one direction without having a cycle, which will
     // have caused a run failure above.
-    DoSearch(target2, target1, options, &stats);
+    DoSearch(graph, id2, id1, options, &stats);
   }
 
   // This string is inserted in the results to annotate whether the result
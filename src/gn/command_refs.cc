@@ -4,8 +4,7 @@
 
 #include <stddef.h>
 
-#include <map>
-#include <set>
+#include <vector>
 
 #include "base/command_line.h"
 #include "base/files/file_util.h"
@@ -13,7 +12,6 @@
 #include "base/strings/string_util.h"
 #include "gn/commands.h"
 #include "gn/config_values_extractors.h"
-#include "gn/deps_iterator.h"
 #include "gn/filesystem_utils.h"
 #include "gn/input_file.h"
 #include "gn/item.h"
@@ -21,41 +19,44 @@
 #include "gn/standard_out.h"
 #include "gn/switches.h"
 #include "gn/target.h"
+#include "gn/target_graph.h"
 
 namespace commands {
 
 namespace {
 
-using TargetSet = TargetSet;
 using TargetVector = std::vector<const Target*>;
 
-// Maps targets to the list of targets that depend on them.
-using DepMap = std::multimap<const Target*, const Target*>;
+// gen_deps don't make a target reference another for this command.
+bool IsRef(const TargetGraph::Edge& edge) {
+  return edge.kind != TargetGraph::EdgeKind::kGen;
+}
 
-// Populates the reverse dependency map for the targets in the Setup.
-void FillDepMap(Setup* setup, DepMap* dep_map) {
-  for (auto* target : setup->builder().GetAllResolvedTargets()) {
-    for (const auto& dep_pair : target->GetDeps(Target::DEPS_ALL))
-      dep_map->insert(std::make_pair(dep_pair.ptr, target));
+bool HasRefs(const TargetGraph& graph, TargetGraph::Id id) {
+  for (const TargetGraph::Edge& edge : graph.reverse_deps(id)) {
+    if (IsRef(edge))
+      return true;
   }
+  return false;
 }
 
 // Forward declaration for function below.
-size_t RecursivePrintTargetDeps(const DepMap& dep_map,
-                                const Target* target,
-                                TargetSet* seen_targets,
+size_t RecursivePrintTargetDeps(const TargetGraph& graph,
+                                TargetGraph::Id id,
+                                std::vector<bool>* seen_targets,
                                 int indent_level);
 
-// Prints the target and its dependencies in tree form. If the set is non-null,
-// new targets encountered will be added to the set, and if a ref is in the set
-// already, it will not be recused into. When the set is null, all refs will be
-// printed.
+// Prints the target and its dependencies in tree form. If the vector is
+// non-null, new targets encountered will be marked in it, and if a ref is
+// marked already, it will not be recused into. When the vector is null, all
+// refs will be printed.
 //
 // Returns the number of items printed.
-size_t RecursivePrintTarget(const DepMap& dep_map,
-                            const Target* target,
-                            TargetSet* seen_targets,
+size_t RecursivePrintTarget(const TargetGraph& graph,
+                            TargetGraph::Id id,
+                            std::vector<bool>* seen_targets,
                             int indent_level) {
+  const Target* target = graph.target(id);
   std::string indent(indent_level * 2, ' ');
   size_t count = 1;
 
@@ -65,19 +66,20 @@ size_t RecursivePrintTarget(const DepMap& dep_map,
 
   bool print_children = true;
   if (seen_targets) {
-    if (!seen_targets->add(target)) {
+    if ((*seen_targets)[id]) {
       // Already seen.
       print_children = false;
       // Only print "..." if something is actually elided, which means that
       // the current target has children.
-      if (dep_map.lower_bound(target) != dep_map.upper_bound(target))
+      if (HasRefs(graph, id))
         OutputString("...");
     }
+    (*seen_targets)[id] = true;
   }
 
   OutputString("\n");
   if (print_children) {
-    count += RecursivePrintTargetDeps(dep_map, target, seen_targets,
+    count += RecursivePrintTargetDeps(graph, id, seen_targets,
                                       indent_level + 1);
   }
   return count;
@@ -85,44 +87,36 @@ size_t RecursivePrintTarget(const DepMap& dep_map,
 
 // Prints refs of the given target (not the target itself). See
 // RecursivePrintTarget.
-size_t RecursivePrintTargetDeps(const DepMap& dep_map,
-                                const Target* target,
-                                TargetSet* seen_targets,
+size_t RecursivePrintTargetDeps(const TargetGraph& graph,
+                                TargetGraph::Id id,
+                                std::vector<bool>* seen_targets,
                                 int indent_level) {
-  DepMap::const_iterator dep_begin = dep_map.lower_bound(target);
-  DepMap::const_iterator dep_end = dep_map.upper_bound(target);
   size_t count = 0;
-  for (DepMap::const_iterator cur_dep = dep_begin; cur_dep != dep_end;
-       cur_dep++) {
-    count += RecursivePrintTarget(dep_map, cur_dep->second, seen_targets,
-                                  indent_level);
+  for (const TargetGraph::Edge& edge : graph.reverse_deps(id)) {
+    if (IsRef(edge))
+      count += RecursivePrintTarget(graph, edge.id, seen_targets, indent_level);
   }
   return count;
 }
 
-void RecursiveCollectChildRefs(const DepMap& dep_map,
-                               const Target* target,
-                               TargetSet* results);
-
-// Recursively finds all targets that reference the given one, and additionally
-// adds the current one to the list.
-void RecursiveCollectRefs(const DepMap& dep_map,
-                          const Target* target,
-                          TargetSet* results) {
-  if (!results->add(target))
-    return;  // Already found this target.
-  RecursiveCollectChildRefs(dep_map, target, results);
-}
-
-// Recursively finds all targets that reference the given one.
-void RecursiveCollectChildRefs(const DepMap& dep_map,
-                               const Target* target,
-                               TargetSet* results) {
-  DepMap::const_iterator dep_begin = dep_map.lower_bound(target);
-  DepMap::const_iterator dep_end = dep_map.upper_bound(target);
-  for (DepMap::const_iterator cur_dep = dep_begin; cur_dep != dep_end;
-       cur_dep++)
-    RecursiveCollectRefs(dep_map, cur_dep->second, results);
+// Finds all targets that reference the given one, directly or not, and
+// appends the ones not marked in |found| yet to |results|.
+void CollectRefs(const TargetGraph& graph,
+                 TargetGraph::Id id,
+                 std::vector<bool>* found,
+                 TargetVector* results) {
+  std::vector<TargetGraph::Id> stack = {id};
+  while (!stack.empty()) {
+    TargetGraph::Id current = stack.back();
+    stack.pop_back();
+    for (const TargetGraph::Edge& edge : graph.reverse_deps(current)) {
+      if (!IsRef(edge) || (*found)[edge.id])
+        continue;
+      (*found)[edge.id] = true;
+      results->push_back(graph.target(edge.id));
+      stack.push_back(edge.id);
+    }
+  }
 }
 
 bool TargetReferencesConfig(const Target* target, const Config* config) {
@@ -155,66 +149,65 @@ void GetTargetsReferencingConfig(Setup* setup,
 }
 
 // Returns the number of matches printed.
-size_t DoTreeOutput(const DepMap& dep_map,
+size_t DoTreeOutput(const TargetGraph& graph,
                     const UniqueVector<const Target*>& implicit_target_matches,
                     const UniqueVector<const Target*>& explicit_target_matches,
                     bool all) {
-  TargetSet seen_targets;
+  std::vector<bool> seen_targets(graph.size());
+  std::vector<bool>* seen = all ? nullptr : &seen_targets;
   size_t count = 0;
 
   // Implicit targets don't get printed themselves.
-  for (const Target* target : implicit_target_matches) {
-    if (all)
-      count += RecursivePrintTargetDeps(dep_map, target, nullptr, 0);
-    else
-      count += RecursivePrintTargetDeps(dep_map, target, &seen_targets, 0);
-  }
+  for (const Target* target : implicit_target_matches)
+    count += RecursivePrintTargetDeps(graph, graph.GetId(target), seen, 0);
 
   // Explicit targets appear in the output.
-  for (const Target* target : implicit_target_matches) {
-    if (all)
-      count += RecursivePrintTarget(dep_map, target, nullptr, 0);
-    else
-      count += RecursivePrintTarget(dep_map, target, &seen_targets, 0);
-  }
+  for (const Target* target : implicit_target_matches)
+    count += RecursivePrintTarget(graph, graph.GetId(target), seen, 0);
 
   return count;
 }
 
 // Returns the number of matches printed.
 size_t DoAllListOutput(
-    const DepMap& dep_map,
+    const TargetGraph& graph,
     const UniqueVector<const Target*>& implicit_target_matches,
     const UniqueVector<const Target*>& explicit_target_matches) {
   // Output recursive dependencies, uniquified and flattened.
-  TargetSet results;
+  std::vector<bool> found(graph.size());
+  TargetVector results;
 
   for (const Target* target : implicit_target_matches)
-    RecursiveCollectChildRefs(dep_map, target, &results);
+    CollectRefs(graph, graph.GetId(target), &found, &results);
   for (const Target* target : explicit_target_matches) {
     // Explicit targets also get added to the output themselves.
-    results.insert(target);
-    RecursiveCollectChildRefs(dep_map, target, &results);
+    TargetGraph::Id id = graph.GetId(target);
+    if (!found[id]) {
+      found[id] = true;
+      results.push_back(target);
+    }
+    CollectRefs(graph, id, &found, &results);
   }
 
-  FilterAndPrintTargetSet(false, results);
-  return results.size();
+  size_t count = results.size();
+  FilterAndPrintTargets(false, &results);
+  return count;
 }
 
 // Returns the number of matches printed.
 size_t DoDirectListOutput(
-    const DepMap& dep_map,
+    const TargetGraph& graph,
     const UniqueVector<const Target*>& implicit_target_matches,
     const UniqueVector<const Target*>& explicit_target_matches) {
   TargetSet results;
 
   // Output everything that refers to the implicit ones.
   for (const Target* target : implicit_target_matches) {
-    DepMap::const_iterator dep_begin = dep_map.lower_bound(target);
-    DepMap::const_iterator dep_end = dep_map.upper_bound(target);
-    for (DepMap::const_iterator cur_dep = dep_begin; cur_dep != dep_end;
-         cur_dep++)
-      results.insert(cur_dep->second);
+    for (const TargetGraph::Edge& edge :
+         graph.reverse_deps(graph.GetId(target))) {
+      if (IsRef(edge))
+        results.insert(graph.target(edge.id));
+    }
   }
 
   // And just output the explicit ones directly (these are the target matches
@@ -427,16 +420,15 @@ int RunRefs(const std::vector<std::string>& args) {
   }
 
   // Construct the reverse dependency tree.
-  DepMap dep_map;
-  FillDepMap(setup, &dep_map);
+  TargetGraph graph(all_targets);
 
   size_t cnt = 0;
   if (tree)
-    cnt = DoTreeOutput(dep_map, target_matches, explicit_target_matches, all);
+    cnt = DoTreeOutput(graph, target_matches, explicit_target_matches, all);
   else if (all)
-    cnt = DoAllListOutput(dep_map, target_matches, explicit_target_matches);
+    cnt = DoAllListOutput(graph, target_matches, explicit_target_matches);
   else
-    cnt = DoDirectListOutput(dep_map, target_matches, explicit_target_matches);
+    cnt = DoDirectListOutput(graph, target_matches, explicit_target_matches);
 
   // If you ask for the references of a valid target, but that target has
   // nothing referencing it, we'll get here without having printed anything.
@@ -62,7 +62,7 @@ std::string FlagsGetter(RecursiveWriterConfig config,
                         const std::vector<T>& (ConfigValues::*getter)() const,
                         const Writer& writer) {
   std::string result;
-  std::ostringstream out;
+  StringOutputBuffer out;
   RecursiveTargetConfigToStream<T>(config, target, getter, writer, out);
   base::EscapeJSONString(out.str(), false, &result);
   return result;
@@ -102,7 +102,7 @@ void SetupCompileFlags(const Target* target,
                       const std::vector<std::string>& (ConfigValues::*getter)()
                           const) -> std::string {
     std::string result;
-    std::ostringstream out;
+    StringOutputBuffer out;
     WriteOneFlag(config, target, substitution, has_precompiled_headers,
                  tool_name, getter, opts, path_output, out,
                  /*write_substitution=*/false);
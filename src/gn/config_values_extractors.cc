@@ -5,6 +5,7 @@
 #include "gn/config_values_extractors.h"
 
 #include "gn/escape.h"
+#include "gn/string_output_buffer.h"
 
 namespace {
 
@@ -13,7 +14,7 @@ class EscapedStringWriter {
   explicit EscapedStringWriter(const EscapeOptions& escape_options)
       : escape_options_(escape_options) {}
 
-  void operator()(const std::string& s, std::ostream& out) const {
+  void operator()(const std::string& s, StringOutputBuffer& out) const {
     out << " ";
     EscapeStringToStream(out, s, escape_options_);
   }
@@ -29,7 +30,7 @@ void RecursiveTargetConfigStringsToStream(
     const Target* target,
     const std::vector<std::string>& (ConfigValues::*getter)() const,
     const EscapeOptions& escape_options,
-    std::ostream& out) {
+    StringOutputBuffer& out) {
   RecursiveTargetConfigToStream(config, target, getter,
                                 EscapedStringWriter(escape_options), out);
 }
@@ -15,6 +15,7 @@
 #include "gn/config_values.h"
 #include "gn/target.h"
 
+class StringOutputBuffer;
 struct EscapeOptions;
 
 // Provides a way to iterate through all ConfigValues applying to a given
@@ -80,14 +81,15 @@ enum RecursiveWriterConfig {
 
 // Writes a given config value that applies to a given target. This collects
 // all values from the target itself and all configs that apply, and writes
-// then in order.
-template <typename T, class Writer>
+// then in order. |out| is passed to the writer, and is either a stream or a
+// StringOutputBuffer.
+template <typename T, class Writer, class Out>
 inline void RecursiveTargetConfigToStream(
     RecursiveWriterConfig config,
     const Target* target,
     const std::vector<T>& (ConfigValues::*getter)() const,
     const Writer& writer,
-    std::ostream& out) {
+    Out& out) {
   std::set<T> seen;
   for (ConfigValuesIterator iter(target); !iter.done(); iter.Next()) {
     const std::vector<T>& values = ((iter.cur()).*getter)();
@@ -113,6 +115,6 @@ void RecursiveTargetConfigStringsToStream(
     const Target* target,
     const std::vector<std::string>& (ConfigValues::*getter)() const,
     const EscapeOptions& escape_options,
-    std::ostream& out);
+    StringOutputBuffer& out);
 
 #endif  // TOOLS_GN_CONFIG_VALUES_EXTRACTORS_H_
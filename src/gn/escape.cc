@@ -5,13 +5,16 @@
 #include "gn/escape.h"
 
 #include <stddef.h>
+#include <string.h>
 
 #include <memory>
 
 #include "base/compiler_specific.h"
 #include "base/json/string_escape.h"
 #include "base/logging.h"
+#include "gn/string_output_buffer.h"
 #include "util/build_config.h"
+#include "util/sse2.h"
 
 namespace {
 
@@ -42,17 +45,156 @@ const char kShellValid[0x80] = {
     1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0};
 // clang-format on
 
+inline bool IsShellValid(char ch) {
+  return static_cast<unsigned char>(ch) < 0x80 &&
+         kShellValid[static_cast<int>(ch)];
+}
+
+#if defined(HAS_SSE2)
+// Vector version of IsShellValid(). Bytes >= 0x80 are negative as signed, so
+// they fall out of every range.
+inline __m128i ShellValidBytes(__m128i chunk) {
+  return _mm_or_si128(
+      _mm_or_si128(_mm_or_si128(BytesInRange(chunk, '+', ':'),
+                                BytesEqual(chunk, '=')),
+                   _mm_or_si128(BytesInRange(chunk, '@', 'Z'),
+                                BytesEqual(chunk, '_'))),
+      BytesInRange(chunk, 'a', 'z'));
+}
+#endif
+
+// Each escaping mode passes most characters through unchanged. These classes
+// tell which characters a mode may change, so that the runs of other
+// characters can be found 16 bytes at a time and copied in bulk.
+struct SpaceChars {
+  static bool Match(char ch) { return ch == ' '; }
+#if defined(HAS_SSE2)
+  static __m128i Match(__m128i chunk) { return BytesEqual(chunk, ' '); }
+#endif
+};
+
+// Ninja's escaping rules are very simple. We always escape colons even
+// though they're OK in many places, in case the resulting string is used on
+// the left-hand-side of a rule.
+struct NinjaChars {
+  static bool Match(char ch) { return ch == '$' || ch == ' ' || ch == ':'; }
+#if defined(HAS_SSE2)
+  static __m128i Match(__m128i chunk) {
+    return _mm_or_si128(
+        _mm_or_si128(BytesEqual(chunk, '$'), BytesEqual(chunk, ' ')),
+        BytesEqual(chunk, ':'));
+  }
+#endif
+};
+
+struct DollarChars {
+  static bool Match(char ch) { return ch == '$'; }
+#if defined(HAS_SSE2)
+  static __m128i Match(__m128i chunk) { return BytesEqual(chunk, '$'); }
+#endif
+};
+
+// Escape all characters that ninja depfile parser can recognize as escaped,
+// even if some of them can work without escaping, plus $ for $$.
+struct DepfileChars {
+  static bool Match(char ch) {
+    return ch == ' ' || ch == '\\' || ch == '#' || ch == '*' || ch == '[' ||
+           ch == '|' || ch == ']' || ch == '$';
+  }
+#if defined(HAS_SSE2)
+  static __m128i Match(__m128i chunk) {
+    return _mm_or_si128(
+        _mm_or_si128(
+            _mm_or_si128(BytesEqual(chunk, ' '), BytesEqual(chunk, '\\')),
+            _mm_or_si128(BytesEqual(chunk, '#'), BytesEqual(chunk, '*'))),
+        _mm_or_si128(
+            _mm_or_si128(BytesEqual(chunk, '['), BytesEqual(chunk, '|')),
+            _mm_or_si128(BytesEqual(chunk, ']'), BytesEqual(chunk, '$'))));
+  }
+#endif
+};
+
+struct CompilationDatabaseChars {
+  static bool Match(char ch) { return ch == '\\' || ch == '"'; }
+#if defined(HAS_SSE2)
+  static __m128i Match(__m128i chunk) {
+    return _mm_or_si128(BytesEqual(chunk, '\\'), BytesEqual(chunk, '"'));
+  }
+#endif
+};
+
+// Characters that aren't valid in the Posix shell.
+struct ShellInvalidChars {
+  static bool Match(char ch) { return !IsShellValid(ch); }
+#if defined(HAS_SSE2)
+  static __m128i Match(__m128i chunk) {
+    return _mm_cmpeq_epi8(ShellValidBytes(chunk), _mm_setzero_si128());
+  }
+#endif
+};
+
+// The characters special to either the Posix shell or Ninja.
+struct PosixNinjaForkChars {
+  static bool Match(char ch) { return ch == ':' || !IsShellValid(ch); }
+#if defined(HAS_SSE2)
+  static __m128i Match(__m128i chunk) {
+    return _mm_or_si128(ShellInvalidChars::Match(chunk),
+                        BytesEqual(chunk, ':'));
+  }
+#endif
+};
+
+// Returns the offset of the first character of |str| at or after |begin|
+// matched by |Chars|, or str.size() if there is none.
+template <typename Chars>
+size_t FindChar(std::string_view str, size_t begin) {
+  const char* data = str.data();
+  size_t i = begin;
+#if defined(HAS_SSE2)
+  for (; i + 16 <= str.size(); i += 16) {
+    unsigned mask = _mm_movemask_epi8(Chars::Match(Load16(&data[i])));
+    if (mask)
+      return i + LowestSetBit(mask);
+  }
+#endif
+  for (; i < str.size(); i++) {
+    if (Chars::Match(data[i]))
+      return i;
+  }
+  return str.size();
+}
+
+// Copies |str| to |dest|, except for the characters matched by |Chars|, for
+// which |escape| writes the replacement and returns its size. Returns the
+// number of characters written.
+template <typename Chars, typename EscapeFunction>
+size_t CopyAndEscape(std::string_view str,
+                     char* dest,
+                     EscapeFunction escape) {
+  size_t i = 0;
+  size_t begin = 0;
+  while (true) {
+    size_t found = FindChar<Chars>(str, begin);
+    if (found > begin) {
+      memcpy(dest + i, str.data() + begin, found - begin);
+      i += found - begin;
+    }
+    if (found == str.size())
+      return i;
+    i += escape(str[found], dest + i);
+    begin = found + 1;
+  }
+}
+
 size_t EscapeStringToString_Space(std::string_view str,
                                   const EscapeOptions& options,
                                   char* dest,
                                   bool* needed_quoting) {
-  size_t i = 0;
-  for (const auto& elem : str) {
-    if (elem == ' ')
-      dest[i++] = '\\';
-    dest[i++] = elem;
-  }
-  return i;
+  return CopyAndEscape<SpaceChars>(str, dest, [](char ch, char* out) {
+    out[0] = '\\';
+    out[1] = ch;
+    return 2;
+  });
 }
 
 // Uses the stack if the space needed is small and the heap otherwise.
@@ -69,28 +211,15 @@ class StackOrHeapBuffer {
   std::unique_ptr<char[]> heap_buf;
 };
 
-// Ninja's escaping rules are very simple. We always escape colons even
-// though they're OK in many places, in case the resulting string is used on
-// the left-hand-side of a rule.
-inline bool ShouldEscapeCharForNinja(char ch) {
-  return ch == '$' || ch == ' ' || ch == ':';
-}
-
 size_t EscapeStringToString_Ninja(std::string_view str,
                                   const EscapeOptions& options,
                                   char* dest,
                                   bool* needed_quoting) {
-  size_t i = 0;
-  for (const auto& elem : str) {
-    if (ShouldEscapeCharForNinja(elem))
-      dest[i++] = '$';
-    dest[i++] = elem;
-  }
-  return i;
-}
-
-inline bool ShouldEscapeCharForCompilationDatabase(char ch) {
-  return ch == '\\' || ch == '"';
+  return CopyAndEscape<NinjaChars>(str, dest, [](char ch, char* out) {
+    out[0] = '$';
+    out[1] = ch;
+    return 2;
+  });
 }
 
 size_t EscapeStringToString_CompilationDatabase(std::string_view str,
@@ -98,22 +227,16 @@ size_t EscapeStringToString_CompilationDatabase(std::string_view str,
                                                 char* dest,
                                                 bool* needed_quoting) {
   size_t i = 0;
-  bool quote = false;
-  for (const auto& elem : str) {
-    if (static_cast<unsigned>(elem) >= 0x80 ||
-        !kShellValid[static_cast<int>(elem)]) {
-      quote = true;
-      break;
-    }
-  }
+  bool quote = FindChar<ShellInvalidChars>(str, 0) != str.size();
   if (quote)
     dest[i++] = '"';
 
-  for (const auto& elem : str) {
-    if (ShouldEscapeCharForCompilationDatabase(elem))
-      dest[i++] = '\\';
-    dest[i++] = elem;
-  }
+  i += CopyAndEscape<CompilationDatabaseChars>(str, dest + i,
+                                               [](char ch, char* out) {
+                                                 out[0] = '\\';
+                                                 out[1] = ch;
+                                                 return 2;
+                                               });
   if (quote)
     dest[i++] = '"';
   return i;
@@ -123,30 +246,21 @@ size_t EscapeStringToString_Depfile(std::string_view str,
                                     const EscapeOptions& options,
                                     char* dest,
                                     bool* needed_quoting) {
-  size_t i = 0;
-  for (const auto& elem : str) {
-    // Escape all characters that ninja depfile parser can recognize as escaped,
-    // even if some of them can work without escaping.
-    if (elem == ' ' || elem == '\\' || elem == '#' || elem == '*' ||
-        elem == '[' || elem == '|' || elem == ']')
-      dest[i++] = '\\';
-    else if (elem == '$')  // Extra rule for $$
-      dest[i++] = '$';
-    dest[i++] = elem;
-  }
-  return i;
+  return CopyAndEscape<DepfileChars>(str, dest, [](char ch, char* out) {
+    out[0] = ch == '$' ? '$' : '\\';
+    out[1] = ch;
+    return 2;
+  });
 }
 
 size_t EscapeStringToString_NinjaPreformatted(std::string_view str,
                                               char* dest) {
   // Only Ninja-escape $.
-  size_t i = 0;
-  for (const auto& elem : str) {
-    if (elem == '$')
-      dest[i++] = '$';
-    dest[i++] = elem;
-  }
-  return i;
+  return CopyAndEscape<DollarChars>(str, dest, [](char ch, char* out) {
+    out[0] = '$';
+    out[1] = ch;
+    return 2;
+  });
 }
 
 // Escape for CommandLineToArgvW and additionally escape Ninja characters.
@@ -195,7 +309,7 @@ size_t EscapeStringToString_WindowsNinjaFork(std::string_view str,
         // backslashes we read previously, these are literals.
         memset(dest + i, '\\', backslash_count);
         i += backslash_count;
-        if (ShouldEscapeCharForNinja(str[j]))
+        if (NinjaChars::Match(str[j]))
           dest[i++] = '$';
         dest[i++] = str[j];
       }
@@ -213,30 +327,62 @@ size_t EscapeStringToString_PosixNinjaFork(std::string_view str,
                                            const EscapeOptions& options,
                                            char* dest,
                                            bool* needed_quoting) {
-  size_t i = 0;
-  for (const auto& elem : str) {
-    if (elem == '$' || elem == ' ') {
+  return CopyAndEscape<PosixNinjaForkChars>(str, dest, [](char ch, char* out) {
+    if (ch == '$' || ch == ' ') {
       // Space and $ are special to both Ninja and the shell. '$' escape for
       // Ninja, then backslash-escape for the shell.
-      dest[i++] = '\\';
-      dest[i++] = '$';
-      dest[i++] = elem;
-    } else if (elem == ':') {
+      out[0] = '\\';
+      out[1] = '$';
+      out[2] = ch;
+      return 3;
+    }
+    if (ch == ':') {
       // Colon is the only other Ninja special char, which is not special to
       // the shell.
-      dest[i++] = '$';
-      dest[i++] = ':';
-    } else if (static_cast<unsigned>(elem) >= 0x80 ||
-               !kShellValid[static_cast<int>(elem)]) {
-      // All other invalid shell chars get backslash-escaped.
-      dest[i++] = '\\';
-      dest[i++] = elem;
-    } else {
-      // Everything else is a literal.
-      dest[i++] = elem;
+      out[0] = '$';
+      out[1] = ':';
+      return 2;
     }
+    // All other invalid shell chars get backslash-escaped.
+    out[0] = '\\';
+    out[1] = ch;
+    return 2;
+  });
+}
+
+// Returns true if escaping |str| with |options| would return it unchanged,
+// in which case it can be written out directly.
+bool IsUnchangedByEscaping(std::string_view str, const EscapeOptions& options) {
+  switch (options.mode) {
+    case ESCAPE_NONE:
+      // The copy stops at the first NUL.
+      return str.empty() || memchr(str.data(), 0, str.size()) == nullptr;
+    case ESCAPE_SPACE:
+      return FindChar<SpaceChars>(str, 0) == str.size();
+    case ESCAPE_NINJA:
+      return FindChar<NinjaChars>(str, 0) == str.size();
+    case ESCAPE_DEPFILE:
+      return FindChar<DepfileChars>(str, 0) == str.size();
+    case ESCAPE_COMPILATION_DATABASE:
+      return FindChar<ShellInvalidChars>(str, 0) == str.size();
+    case ESCAPE_NINJA_COMMAND:
+      switch (options.platform) {
+        case ESCAPE_PLATFORM_CURRENT:
+#if defined(OS_WIN)
+          return false;
+#else
+          return FindChar<PosixNinjaForkChars>(str, 0) == str.size();
+#endif
+        case ESCAPE_PLATFORM_POSIX:
+          return FindChar<PosixNinjaForkChars>(str, 0) == str.size();
+        default:
+          return false;
+      }
+    case ESCAPE_NINJA_PREFORMATTED_COMMAND:
+      return FindChar<DollarChars>(str, 0) == str.size();
+    default:
+      return false;
   }
-  return i;
 }
 
 // Escapes |str| into |dest| and returns the number of characters written.
@@ -289,6 +435,8 @@ size_t EscapeStringToString(std::string_view str,
 std::string EscapeString(std::string_view str,
                          const EscapeOptions& options,
                          bool* needed_quoting) {
+  if (IsUnchangedByEscaping(str, options))
+    return std::string(str);
   StackOrHeapBuffer dest(str.size() * kMaxEscapedCharsPerChar);
   return std::string(dest,
                      EscapeStringToString(str, options, dest, needed_quoting));
@@ -297,10 +445,25 @@ std::string EscapeString(std::string_view str,
 void EscapeStringToStream(std::ostream& out,
                           std::string_view str,
                           const EscapeOptions& options) {
+  if (IsUnchangedByEscaping(str, options)) {
+    out.write(str.data(), str.size());
+    return;
+  }
   StackOrHeapBuffer dest(str.size() * kMaxEscapedCharsPerChar);
   out.write(dest, EscapeStringToString(str, options, dest, nullptr));
 }
 
+void EscapeStringToStream(StringOutputBuffer& out,
+                          std::string_view str,
+                          const EscapeOptions& options) {
+  if (IsUnchangedByEscaping(str, options)) {
+    out.Append(str.data(), str.size());
+    return;
+  }
+  StackOrHeapBuffer dest(str.size() * kMaxEscapedCharsPerChar);
+  out.Append(dest, EscapeStringToString(str, options, dest, nullptr));
+}
+
 void EscapeJSONStringToStream(std::ostream& out,
                               std::string_view str,
                               const EscapeOptions& options) {
@@ -8,6 +8,8 @@
 #include <iosfwd>
 #include <string_view>
 
+class StringOutputBuffer;
+
 enum EscapingMode {
   // No escaping.
   ESCAPE_NONE,
@@ -80,6 +82,9 @@ std::string EscapeString(std::string_view str,
 void EscapeStringToStream(std::ostream& out,
                           std::string_view str,
                           const EscapeOptions& options);
+void EscapeStringToStream(StringOutputBuffer& out,
+                          std::string_view str,
+                          const EscapeOptions& options);
 
 // Same as EscapeString but escape JSON string and writes the results to the
 // given stream, saving a copy.
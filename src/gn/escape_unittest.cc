@@ -110,3 +110,38 @@ TEST(Escape, CompilationDatabase) {
   std::string result = EscapeString("asdf:$ \\#*[|]bar", opts, nullptr);
   EXPECT_EQ("\"asdf:$ \\\\#*[|]bar\"", result);
 }
+
+// Strings longer than 16 characters are scanned in blocks, check that special
+// characters are found anywhere in them.
+TEST(Escape, LongStrings) {
+  EscapeOptions ninja;
+  ninja.mode = ESCAPE_NINJA;
+  EscapeOptions posix;
+  posix.mode = ESCAPE_NINJA_COMMAND;
+  posix.platform = ESCAPE_PLATFORM_POSIX;
+  EscapeOptions database;
+  database.mode = ESCAPE_COMPILATION_DATABASE;
+
+  const std::string clean = "../../some/dir/file_name-1.cc";
+  EXPECT_EQ(clean, EscapeString(clean, ninja, nullptr));
+  EXPECT_EQ(clean, EscapeString(clean, posix, nullptr));
+  EXPECT_EQ(clean, EscapeString(clean, database, nullptr));
+
+  for (size_t i = 0; i <= clean.size(); i++) {
+    std::string str = clean;
+    str.insert(i, "$");
+    std::string before = clean.substr(0, i);
+    std::string after = clean.substr(i);
+    EXPECT_EQ(before + "$$" + after, EscapeString(str, ninja, nullptr));
+    EXPECT_EQ(before + "\\$$" + after, EscapeString(str, posix, nullptr));
+    EXPECT_EQ("\"" + str + "\"", EscapeString(str, database, nullptr));
+
+    // Non-ASCII characters are escaped for the shell.
+    str[i] = '\xe9';
+    EXPECT_EQ(before + "\\\xe9" + after, EscapeString(str, posix, nullptr));
+
+    StringOutputBuffer buffer;
+    EscapeStringToStream(buffer, str, posix);
+    EXPECT_EQ(before + "\\\xe9" + after, buffer.str());
+  }
+}
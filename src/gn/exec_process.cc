@@ -12,6 +12,7 @@
 #include "base/files/file_util.h"
 #include "base/logging.h"
 #include "util/build_config.h"
+#include "util/worker_pool.h"
 
 #if defined(OS_WIN)
 #include <windows.h>
@@ -22,11 +23,15 @@
 #else
 #include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <signal.h>
-#include <sys/time.h>
+#include <spawn.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
+#include <string>
+#include <vector>
+
 #include "base/posix/eintr_wrapper.h"
 #include "base/posix/file_descriptor_shuffle.h"
 #endif
@@ -48,6 +53,9 @@ bool ExecProcess(const std::u16string& cmdline_str,
                  std::string* std_out,
                  std::string* std_err,
                  int* exit_code) {
+  // Let the worker pool run other work while this thread waits on the child.
+  ScopedBlockingCall blocking_call;
+
   SECURITY_ATTRIBUTES sa_attr;
   // Set the bInheritHandle flag so pipe handles are inherited.
   sa_attr.nLength = sizeof(SECURITY_ATTRIBUTES);
@@ -139,11 +147,39 @@ bool ExecProcess(const std::u16string& cmdline_str,
   return true;
 }
 #else
+// posix_spawn() doesn't copy the page tables of the parent like fork() does,
+// which gets slow once GN has loaded a large build. Changing the directory of
+// the child needs posix_spawn_file_actions_addchdir_np(), added in glibc 2.29.
+#if defined(LIBC_GLIBC) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+#define USE_POSIX_SPAWN 1
+#endif
+
+// Creates a pipe whose ends aren't inherited by the children spawned by other
+// threads, which would otherwise keep the write end open after the child
+// exits.
+bool CreatePipe(base::ScopedFD* read_fd, base::ScopedFD* write_fd) {
+  int fds[2];
+#if defined(OS_LINUX) || defined(OS_BSD)
+  if (pipe2(fds, O_CLOEXEC) < 0)
+    return false;
+  read_fd->reset(fds[0]);
+  write_fd->reset(fds[1]);
+  return true;
+#else
+  if (pipe(fds) < 0)
+    return false;
+  read_fd->reset(fds[0]);
+  write_fd->reset(fds[1]);
+  return base::SetCloseOnExec(fds[0]) && base::SetCloseOnExec(fds[1]);
+#endif
+}
+
 // Reads from the provided file descriptor and appends to output. Returns false
 // if the fd is closed or there is an unexpected error (not
 // EINTR/EAGAIN/EWOULDBLOCK).
 bool ReadFromPipe(int fd, std::string* output) {
-  char buffer[256];
+  char buffer[4096];
   int bytes_read = HANDLE_EINTR(read(fd, buffer, sizeof(buffer)));
   if (bytes_read == -1) {
     return errno == EAGAIN || errno == EWOULDBLOCK;
@@ -154,9 +190,34 @@ bool ReadFromPipe(int fd, std::string* output) {
   return true;
 }
 
+// Reads the output of the child until both pipes are closed. Unlike select(),
+// poll() works with descriptors past FD_SETSIZE.
+void ReadFromPipes(int out_fd,
+                   int err_fd,
+                   std::string* std_out,
+                   std::string* std_err) {
+  struct pollfd fds[2] = {{out_fd, POLLIN, 0}, {err_fd, POLLIN, 0}};
+  std::string* outputs[2] = {std_out, std_err};
+  int open_count = 2;
+  while (open_count > 0) {
+    int res = HANDLE_EINTR(poll(fds, 2, -1));
+    if (res <= 0)
+      break;
+    for (int i = 0; i < 2; i++) {
+      if (fds[i].fd < 0 || !fds[i].revents)
+        continue;
+      if (!ReadFromPipe(fds[i].fd, outputs[i])) {
+        // Negative descriptors are ignored by poll().
+        fds[i].fd = -1;
+        open_count--;
+      }
+    }
+  }
+}
+
 bool WaitForExit(int pid, int* exit_code) {
   int status;
-  if (waitpid(pid, &status, 0) < 0) {
+  if (HANDLE_EINTR(waitpid(pid, &status, 0)) < 0) {
     PLOG(ERROR) << "waitpid";
     return false;
   }
@@ -172,118 +233,137 @@ bool WaitForExit(int pid, int* exit_code) {
   return false;
 }
 
-bool ExecProcess(const base::CommandLine& cmdline,
+#if defined(USE_POSIX_SPAWN)
+int SpawnProcess(const std::vector<std::string>& argv,
                  const base::FilePath& startup_dir,
-                 std::string* std_out,
-                 std::string* std_err,
-                 int* exit_code) {
-  *exit_code = EXIT_FAILURE;
-
-  std::vector<std::string> argv = cmdline.argv();
-
-  int out_fd[2], err_fd[2];
-  pid_t pid;
+                 int std_in,
+                 int std_out,
+                 int std_err) {
+  std::vector<char*> argv_cstr;
+  argv_cstr.reserve(argv.size() + 1);
+  for (const std::string& arg : argv)
+    argv_cstr.push_back(const_cast<char*>(arg.c_str()));
+  argv_cstr.push_back(nullptr);
+
+  posix_spawn_file_actions_t actions;
+  if (posix_spawn_file_actions_init(&actions) != 0)
+    return -1;
+  // dup2() clears the close-on-exec flag of the copies.
+  bool ok =
+      posix_spawn_file_actions_adddup2(&actions, std_in, STDIN_FILENO) == 0 &&
+      posix_spawn_file_actions_adddup2(&actions, std_out, STDOUT_FILENO) ==
+          0 &&
+      posix_spawn_file_actions_adddup2(&actions, std_err, STDERR_FILENO) ==
+          0 &&
+      posix_spawn_file_actions_addchdir_np(&actions,
+                                           startup_dir.value().c_str()) == 0;
+
+  pid_t pid = -1;
+  if (ok && posix_spawnp(&pid, argv_cstr[0], &actions, nullptr,
+                         argv_cstr.data(), environ) != 0)
+    pid = -1;
+  posix_spawn_file_actions_destroy(&actions);
+  return pid;
+}
+#else
+int SpawnProcess(const std::vector<std::string>& argv,
+                 const base::FilePath& startup_dir,
+                 int std_in,
+                 int std_out,
+                 int std_err) {
   base::InjectiveMultimap fd_shuffle1, fd_shuffle2;
   std::unique_ptr<char*[]> argv_cstr(new char*[argv.size() + 1]);
 
   fd_shuffle1.reserve(3);
   fd_shuffle2.reserve(3);
 
-  if (pipe(out_fd) < 0)
+  pid_t pid = fork();
+  if (pid != 0)
+    return pid;
+
+  // Child.
+#if defined(OS_MAC)
+  // When debugging the app under Xcode, the child will receive a SIGTRAP
+  // signal which will terminate the child process. Ignore the signal to
+  // allow debugging under macOS.
+  sigignore(SIGTRAP);
+#endif
+
+  // DANGER: no calls to malloc are allowed from now on:
+  // http://crbug.com/36678
+  //
+  // STL iterators are also not allowed (including those implied
+  // by range-based for loops), since debug iterators use locks.
+
+  // Obscure fork() rule: in the child, if you don't end up doing exec*(),
+  // you call _exit() instead of exit(). This is because _exit() does not
+  // call any previously-registered (in the parent) exit handlers, which
+  // might do things like block waiting for threads that don't even exist
+  // in the child.
+  fd_shuffle1.push_back(base::InjectionArc(std_out, STDOUT_FILENO, true));
+  fd_shuffle1.push_back(base::InjectionArc(std_err, STDERR_FILENO, true));
+  fd_shuffle1.push_back(base::InjectionArc(std_in, STDIN_FILENO, true));
+  // Adding another element here? Remember to increase the argument to
+  // reserve(), above.
+
+  // DANGER: Do NOT convert to range-based for loop!
+  for (size_t i = 0; i < fd_shuffle1.size(); ++i)
+    fd_shuffle2.push_back(fd_shuffle1[i]);
+
+  if (!ShuffleFileDescriptors(&fd_shuffle1))
+    _exit(127);
+
+  base::SetCurrentDirectory(startup_dir);
+
+  // TODO(brettw) the base version GetAppOutput does a
+  // CloseSuperfluousFds call here. Do we need this?
+
+  // DANGER: Do NOT convert to range-based for loop!
+  for (size_t i = 0; i < argv.size(); i++)
+    argv_cstr[i] = const_cast<char*>(argv[i].c_str());
+  argv_cstr[argv.size()] = nullptr;
+  execvp(argv_cstr[0], argv_cstr.get());
+  _exit(127);
+}
+#endif  // USE_POSIX_SPAWN
+
+bool ExecProcess(const base::CommandLine& cmdline,
+                 const base::FilePath& startup_dir,
+                 std::string* std_out,
+                 std::string* std_err,
+                 int* exit_code) {
+  // Let the worker pool run other work while this thread waits on the child.
+  ScopedBlockingCall blocking_call;
+
+  *exit_code = EXIT_FAILURE;
+
+  base::ScopedFD out_read, out_write;
+  if (!CreatePipe(&out_read, &out_write))
     return false;
-  base::ScopedFD out_read(out_fd[0]), out_write(out_fd[1]);
 
-  if (pipe(err_fd) < 0)
+  base::ScopedFD err_read, err_write;
+  if (!CreatePipe(&err_read, &err_write))
     return false;
-  base::ScopedFD err_read(err_fd[0]), err_write(err_fd[1]);
 
-  if (out_read.get() >= FD_SETSIZE || err_read.get() >= FD_SETSIZE)
+  base::ScopedFD dev_null(
+      HANDLE_EINTR(open("/dev/null", O_RDONLY | O_CLOEXEC)));
+  if (!dev_null.is_valid())
     return false;
 
-  switch (pid = fork()) {
-    case -1:  // error
-      return false;
-    case 0:  // child
-    {
-#if defined(OS_MAC)
-      // When debugging the app under Xcode, the child will receive a SIGTRAP
-      // signal which will terminate the child process. Ignore the signal to
-      // allow debugging under macOS.
-      sigignore(SIGTRAP);
-#endif
+  pid_t pid = SpawnProcess(cmdline.argv(), startup_dir, dev_null.get(),
+                           out_write.get(), err_write.get());
+  if (pid < 0)
+    return false;
 
-      // DANGER: no calls to malloc are allowed from now on:
-      // http://crbug.com/36678
-      //
-      // STL iterators are also not allowed (including those implied
-      // by range-based for loops), since debug iterators use locks.
-
-      // Obscure fork() rule: in the child, if you don't end up doing exec*(),
-      // you call _exit() instead of exit(). This is because _exit() does not
-      // call any previously-registered (in the parent) exit handlers, which
-      // might do things like block waiting for threads that don't even exist
-      // in the child.
-      int dev_null = open("/dev/null", O_WRONLY);
-      if (dev_null < 0)
-        _exit(127);
-
-      fd_shuffle1.push_back(
-          base::InjectionArc(out_write.get(), STDOUT_FILENO, true));
-      fd_shuffle1.push_back(
-          base::InjectionArc(err_write.get(), STDERR_FILENO, true));
-      fd_shuffle1.push_back(base::InjectionArc(dev_null, STDIN_FILENO, true));
-      // Adding another element here? Remember to increase the argument to
-      // reserve(), above.
-
-      // DANGER: Do NOT convert to range-based for loop!
-      for (size_t i = 0; i < fd_shuffle1.size(); ++i)
-        fd_shuffle2.push_back(fd_shuffle1[i]);
-
-      if (!ShuffleFileDescriptors(&fd_shuffle1))
-        _exit(127);
-
-      base::SetCurrentDirectory(startup_dir);
-
-      // TODO(brettw) the base version GetAppOutput does a
-      // CloseSuperfluousFds call here. Do we need this?
-
-      // DANGER: Do NOT convert to range-based for loop!
-      for (size_t i = 0; i < argv.size(); i++)
-        argv_cstr[i] = const_cast<char*>(argv[i].c_str());
-      argv_cstr[argv.size()] = nullptr;
-      execvp(argv_cstr[0], argv_cstr.get());
-      _exit(127);
-    }
-    default:  // parent
-    {
-      // Close our writing end of pipe now. Otherwise later read would not
-      // be able to detect end of child's output (in theory we could still
-      // write to the pipe).
-      out_write.reset();
-      err_write.reset();
-
-      bool out_open = true, err_open = true;
-      while (out_open || err_open) {
-        fd_set read_fds;
-        FD_ZERO(&read_fds);
-        FD_SET(out_read.get(), &read_fds);
-        FD_SET(err_read.get(), &read_fds);
-        int res =
-            HANDLE_EINTR(select(std::max(out_read.get(), err_read.get()) + 1,
-                                &read_fds, nullptr, nullptr, nullptr));
-        if (res <= 0)
-          break;
-        if (FD_ISSET(out_read.get(), &read_fds))
-          out_open = ReadFromPipe(out_read.get(), std_out);
-        if (FD_ISSET(err_read.get(), &read_fds))
-          err_open = ReadFromPipe(err_read.get(), std_err);
-      }
+  // Close our writing end of pipe now. Otherwise later read would not
+  // be able to detect end of child's output (in theory we could still
+  // write to the pipe).
+  out_write.reset();
+  err_write.reset();
 
-      return WaitForExit(pid, exit_code);
-    }
-  }
+  ReadFromPipes(out_read.get(), err_read.get(), std_out, std_err);
 
-  return false;
+  return WaitForExit(pid, exit_code);
 }
 #endif
 
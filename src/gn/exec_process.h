@@ -6,6 +6,7 @@
 #define TOOLS_GN_EXEC_PROCESS_H_
 
 #include <string>
+#include <vector>
 
 #include "util/build_config.h"
 
@@ -30,6 +31,20 @@ bool ExecProcess(const std::u16string& cmdline_str,
                  int* exit_code);
 #endif  // OS_WIN
 
+#if !defined(OS_WIN)
+// Starts |argv| in |startup_dir| with the given descriptors as its standard
+// input, output and error. Returns the pid of the child, or -1 on failure.
+int SpawnProcess(const std::vector<std::string>& argv,
+                 const base::FilePath& startup_dir,
+                 int std_in,
+                 int std_out,
+                 int std_err);
+
+// Waits for the child |pid| to exit. Returns false if it was killed by a
+// signal.
+bool WaitForExit(int pid, int* exit_code);
+#endif  // !OS_WIN
+
 }  // namespace internal
 
 #endif  // TOOLS_GN_EXEC_PROCESS_H_
@@ -5,6 +5,7 @@
 #include "gn/exec_process.h"
 
 #include "base/command_line.h"
+#include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/strings/string_util.h"
 #include "util/build_config.h"
@@ -21,12 +22,11 @@ namespace internal {
 // CommandLine does unusual reordering of args.
 #if !defined(OS_WIN)
 namespace {
-bool ExecPython(const std::string& command,
-                std::string* std_out,
-                std::string* std_err,
-                int* exit_code) {
-  base::ScopedTempDir temp_dir;
-  CHECK(temp_dir.CreateUniqueTempDir());
+bool ExecPythonInDir(const base::FilePath& startup_dir,
+                     const std::string& command,
+                     std::string* std_out,
+                     std::string* std_err,
+                     int* exit_code) {
   base::CommandLine::StringVector args;
 #if defined(OS_WIN)
   args.push_back(L"python");
@@ -37,8 +37,18 @@ bool ExecPython(const std::string& command,
   args.push_back("-c");
   args.push_back(command);
 #endif
-  return ExecProcess(base::CommandLine(args), temp_dir.GetPath(), std_out,
-                     std_err, exit_code);
+  return ExecProcess(base::CommandLine(args), startup_dir, std_out, std_err,
+                     exit_code);
+}
+
+bool ExecPython(const std::string& command,
+                std::string* std_out,
+                std::string* std_err,
+                int* exit_code) {
+  base::ScopedTempDir temp_dir;
+  CHECK(temp_dir.CreateUniqueTempDir());
+  return ExecPythonInDir(temp_dir.GetPath(), command, std_out, std_err,
+                         exit_code);
 }
 }  // namespace
 
@@ -119,5 +129,19 @@ TEST(ExecProcessTest, TestOneOutputClosed) {
   EXPECT_EQ(0u, std_out.size());
   EXPECT_EQ(10001u, std_err.size());
 }
+
+TEST(ExecProcessTest, TestStartupDir) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath startup_dir = base::MakeAbsoluteFilePath(temp_dir.GetPath());
+
+  std::string std_out, std_err;
+  int exit_code;
+  ASSERT_TRUE(ExecPythonInDir(startup_dir,
+                              "import os; print(os.getcwd(), end='')",
+                              &std_out, &std_err, &exit_code));
+  EXPECT_EQ(0, exit_code);
+  EXPECT_EQ(startup_dir.value(), std_out);
+}
 #endif
 }  // namespace internal
@@ -5,6 +5,8 @@
 #include "gn/filesystem_utils.h"
 
 #include <algorithm>
+#include <mutex>
+#include <unordered_set>
 
 #include "base/files/file_util.h"
 #include "base/strings/string_util.h"
@@ -939,11 +941,35 @@ bool ContentsEqual(const base::FilePath& file_path, const std::string& data) {
   return file_data == data;
 }
 
+bool CreateDirectoryCached(const base::FilePath& dir) {
+  static std::mutex lock;
+  static std::unordered_set<base::FilePath::StringType> known_dirs;
+
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    if (known_dirs.count(dir.value()))
+      return true;
+  }
+
+  if (!base::CreateDirectory(dir))
+    return false;
+
+  // base::CreateDirectory() also created all the parents.
+  std::lock_guard<std::mutex> guard(lock);
+  for (base::FilePath cur = dir; known_dirs.insert(cur.value()).second;) {
+    base::FilePath parent = cur.DirName();
+    if (parent == cur)
+      break;
+    cur = parent;
+  }
+  return true;
+}
+
 bool WriteFile(const base::FilePath& file_path,
                const std::string& data,
                Err* err) {
   // Create the directory if necessary.
-  if (!base::CreateDirectory(file_path.DirName())) {
+  if (!CreateDirectoryCached(file_path.DirName())) {
     if (err) {
       *err =
           Err(Location(), "Unable to create directory.",
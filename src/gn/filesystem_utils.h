@@ -203,6 +203,13 @@ std::string GetOutputSubdirName(const Label& toolchain_label, bool is_default);
 // otherwise.
 bool ContentsEqual(const base::FilePath& file_path, const std::string& data);
 
+// Like base::CreateDirectory(), but remembers the directories that were
+// created or found to exist, so that later calls for them or their parents
+// don't touch the file system. This is meant for the many output files
+// written to the same directories; a directory deleted by something else
+// during the run isn't recreated. Thread-safe.
+bool CreateDirectoryCached(const base::FilePath& dir);
+
 // Writes given stream contents to the given file. Returns true if data was
 // successfully written, false otherwise. |err| is set on error if not nullptr.
 bool WriteFile(const base::FilePath& file_path,
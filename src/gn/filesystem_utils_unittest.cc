@@ -638,6 +638,28 @@ TEST(FilesystemUtils, ContentsEqual) {
   EXPECT_FALSE(ContentsEqual(file_path, "bar"));
 }
 
+TEST(FilesystemUtils, CreateDirectoryCached) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+
+  base::FilePath parent = temp_dir.GetPath().AppendASCII("obj");
+  base::FilePath dir = parent.AppendASCII("foo").AppendASCII("bar");
+  EXPECT_TRUE(CreateDirectoryCached(dir));
+  EXPECT_TRUE(base::DirectoryExists(dir));
+
+  // Known directories, including the parents that were created, aren't looked
+  // at again.
+  ASSERT_TRUE(base::DeleteFile(parent, true));
+  EXPECT_TRUE(CreateDirectoryCached(dir));
+  EXPECT_TRUE(CreateDirectoryCached(parent));
+  EXPECT_FALSE(base::DirectoryExists(parent));
+
+  // A directory can't be created under a regular file.
+  base::FilePath file = temp_dir.GetPath().AppendASCII("file");
+  ASSERT_EQ(1, base::WriteFile(file, "x", 1));
+  EXPECT_FALSE(CreateDirectoryCached(file.AppendASCII("dir")));
+}
+
 TEST(FilesystemUtils, GetToolchainDirs) {
   BuildSettings build_settings;
   build_settings.SetBuildDir(SourceDir("//out/Debug/"));
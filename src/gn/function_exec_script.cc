@@ -15,6 +15,7 @@
 #include "gn/input_file.h"
 #include "gn/parse_tree.h"
 #include "gn/scheduler.h"
+#include "gn/script_host.h"
 #include "gn/trace.h"
 #include "gn/value.h"
 #include "util/build_config.h"
@@ -193,15 +194,17 @@ Value RunExecScript(Scope* scope,
     cmdline.SetProgram(script_path);
   }
 
+  std::vector<std::string> script_args;
   if (args.size() >= 2) {
     // Optional command-line arguments to the script.
-    const Value& script_args = args[1];
-    if (!script_args.VerifyTypeIs(Value::LIST, err))
+    const Value& script_args_value = args[1];
+    if (!script_args_value.VerifyTypeIs(Value::LIST, err))
       return Value();
-    for (const auto& arg : script_args.list_value()) {
+    for (const auto& arg : script_args_value.list_value()) {
       if (!arg.VerifyTypeIs(Value::STRING, err))
         return Value();
       cmdline.AppendArg(arg.string_value());
+      script_args.push_back(arg.string_value());
     }
   }
 
@@ -234,7 +237,11 @@ Value RunExecScript(Scope* scope,
   std::string output;
   std::string stderr_output;
   int exit_code = 0;
-  {
+  ScriptHostPool* script_host_pool = build_settings->script_host_pool();
+  if (!script_host_pool || interpreter_path.empty() ||
+      !script_host_pool->Run(interpreter_path, script_path, script_args,
+                             startup_dir, &output, &stderr_output,
+                             &exit_code)) {
     if (!internal::ExecProcess(cmdline, startup_dir, &output, &stderr_output,
                                &exit_code)) {
       *err = Err(
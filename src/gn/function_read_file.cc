@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <string_view>
+
 #include "base/files/file_util.h"
 #include "gn/err.h"
 #include "gn/filesystem_utils.h"
@@ -9,6 +11,17 @@
 #include "gn/input_conversion.h"
 #include "gn/input_file.h"
 #include "gn/scheduler.h"
+#include "util/build_config.h"
+
+#if !defined(OS_WIN)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "base/files/scoped_file.h"
+#include "base/posix/eintr_wrapper.h"
+#endif
 
 // TODO(brettw) consider removing this. I originally wrote it for making the
 // WebKit bindings but misundersood what was required, and didn't need to
@@ -16,6 +29,61 @@
 
 namespace functions {
 
+namespace {
+
+#if !defined(OS_WIN)
+// Files at least this large are mapped rather than read. The input
+// conversions only scan the contents once, so copying them first is wasted.
+constexpr off_t kMapThreshold = 1 << 20;
+
+// A read-only mapping of a whole file.
+//
+// If the file is truncated while mapped, reading past its new end raises
+// SIGBUS instead of failing the read. That is accepted for source files,
+// which aren't expected to change during "gn gen", but files in the build
+// directory may be rewritten by a build running at the same time, so those
+// are always read instead.
+class MappedFile {
+ public:
+  MappedFile() = default;
+  ~MappedFile() {
+    if (data_)
+      munmap(data_, size_);
+  }
+
+  // Returns false if the file can't be mapped, or is too small to be worth
+  // it.
+  bool Map(const base::FilePath& file_path) {
+    base::ScopedFD fd(
+        HANDLE_EINTR(open(file_path.value().c_str(), O_RDONLY | O_CLOEXEC)));
+    struct stat info;
+    if (!fd.is_valid() || fstat(fd.get(), &info) != 0 ||
+        !S_ISREG(info.st_mode) || info.st_size < kMapThreshold)
+      return false;
+    void* data =
+        mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd.get(), 0);
+    if (data == MAP_FAILED)
+      return false;
+    data_ = data;
+    size_ = info.st_size;
+    return true;
+  }
+
+  std::string_view contents() const {
+    return std::string_view(static_cast<const char*>(data_), size_);
+  }
+
+ private:
+  void* data_ = nullptr;
+  size_t size_ = 0;
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+};
+#endif
+
+}  // namespace
+
 const char kReadFile[] = "read_file";
 const char kReadFile_HelpShort[] = "read_file: Read a file into a variable.";
 const char kReadFile_Help[] =
@@ -63,6 +131,16 @@ Value RunReadFile(Scope* scope,
   // Ensure that everything is recomputed if the read file changes.
   g_scheduler->AddGenDependency(file_path);
 
+#if !defined(OS_WIN)
+  MappedFile mapped_file;
+  if (!IsStringInOutputDir(scope->settings()->build_settings()->build_dir(),
+                           source_file.value()) &&
+      mapped_file.Map(file_path)) {
+    return ConvertInputToValue(scope->settings(), mapped_file.contents(),
+                               function, args[1], err);
+  }
+#endif
+
   // Read contents.
   std::string file_contents;
   if (!base::ReadFileToString(file_path, &file_contents)) {
@@ -630,6 +630,11 @@ const char kImport_Help[] =
   a standalone environment from the caller of the import command. The results
   of this execution are cached for other files that import the same .gni file.
 
+  When the result can't depend on the toolchain, because the file only uses
+  variables it defines or imports and only calls functions such as assert(),
+  foreach(), rebase_path() or the string and list functions, the file is
+  executed once and its result is shared by all the toolchains.
+
   Note that you can not import a BUILD.gn file that's otherwise used in the
   build. Files must either be imported or implicitly loaded as a result of deps
   rules, but not both.
@@ -1416,6 +1421,56 @@ const FunctionInfoMap& GetFunctions() {
   return function_info.map;
 }
 
+namespace {
+
+// Returns true if the built-in function with the given name has the same
+// result in every toolchain and no side effects, so that calling it doesn't
+// prevent an import from being shared between toolchains (see ImportProbe).
+// Nested imports are checked by the ImportManager.
+bool IsToolchainIndependentFunction(std::string_view name) {
+  static const char* const kFunctions[] = {
+      kAssert,
+      kDefined,
+      kFilterExclude,
+      kFilterInclude,
+      kForEach,
+      kForwardVariablesFrom,
+      kGetEnv,
+      kImport,
+      kNotNeeded,
+      kReadFile,
+      kRebasePath,
+      kSplitList,
+      kStringJoin,
+      kStringReplace,
+      kStringSplit,
+      kTemplate,
+  };
+  for (const char* function : kFunctions) {
+    if (name == function)
+      return true;
+  }
+  return false;
+}
+
+// Returns true if the built-in function with the given name, called from the
+// build config of a toolchain other than the default one, behaves the same in
+// all of them when their arguments are the same. Its side effects only need
+// to happen once. See BuildConfigProbe.
+bool IsSameForSameArgsFunction(std::string_view name) {
+  static const char* const kFunctions[] = {
+      kDeclareArgs,         kExecScript,   kProcessFileTemplate,
+      kSetDefaultToolchain, kSetDefaults,
+  };
+  for (const char* function : kFunctions) {
+    if (name == function)
+      return true;
+  }
+  return false;
+}
+
+}  // namespace
+
 Value RunFunction(Scope* scope,
                   const FunctionCallNode* function,
                   const ListNode* args_list,
@@ -1442,6 +1497,19 @@ Value RunFunction(Scope* scope,
     return Value();
   }
 
+  ImportProbe* probe = ImportProbe::Current();
+  if (probe && !IsToolchainIndependentFunction(name.value())) {
+    // Stop here, the import will be executed in each toolchain.
+    probe->set_depends_on_toolchain();
+    *err = Err(name, "Depends on the toolchain.");
+    return Value();
+  }
+
+  BuildConfigProbe* build_config_probe = BuildConfigProbe::Current();
+  if (build_config_probe && !IsToolchainIndependentFunction(name.value()) &&
+      !IsSameForSameArgsFunction(name.value()))
+    build_config_probe->set_depends_on_toolchain();
+
   if (found_function->second.self_evaluating_args_runner) {
     // Self evaluating args functions are special weird built-ins like foreach.
     // Rather than force them all to check that they have a block or no block
@@ -14,6 +14,7 @@
 #include "gn/c_include_iterator.h"
 #include "gn/config.h"
 #include "gn/config_values_extractors.h"
+#include "gn/deps_iterator.h"
 #include "gn/err.h"
 #include "gn/filesystem_utils.h"
 #include "gn/scheduler.h"
@@ -149,7 +150,7 @@ bool HeaderChecker::Run(const std::vector<const Target*>& to_check,
 }
 
 void HeaderChecker::RunCheckOverFiles(const FileMap& files, bool force_check) {
-  WorkerPool pool;
+  WorkerPool* pool = WorkerPool::Get();
 
   for (const auto& file : files) {
     // Only check C-like source files (RC files also have includes).
@@ -173,7 +174,7 @@ void HeaderChecker::RunCheckOverFiles(const FileMap& files, bool force_check) {
     for (const auto& vect_i : file.second) {
       if (vect_i.target->check_includes()) {
         task_count_.Increment();
-        pool.PostTask([this, target = vect_i.target, file = file.first]() {
+        pool->PostTask([this, target = vect_i.target, file = file.first]() {
           DoWork(target, file);
         });
       }
@@ -318,8 +319,6 @@ bool HeaderChecker::CheckFile(const Target* from_target,
 
   IncludeStringWithLocation include;
 
-  std::set<std::pair<const Target*, const Target*>> no_dependency_cache;
-
   while (iter.GetNextIncludeString(&include)) {
     if (include.system_style_include && !check_system_)
       continue;
@@ -331,7 +330,7 @@ bool HeaderChecker::CheckFile(const Target* from_target,
                                                     &err);
     if (!included_file.is_null()) {
       CheckInclude(from_target, input_file, included_file, include.location,
-                   &no_dependency_cache, errors);
+                   errors);
     }
   }
 
@@ -344,13 +343,11 @@ bool HeaderChecker::CheckFile(const Target* from_target,
 //  - The dependency path to the included target must follow only public_deps.
 //  - If there are multiple targets with the header in it, only one need be
 //    valid for the check to pass.
-void HeaderChecker::CheckInclude(
-    const Target* from_target,
-    const InputFile& source_file,
-    const SourceFile& include_file,
-    const LocationRange& range,
-    std::set<std::pair<const Target*, const Target*>>* no_dependency_cache,
-    std::vector<Err>* errors) const {
+void HeaderChecker::CheckInclude(const Target* from_target,
+                                 const InputFile& source_file,
+                                 const SourceFile& include_file,
+                                 const LocationRange& range,
+                                 std::vector<Err>* errors) const {
   // Assume if the file isn't declared in our sources that we don't need to
   // check it. It would be nice if we could give an error if this happens, but
   // our include finder is too primitive and returns all includes, even if
@@ -408,24 +405,11 @@ void HeaderChecker::CheckInclude(
     if (to_target == from_target)
       return;
 
-    bool is_permitted_chain = false;
-
-    bool cached_no_dependency =
-        no_dependency_cache->find(std::make_pair(to_target, from_target)) !=
-        no_dependency_cache->end();
-
-    bool add_to_cache = !cached_no_dependency;
-
-    if (!cached_no_dependency &&
-        IsDependencyOf(to_target, from_target, &chain, &is_permitted_chain)) {
-      add_to_cache = false;
-
-      DCHECK(chain.size() >= 2);
-      DCHECK(chain[0].target == to_target);
-      DCHECK(chain[chain.size() - 1].target == from_target);
-
+    Reachability reachability = GetReachability(to_target, from_target);
+    if (reachability != Reachability::kNone) {
       found_dependency = true;
 
+      bool is_permitted_chain = reachability == Reachability::kPermitted;
       bool effectively_public =
           target.is_public || FriendMatches(to_target, from_target);
 
@@ -443,6 +427,11 @@ void HeaderChecker::CheckInclude(
                          "This file is private to the target " +
                              target.target->label().GetUserVisibleName(false));
       } else if (!is_permitted_chain) {
+        // Only errors need the chain, so search it now.
+        IsDependencyOf(to_target, from_target, &chain, &is_permitted_chain);
+        DCHECK(chain.size() >= 2);
+        DCHECK(chain[0].target == to_target);
+        DCHECK(chain[chain.size() - 1].target == from_target);
         last_error = Err(CreatePersistentRange(source_file, range),
                          "Can't include this header from here.",
                          GetDependencyChainPublicError(chain));
@@ -457,10 +446,6 @@ void HeaderChecker::CheckInclude(
       last_error = Err();
       break;
     }
-
-    if (add_to_cache) {
-      no_dependency_cache->emplace(to_target, from_target);
-    }
   }
 
   if (!found_dependency || last_error.has_error()) {
@@ -494,6 +479,69 @@ void HeaderChecker::CheckInclude(
   //    have the annoying false positive problem, but is complex to write.
 }
 
+HeaderChecker::Reachability HeaderChecker::GetReachability(
+    const Target* search_for,
+    const Target* search_from) const {
+  std::pair<const Target*, const Target*> key(search_for, search_from);
+  ReachabilityShard& shard =
+      reachability_shards_[TargetPairHash()(key) % kReachabilityShardCount];
+  {
+    std::lock_guard<std::mutex> lock(shard.lock);
+    auto found = shard.map.find(key);
+    if (found != shard.map.end())
+      return found->second;
+  }
+
+  // A permitted chain is a direct dependency followed by public ones, so it
+  // exists if search_for is in the public closure of a direct dependency.
+  Reachability result = Reachability::kNone;
+  for (const auto& pair : search_from->GetDeps(Target::DEPS_LINKED)) {
+    const std::vector<const Target*>& closure =
+        GetPublicDepsClosure(pair.ptr);
+    if (std::binary_search(closure.begin(), closure.end(), search_for)) {
+      result = Reachability::kPermitted;
+      break;
+    }
+  }
+  if (result == Reachability::kNone && search_for != search_from) {
+    Chain chain;
+    if (IsDependencyOf(search_for, search_from, false, &chain))
+      result = Reachability::kNotPermitted;
+  }
+
+  // Another thread may have computed the same result meanwhile.
+  std::lock_guard<std::mutex> lock(shard.lock);
+  shard.map.emplace(key, result);
+  return result;
+}
+
+const std::vector<const Target*>& HeaderChecker::GetPublicDepsClosure(
+    const Target* target) const {
+  std::lock_guard<std::mutex> lock(public_deps_closures_lock_);
+  return GetPublicDepsClosureLocked(target);
+}
+
+const std::vector<const Target*>& HeaderChecker::GetPublicDepsClosureLocked(
+    const Target* target) const {
+  // The vectors don't move when the map grows, so they can be used without
+  // holding the lock once computed.
+  auto found = public_deps_closures_.find(target);
+  if (found != public_deps_closures_.end())
+    return found->second;
+
+  // Public deps can't have cycles, so the recursion ends.
+  std::vector<const Target*> closure = {target};
+  for (const auto& pair : target->public_deps()) {
+    const std::vector<const Target*>& dep_closure =
+        GetPublicDepsClosureLocked(pair.ptr);
+    closure.insert(closure.end(), dep_closure.begin(), dep_closure.end());
+  }
+  std::sort(closure.begin(), closure.end());
+  closure.erase(std::unique(closure.begin(), closure.end()), closure.end());
+  return public_deps_closures_.emplace(target, std::move(closure))
+      .first->second;
+}
+
 bool HeaderChecker::IsDependencyOf(const Target* search_for,
                                    const Target* search_from,
                                    Chain* chain,
@@ -5,12 +5,15 @@
 #ifndef TOOLS_GN_HEADER_CHECKER_H_
 #define TOOLS_GN_HEADER_CHECKER_H_
 
+#include <stdint.h>
+
 #include <condition_variable>
 #include <functional>
 #include <map>
 #include <mutex>
-#include <set>
 #include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "base/atomic_ref_count.h"
@@ -71,6 +74,7 @@ class HeaderChecker : public base::RefCountedThreadSafe<HeaderChecker> {
  private:
   friend class base::RefCountedThreadSafe<HeaderChecker>;
   FRIEND_TEST_ALL_PREFIXES(HeaderCheckerTest, IsDependencyOf);
+  FRIEND_TEST_ALL_PREFIXES(HeaderCheckerTest, GetReachability);
   FRIEND_TEST_ALL_PREFIXES(HeaderCheckerTest, CheckInclude);
   FRIEND_TEST_ALL_PREFIXES(HeaderCheckerTest, PublicFirst);
   FRIEND_TEST_ALL_PREFIXES(HeaderCheckerTest, CheckIncludeAllowCircular);
@@ -127,15 +131,29 @@ class HeaderChecker : public base::RefCountedThreadSafe<HeaderChecker> {
   // given include file. If disallowed, adds the error or errors to
   // the errors array.  The range indicates the location of the
   // include in the file for error reporting.
-  // |no_depeency_cache| is used to cache or check whether there is no
-  // dependency from |from_target| to target having |include_file|.
-  void CheckInclude(
-      const Target* from_target,
-      const InputFile& source_file,
-      const SourceFile& include_file,
-      const LocationRange& range,
-      std::set<std::pair<const Target*, const Target*>>* no_dependency_cache,
-      std::vector<Err>* errors) const;
+  void CheckInclude(const Target* from_target,
+                    const InputFile& source_file,
+                    const SourceFile& include_file,
+                    const LocationRange& range,
+                    std::vector<Err>* errors) const;
+
+  // How search_for can be reached from search_from, in the sense of
+  // IsDependencyOf(), but without the chain. The result of each pair of
+  // targets is computed once and shared by all threads.
+  enum class Reachability : uint8_t {
+    kNone,
+    kNotPermitted,
+    kPermitted,
+  };
+  Reachability GetReachability(const Target* search_for,
+                               const Target* search_from) const;
+
+  // Returns the targets reachable from the given one through public deps,
+  // including itself, sorted by address. Computed once per target.
+  const std::vector<const Target*>& GetPublicDepsClosure(
+      const Target* target) const;
+  const std::vector<const Target*>& GetPublicDepsClosureLocked(
+      const Target* target) const;
 
   // Returns true if the given search_for target is a dependency of
   // search_from.
@@ -198,6 +216,34 @@ class HeaderChecker : public base::RefCountedThreadSafe<HeaderChecker> {
 
   std::vector<Err> errors_;
 
+  // See GetPublicDepsClosure().
+  mutable std::mutex public_deps_closures_lock_;
+  mutable std::unordered_map<const Target*, std::vector<const Target*>>
+      public_deps_closures_;
+
+  // Results of GetReachability(), keyed by (search_for, search_from). The
+  // cache is split in shards with their own lock so that the checking threads
+  // rarely wait on each other.
+  struct TargetPairHash {
+    size_t operator()(const std::pair<const Target*, const Target*>& p) const {
+      // Mixed so that the low bits, which pick the shard, vary.
+      uint64_t h =
+          reinterpret_cast<uintptr_t>(p.first) * 0x9e3779b97f4a7c15ull ^
+          reinterpret_cast<uintptr_t>(p.second);
+      h *= 0xff51afd7ed558ccdull;
+      return static_cast<size_t>(h ^ (h >> 33));
+    }
+  };
+  struct ReachabilityShard {
+    std::mutex lock;
+    std::unordered_map<std::pair<const Target*, const Target*>,
+                       Reachability,
+                       TargetPairHash>
+        map;
+  };
+  static constexpr size_t kReachabilityShardCount = 16;
+  mutable ReachabilityShard reachability_shards_[kReachabilityShardCount];
+
   // Signaled when |task_count_| becomes zero.
   std::condition_variable task_count_cv_;
 
@@ -150,6 +150,42 @@ TEST_F(HeaderCheckerTest, IsDependencyOf) {
   EXPECT_TRUE(is_permitted);
 }
 
+TEST_F(HeaderCheckerTest, GetReachability) {
+  // Make A -> P -> Q where A depends publicly on P, and P privately on Q, and
+  // C -> D privately.
+  Err err;
+  Target p(setup_.settings(), Label(SourceDir("//p/"), "p"));
+  Target q(setup_.settings(), Label(SourceDir("//q/"), "q"));
+  p.set_output_type(Target::SOURCE_SET);
+  q.set_output_type(Target::SOURCE_SET);
+  p.SetToolchain(setup_.toolchain(), &err);
+  q.SetToolchain(setup_.toolchain(), &err);
+  p.private_deps().push_back(LabelTargetPair(&q));
+  a_.public_deps().push_back(LabelTargetPair(&p));
+  c_.private_deps().push_back(LabelTargetPair(&d_));
+
+  auto checker = CreateChecker();
+  using Reachability = HeaderChecker::Reachability;
+
+  // Public chains and direct deps are permitted.
+  EXPECT_EQ(Reachability::kPermitted, checker->GetReachability(&b_, &a_));
+  EXPECT_EQ(Reachability::kPermitted, checker->GetReachability(&c_, &a_));
+  EXPECT_EQ(Reachability::kPermitted, checker->GetReachability(&q, &p));
+  EXPECT_EQ(Reachability::kPermitted, checker->GetReachability(&d_, &c_));
+
+  // A private dep after the first hop isn't.
+  EXPECT_EQ(Reachability::kNotPermitted, checker->GetReachability(&q, &a_));
+  EXPECT_EQ(Reachability::kNotPermitted, checker->GetReachability(&d_, &a_));
+
+  EXPECT_EQ(Reachability::kNone, checker->GetReachability(&a_, &c_));
+  EXPECT_EQ(Reachability::kNone, checker->GetReachability(&a_, &a_));
+
+  // Results are computed once: breaking the chain doesn't change them.
+  b_.public_deps().clear();
+  EXPECT_EQ(Reachability::kPermitted, checker->GetReachability(&c_, &a_));
+  EXPECT_EQ(Reachability::kNotPermitted, checker->GetReachability(&d_, &a_));
+}
+
 TEST_F(HeaderCheckerTest, CheckInclude) {
   InputFile input_file(SourceFile("//some_file.cc"));
   input_file.SetContents(std::string());
@@ -197,46 +233,35 @@ TEST_F(HeaderCheckerTest, CheckInclude) {
 
   auto checker = CreateChecker();
 
-  std::set<std::pair<const Target*, const Target*>> no_dependency_cache;
   // A file in target A can't include a header from D because A has no
   // dependency on D.
   std::vector<Err> errors;
-  checker->CheckInclude(&a_, input_file, d_header, range, &no_dependency_cache,
-                        &errors);
+  checker->CheckInclude(&a_, input_file, d_header, range, &errors);
   EXPECT_GT(errors.size(), 0);
 
   // A can include the public header in B.
   errors.clear();
-  no_dependency_cache.clear();
-  checker->CheckInclude(&a_, input_file, b_public, range, &no_dependency_cache,
-                        &errors);
+  checker->CheckInclude(&a_, input_file, b_public, range, &errors);
   EXPECT_EQ(errors.size(), 0);
 
   // Check A depending on the public and private headers in C.
   errors.clear();
-  no_dependency_cache.clear();
-  checker->CheckInclude(&a_, input_file, c_public, range, &no_dependency_cache,
-                        &errors);
+  checker->CheckInclude(&a_, input_file, c_public, range, &errors);
   EXPECT_EQ(errors.size(), 0);
   errors.clear();
-  no_dependency_cache.clear();
-  checker->CheckInclude(&a_, input_file, c_private, range, &no_dependency_cache,
-                        &errors);
+  checker->CheckInclude(&a_, input_file, c_private, range, &errors);
   EXPECT_GT(errors.size(), 0);
 
   // A can depend on a random file unknown to the build.
   errors.clear();
-  no_dependency_cache.clear();
   checker->CheckInclude(&a_, input_file, SourceFile("//random.h"), range,
-                        &no_dependency_cache, &errors);
+                        &errors);
   EXPECT_EQ(errors.size(), 0);
 
   // A can depend on a file present only in another toolchain even with no
   // dependency path.
   errors.clear();
-  no_dependency_cache.clear();
-  checker->CheckInclude(&a_, input_file, otc_header, range,
-                        &no_dependency_cache, &errors);
+  checker->CheckInclude(&a_, input_file, otc_header, range, &errors);
   EXPECT_EQ(errors.size(), 0);
 }
 
@@ -298,9 +323,7 @@ TEST_F(HeaderCheckerTest, CheckIncludeAllowCircular) {
 
   // A depends on B. So B normally can't include headers from A.
   std::vector<Err> errors;
-  std::set<std::pair<const Target*, const Target*>> no_dependency_cache;
-  checker->CheckInclude(&b_, input_file, a_public, range, &no_dependency_cache,
-                        &errors);
+  checker->CheckInclude(&b_, input_file, a_public, range, &errors);
   EXPECT_GT(errors.size(), 0);
 
   // Add an allow_circular_includes_from on A that lists B.
@@ -308,9 +331,7 @@ TEST_F(HeaderCheckerTest, CheckIncludeAllowCircular) {
 
   // Now the include from B to A should be allowed.
   errors.clear();
-  no_dependency_cache.clear();
-  checker->CheckInclude(&b_, input_file, a_public, range, &no_dependency_cache,
-                        &errors);
+  checker->CheckInclude(&b_, input_file, a_public, range, &errors);
   EXPECT_EQ(errors.size(), 0);
 }
 
@@ -413,15 +434,11 @@ TEST_F(HeaderCheckerTest, Friend) {
 
   // B should not be allowed to include C's private header.
   std::vector<Err> errors;
-  std::set<std::pair<const Target*, const Target*>> no_dependency_cache;
-  checker->CheckInclude(&b_, input_file, c_private, range, &no_dependency_cache,
-                        &errors);
+  checker->CheckInclude(&b_, input_file, c_private, range, &errors);
   EXPECT_GT(errors.size(), 0);
 
   // A should be able to because of the friend declaration.
   errors.clear();
-  no_dependency_cache.clear();
-  checker->CheckInclude(&a_, input_file, c_private, range, &no_dependency_cache,
-                        &errors);
+  checker->CheckInclude(&a_, input_file, c_private, range, &errors);
   EXPECT_EQ(errors.size(), 0);
 }
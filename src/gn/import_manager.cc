@@ -6,15 +6,84 @@
 
 #include <memory>
 
+#include "gn/build_settings.h"
 #include "gn/err.h"
 #include "gn/parse_tree.h"
 #include "gn/scheduler.h"
 #include "gn/scope_per_file_provider.h"
+#include "gn/settings.h"
+#include "gn/template.h"
 #include "gn/trace.h"
+#include "gn/variables.h"
 #include "util/ticks.h"
 
 namespace {
 
+// Provides the same built-in variables as for imports executed in a
+// toolchain, and reports the ones that differ between toolchains to the probe.
+class ProbeProvider : public ScopePerFileProvider {
+ public:
+  ProbeProvider(Scope* scope, ImportProbe* probe)
+      : ScopePerFileProvider(scope, false), probe_(probe) {}
+
+  const Value* GetProgrammaticValue(std::string_view ident) override {
+    const Value* value = ScopePerFileProvider::GetProgrammaticValue(ident);
+    if (value && ident != variables::kGnVersion &&
+        ident != variables::kPythonPath && ident != variables::kRootBuildDir)
+      probe_->set_depends_on_toolchain();
+    return value;
+  }
+
+ private:
+  ImportProbe* probe_;
+};
+
+// Executes |file| outside of any toolchain and fills |result| if it doesn't
+// depend on the toolchain.
+void ProbeImport(const Settings* settings,
+                 const SourceFile& file,
+                 const ParseNode* node_for_err,
+                 SharedImports::Result* result) {
+  ScopedTrace load_trace(TraceItem::TRACE_IMPORT_LOAD, file.value());
+
+  ImportProbe probe(file);
+  Err err;
+  const ParseNode* node = g_scheduler->input_file_manager()->SyncLoadFile(
+      node_for_err->GetRange(), settings->build_settings(), file, &err);
+  if (!node)
+    return;
+
+  // Errors, including the ones caused by the missing toolchain, are reported
+  // when executing the file in a toolchain.
+  std::unique_ptr<Scope> scope = std::make_unique<Scope>(settings);
+  scope->set_source_dir(file.GetDir());
+  ProbeProvider provider(scope.get(), &probe);
+  scope->SetProcessingImport();
+  node->Execute(scope.get(), &err);
+  if (err.has_error() || probe.depends_on_toolchain())
+    return;
+  scope->ClearProcessingImport();
+
+  result->scope = std::move(scope);
+  result->missing_values = std::move(probe.missing_values());
+  result->missing_templates = std::move(probe.missing_templates());
+}
+
+// Returns whether the shared result of an import is the same as executing it
+// in the toolchain with the given build config.
+bool IsValidInToolchain(const SharedImports::Result& shared,
+                        const Scope* base_config) {
+  for (const std::string& name : shared.missing_values) {
+    if (base_config->GetValue(name))
+      return false;
+  }
+  for (const std::string& name : shared.missing_templates) {
+    if (base_config->GetTemplate(name))
+      return false;
+  }
+  return true;
+}
+
 // Returns a newly-allocated scope on success, null on failure.
 std::unique_ptr<Scope> UncachedImport(const Settings* settings,
                                       const SourceFile& file,
@@ -52,6 +121,50 @@ std::unique_ptr<Scope> UncachedImport(const Settings* settings,
 
 }  // namespace
 
+struct SharedImports::Entry {
+  // Protects |loaded| and |result|. Once loaded, the result is const and can
+  // be accessed outside of the lock.
+  std::mutex load_lock;
+  bool loaded = false;
+  Result result;
+};
+
+SharedImports::Result::Result() = default;
+
+SharedImports::Result::~Result() = default;
+
+SharedImports::SharedImports() = default;
+
+SharedImports::~SharedImports() = default;
+
+const SharedImports::Result* SharedImports::Get(
+    const Settings* settings,
+    const SourceFile& file,
+    const ParseNode* node_for_err) {
+  // Import loops are reported when executing the file in a toolchain.
+  for (const ImportProbe* probe = ImportProbe::Current(); probe;
+       probe = probe->previous()) {
+    if (probe->file() == file)
+      return nullptr;
+  }
+
+  Entry* entry = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    std::unique_ptr<Entry>& entry_ptr = entries_[file];
+    if (!entry_ptr)
+      entry_ptr = std::make_unique<Entry>();
+    entry = entry_ptr.get();
+  }
+
+  std::lock_guard<std::mutex> lock(entry->load_lock);
+  if (!entry->loaded) {
+    ProbeImport(settings, file, node_for_err, &entry->result);
+    entry->loaded = true;
+  }
+  return entry->result.scope ? &entry->result : nullptr;
+}
+
 struct ImportManager::ImportInfo {
   ImportInfo() = default;
   ~ImportInfo() = default;
@@ -68,6 +181,64 @@ struct ImportManager::ImportInfo {
   Err load_result;
 };
 
+ToolchainScopeCopier::ToolchainScopeCopier(const Settings* from,
+                                           const Settings* to)
+    : from_(from), to_(to) {}
+
+ToolchainScopeCopier::~ToolchainScopeCopier() = default;
+
+void ToolchainScopeCopier::CopyTo(const Scope* scope, Scope* dest) {
+  Scope::MergeOptions options;
+  options.clobber_existing = true;
+  Err err;
+  scope->NonRecursiveMergeTo(dest, options, nullptr, "<SHOULDN'T HAPPEN>",
+                             &err);
+  DCHECK(!err.has_error());
+
+  // Scope values are standalone scopes of the source toolchain.
+  Scope::KeyValueMap values;
+  scope->GetCurrentScopeValues(&values);
+  for (const auto& pair : values) {
+    CopyNestedScopes(
+        dest->GetMutableValue(pair.first, Scope::SEARCH_CURRENT, false));
+  }
+
+  // Closures don't contain the template itself, so this terminates.
+  dest->ReplaceTemplates(
+      [this](const Template* templ) { return CopyTemplate(templ); });
+}
+
+std::unique_ptr<Scope> ToolchainScopeCopier::Copy(const Scope* scope) {
+  // Imports and closures either refer to the build config or are standalone.
+  std::unique_ptr<Scope> result;
+  if (scope->containing() == from_->base_config()) {
+    result = std::make_unique<Scope>(to_->base_config());
+  } else {
+    DCHECK(!scope->containing());
+    result = std::make_unique<Scope>(to_);
+  }
+  result->set_source_dir(scope->GetSourceDir());
+  CopyTo(scope, result.get());
+  return result;
+}
+
+void ToolchainScopeCopier::CopyNestedScopes(Value* value) {
+  if (value->type() == Value::SCOPE) {
+    value->SetScopeValue(Copy(value->scope_value()));
+  } else if (value->type() == Value::LIST) {
+    for (Value& item : value->list_value())
+      CopyNestedScopes(&item);
+  }
+}
+
+scoped_refptr<const Template> ToolchainScopeCopier::CopyTemplate(
+    const Template* templ) {
+  scoped_refptr<const Template>& copy = templates_[templ];
+  if (!copy)
+    copy = new Template(Copy(templ->closure()), templ->definition());
+  return copy;
+}
+
 ImportManager::ImportManager() = default;
 
 ImportManager::~ImportManager() = default;
@@ -76,6 +247,9 @@ bool ImportManager::DoImport(const SourceFile& file,
                              const ParseNode* node_for_err,
                              Scope* scope,
                              Err* err) {
+  if (ImportProbe::Current())
+    return DoProbedImport(file, node_for_err, scope, err);
+
   // Key for the current import on the current thread in imports_in_progress_.
   std::stringstream ss;
   ss << std::this_thread::get_id() << file.value();
@@ -110,8 +284,8 @@ bool ImportManager::DoImport(const SourceFile& file,
     if (!import_info->scope) {
       // Only load if the import hasn't already failed.
       if (!import_info->load_result.has_error()) {
-        import_info->scope = UncachedImport(
-            scope->settings(), file, node_for_err, &import_info->load_result);
+        import_info->scope = Import(scope->settings(), file, node_for_err,
+                                    &import_info->load_result);
       }
       if (import_info->load_result.has_error()) {
         *err = import_info->load_result;
@@ -125,13 +299,12 @@ bool ImportManager::DoImport(const SourceFile& file,
       if (TracingEnabled() &&
           TicksDelta(import_block_end, import_block_begin).InMilliseconds() >
               kImportBlockTraceThresholdMS) {
-        auto* import_block_trace =
-            new TraceItem(TraceItem::TRACE_IMPORT_BLOCK, file.value(),
-                          std::this_thread::get_id());
-        import_block_trace->set_begin(import_block_begin);
-        import_block_trace->set_end(import_block_end);
-        import_block_trace->set_toolchain(
-            scope->settings()->toolchain_label().GetUserVisibleName(false));
+        TraceItem import_block_trace(TraceItem::TRACE_IMPORT_BLOCK,
+                                     StringAtom(file.value()));
+        import_block_trace.set_begin(import_block_begin);
+        import_block_trace.set_end(import_block_end);
+        import_block_trace.set_toolchain(StringAtom(
+            scope->settings()->toolchain_label().GetUserVisibleName(false)));
         AddTrace(import_block_trace);
       }
     }
@@ -153,6 +326,112 @@ bool ImportManager::DoImport(const SourceFile& file,
                                            "import", err);
 }
 
+std::unique_ptr<Scope> ImportManager::Import(const Settings* settings,
+                                             const SourceFile& file,
+                                             const ParseNode* node_for_err,
+                                             Err* err) {
+  const SharedImports::Result* shared =
+      settings->build_settings()->shared_imports().Get(settings, file,
+                                                       node_for_err);
+  if (shared && IsValidInToolchain(*shared, settings->base_config()))
+    return BindSharedImport(shared->scope.get(), settings);
+  return UncachedImport(settings, file, node_for_err, err);
+}
+
+bool ImportManager::DoProbedImport(const SourceFile& file,
+                                   const ParseNode* node_for_err,
+                                   Scope* scope,
+                                   Err* err) {
+  ImportProbe* probe = ImportProbe::Current();
+  const SharedImports::Result* shared =
+      scope->settings()->build_settings()->shared_imports().Get(
+          scope->settings(), file, node_for_err);
+  if (!shared) {
+    probe->set_depends_on_toolchain();
+    *err = Err(node_for_err, "Depends on the toolchain.");
+    return false;
+  }
+
+  // The conditions for the nested import to be valid in a toolchain also
+  // apply to this one.
+  probe->missing_values().insert(shared->missing_values.begin(),
+                                 shared->missing_values.end());
+  probe->missing_templates().insert(shared->missing_templates.begin(),
+                                    shared->missing_templates.end());
+
+  Scope::MergeOptions options;
+  options.skip_private_vars = true;
+  options.mark_dest_used = true;
+  return shared->scope->NonRecursiveMergeTo(scope, options, node_for_err,
+                                            "import", err);
+}
+
+std::unique_ptr<Scope> ImportManager::BindSharedImport(
+    const Scope* shared,
+    const Settings* settings) {
+  std::unique_ptr<Scope> scope =
+      std::make_unique<Scope>(settings->base_config());
+  scope->set_source_dir(shared->GetSourceDir());
+
+  Scope::MergeOptions options;
+  options.clobber_existing = true;
+  Err err;
+  shared->NonRecursiveMergeTo(scope.get(), options, nullptr,
+                              "<SHOULDN'T HAPPEN>", &err);
+  DCHECK(!err.has_error());
+
+  std::lock_guard<std::mutex> lock(bind_lock_);
+  scope->ReplaceTemplates([this, settings](const Template* templ) {
+    return BindTemplateLocked(templ, settings);
+  });
+  return scope;
+}
+
+scoped_refptr<const Template> ImportManager::BindTemplateLocked(
+    const Template* templ,
+    const Settings* settings) {
+  scoped_refptr<const Template>& bound = bound_templates_[templ];
+  if (bound)
+    return bound;
+
+  // Like Scope::MakeClosure() from an import executed in the toolchain.
+  std::unique_ptr<Scope> closure =
+      std::make_unique<Scope>(settings->base_config());
+  Scope::MergeOptions options;
+  options.clobber_existing = true;
+  Err err;
+  templ->closure()->NonRecursiveMergeTo(closure.get(), options, nullptr,
+                                        "<SHOULDN'T HAPPEN>", &err);
+  DCHECK(!err.has_error());
+
+  // Closures don't contain the template itself, so this terminates.
+  closure->ReplaceTemplates([this, settings](const Template* nested) {
+    return BindTemplateLocked(nested, settings);
+  });
+  bound = new Template(std::move(closure), templ->definition());
+  return bound;
+}
+
+void ImportManager::CopyImportsFrom(ImportManager* other,
+                                    const std::vector<SourceFile>& files,
+                                    ToolchainScopeCopier* copier) {
+  std::lock_guard<std::mutex> lock(imports_lock_);
+  std::lock_guard<std::mutex> other_lock(other->imports_lock_);
+  for (const SourceFile& file : files) {
+    const ImportInfo* other_info = other->imports_[file].get();
+    DCHECK(other_info && other_info->scope);
+    std::unique_ptr<ImportInfo>& info = imports_[file];
+    info = std::make_unique<ImportInfo>();
+    info->scope = copier->Copy(other_info->scope.get());
+  }
+
+  // Shared imports done later must use the same copies of the templates.
+  std::lock_guard<std::mutex> bind_lock(bind_lock_);
+  std::lock_guard<std::mutex> other_bind_lock(other->bind_lock_);
+  for (const auto& pair : other->bound_templates_)
+    bound_templates_[pair.first] = copier->CopyTemplate(pair.second.get());
+}
+
 std::vector<SourceFile> ImportManager::GetImportedFiles() const {
   std::vector<SourceFile> imported_files;
   imported_files.resize(imports_.size());
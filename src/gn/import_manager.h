@@ -8,14 +8,98 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <string>
 #include <unordered_set>
 #include <vector>
 
+#include "base/memory/ref_counted.h"
+
 class Err;
 class ParseNode;
 class Scope;
+class Settings;
 class SourceFile;
+class Template;
+class Value;
+
+// The results of the imports that don't depend on the toolchain, shared by
+// the ImportManagers of all the toolchains of a build.
+//
+// Every imported file is first executed once outside of any toolchain, with an
+// ImportProbe recording what it looks at. If it only uses values it defines
+// itself or imports from other shared files, and only calls functions that
+// behave the same in every toolchain, each toolchain gets a copy of the result
+// instead of executing the file again. Otherwise, each toolchain executes it
+// as usual.
+class SharedImports {
+ public:
+  struct Result {
+    Result();
+    ~Result();
+
+    // The scope resulting from the import, without containing scope. Null if
+    // the import depends on the toolchain.
+    std::unique_ptr<const Scope> scope;
+
+    // The values and templates the import looked up without finding them. The
+    // result only holds for a toolchain whose build config doesn't define any
+    // of them.
+    std::set<std::string> missing_values;
+    std::set<std::string> missing_templates;
+  };
+
+  SharedImports();
+  ~SharedImports();
+
+  // Returns the shared result of importing |file|, executing it first if it
+  // hasn't been, or null if the result depends on the toolchain. Only the
+  // build settings of |settings| are used.
+  const Result* Get(const Settings* settings,
+                    const SourceFile& file,
+                    const ParseNode* node_for_err);
+
+ private:
+  struct Entry;
+
+  std::mutex lock_;
+  std::map<SourceFile, std::unique_ptr<Entry>> entries_;
+
+  SharedImports(const SharedImports&) = delete;
+  SharedImports& operator=(const SharedImports&) = delete;
+};
+
+// Copies scopes and templates of the toolchain of |from| for the toolchain of
+// |to|, whose build configs have the same values. The copies refer to the
+// build config of |to| wherever the originals refer to the one of |from|, and
+// each template is only copied once.
+class ToolchainScopeCopier {
+ public:
+  ToolchainScopeCopier(const Settings* from, const Settings* to);
+  ~ToolchainScopeCopier();
+
+  // Copies the values, templates and target defaults of |scope| into |dest|.
+  // Scope values, including the ones in lists, are copied for the new
+  // toolchain as well.
+  void CopyTo(const Scope* scope, Scope* dest);
+
+  // Returns a new scope with the same contents as |scope|.
+  std::unique_ptr<Scope> Copy(const Scope* scope);
+
+  scoped_refptr<const Template> CopyTemplate(const Template* templ);
+
+ private:
+  // Replaces the scopes in |value| by copies for the new toolchain.
+  void CopyNestedScopes(Value* value);
+
+  const Settings* from_;
+  const Settings* to_;
+
+  std::map<const Template*, scoped_refptr<const Template>> templates_;
+
+  ToolchainScopeCopier(const ToolchainScopeCopier&) = delete;
+  ToolchainScopeCopier& operator=(const ToolchainScopeCopier&) = delete;
+};
 
 // Provides a cache of the results of importing scopes so the results can
 // be re-used rather than running the imported files multiple times.
@@ -33,9 +117,40 @@ class ImportManager {
 
   std::vector<SourceFile> GetImportedFiles() const;
 
+  // Starts with copies of the imports of |files| done by |other|, for
+  // another toolchain, using |copier|. The imports must have succeeded.
+  void CopyImportsFrom(ImportManager* other,
+                       const std::vector<SourceFile>& files,
+                       ToolchainScopeCopier* copier);
+
  private:
   struct ImportInfo;
 
+  // Returns the result of importing |file| in the toolchain of |settings|,
+  // either from SharedImports or by executing it. Returns null on error.
+  std::unique_ptr<Scope> Import(const Settings* settings,
+                                const SourceFile& file,
+                                const ParseNode* node_for_err,
+                                Err* err);
+
+  // Imports |file| into |scope| while probing another import (see
+  // ImportProbe), which is only possible if |file| is shared too.
+  bool DoProbedImport(const SourceFile& file,
+                      const ParseNode* node_for_err,
+                      Scope* scope,
+                      Err* err);
+
+  // Makes a copy of a shared import result for the toolchain of |settings|.
+  std::unique_ptr<Scope> BindSharedImport(const Scope* shared,
+                                          const Settings* settings);
+
+  // Returns the copy of a template of a shared import for the toolchain of
+  // |settings|, whose closure refers to its build config. There is only one
+  // copy of each template, so that importing it through different files
+  // doesn't cause collisions. |bind_lock_| must be held.
+  scoped_refptr<const Template> BindTemplateLocked(const Template* templ,
+                                                   const Settings* settings);
+
   // Protects access to imports_ and imports_in_progress_. Do not hold when
   // actually executing imports.
   std::mutex imports_lock_;
@@ -46,6 +161,12 @@ class ImportManager {
 
   std::unordered_set<std::string> imports_in_progress_;
 
+  // Protects bound_templates_.
+  std::mutex bind_lock_;
+
+  // Maps the templates of shared imports to their copy for this toolchain.
+  std::map<const Template*, scoped_refptr<const Template>> bound_templates_;
+
   ImportManager(const ImportManager&) = delete;
   ImportManager& operator=(const ImportManager&) = delete;
 };
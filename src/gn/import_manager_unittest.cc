@@ -0,0 +1,140 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/import_manager.h"
+
+#include <map>
+#include <string>
+
+#include "gn/input_file.h"
+#include "gn/scheduler.h"
+#include "gn/template.h"
+#include "gn/test_with_scheduler.h"
+#include "gn/test_with_scope.h"
+#include "util/test/test.h"
+
+namespace {
+
+class ImportManagerTest : public TestWithScheduler {
+ protected:
+  ImportManagerTest() : other_settings_(setup_.build_settings(), "other/") {
+    setup_.settings()->base_config()->SetValue(
+        "current_cpu", Value(nullptr, "x64"), nullptr);
+    other_settings_.base_config()->SetValue(
+        "current_cpu", Value(nullptr, "arm"), nullptr);
+    other_settings_.base_config()->SetValue("use_foo", Value(nullptr, false),
+                                            nullptr);
+
+    scheduler().input_file_manager()->set_load_file_callback(
+        [this](const SourceFile& file_name, InputFile* file) {
+          auto found = files_.find(file_name.value());
+          if (found == files_.end())
+            return false;
+          file->SetContents(found->second);
+          return true;
+        });
+  }
+
+  ~ImportManagerTest() override {
+    scheduler().input_file_manager()->set_load_file_callback(nullptr);
+  }
+
+  // Executes an import of |file| into |scope|.
+  bool Import(Scope* scope, const std::string& file) {
+    TestParseInput input("import(\"" + file + "\")");
+    EXPECT_FALSE(input.has_error());
+    Err err;
+    input.parsed()->Execute(scope, &err);
+    return !err.has_error();
+  }
+
+  TestWithScope setup_;
+  Settings other_settings_;
+  std::map<std::string, std::string> files_;
+};
+
+}  // namespace
+
+TEST_F(ImportManagerTest, SharedBetweenToolchains) {
+  files_["//shared.gni"] =
+      "_private = [ \"a\" ]\n"
+      "shared_list = _private + [ \"b\" ]\n"
+      "template(\"shared_template\") {\n"
+      "  not_needed(invoker, \"*\")\n"
+      "}\n";
+  files_["//wrapper.gni"] =
+      "import(\"//shared.gni\")\n"
+      "wrapped = string_join(\",\", shared_list)\n";
+  files_["//dependent.gni"] = "is_arm = current_cpu == \"arm\"\n";
+
+  Scope scope(setup_.settings()->base_config());
+  ASSERT_TRUE(Import(&scope, "//wrapper.gni"));
+  ASSERT_TRUE(Import(&scope, "//shared.gni"));
+  ASSERT_TRUE(Import(&scope, "//dependent.gni"));
+
+  Scope other_scope(other_settings_.base_config());
+  ASSERT_TRUE(Import(&other_scope, "//shared.gni"));
+  ASSERT_TRUE(Import(&other_scope, "//dependent.gni"));
+
+  SharedImports& shared = setup_.build_settings()->shared_imports();
+  TestParseInput node("foo");
+  EXPECT_TRUE(
+      shared.Get(setup_.settings(), SourceFile("//shared.gni"), node.parsed()));
+  EXPECT_TRUE(shared.Get(setup_.settings(), SourceFile("//wrapper.gni"),
+                         node.parsed()));
+  EXPECT_FALSE(shared.Get(setup_.settings(), SourceFile("//dependent.gni"),
+                          node.parsed()));
+
+  // Values are the same in both toolchains, private ones aren't imported.
+  EXPECT_EQ("[\"a\", \"b\"]", scope.GetValue("shared_list")->ToString(false));
+  EXPECT_EQ("a,b", scope.GetValue("wrapped")->string_value());
+  EXPECT_FALSE(scope.GetValue("_private"));
+  EXPECT_EQ("[\"a\", \"b\"]",
+            other_scope.GetValue("shared_list")->ToString(false));
+
+  // Templates refer to the build config of their toolchain, and importing
+  // them through different files doesn't cause collisions.
+  const Template* templ = scope.GetTemplate("shared_template");
+  const Template* other_templ = other_scope.GetTemplate("shared_template");
+  ASSERT_TRUE(templ);
+  ASSERT_TRUE(other_templ);
+  EXPECT_NE(templ, other_templ);
+  EXPECT_EQ(setup_.settings()->base_config(), templ->closure()->containing());
+  EXPECT_EQ(other_settings_.base_config(),
+            other_templ->closure()->containing());
+
+  // Imports depending on the toolchain are executed in each of them.
+  EXPECT_FALSE(scope.GetValue("is_arm")->boolean_value());
+  EXPECT_TRUE(other_scope.GetValue("is_arm")->boolean_value());
+}
+
+TEST_F(ImportManagerTest, MissingValues) {
+  // Shared, but only valid in toolchains that don't define |use_foo|.
+  files_["//defaults.gni"] =
+      "if (!defined(use_foo)) {\n"
+      "  use_foo = true\n"
+      "}\n";
+
+  Scope scope(setup_.settings()->base_config());
+  ASSERT_TRUE(Import(&scope, "//defaults.gni"));
+  EXPECT_TRUE(scope.GetValue("use_foo")->boolean_value());
+
+  Scope other_scope(other_settings_.base_config());
+  ASSERT_TRUE(Import(&other_scope, "//defaults.gni"));
+  EXPECT_FALSE(other_scope.GetValue("use_foo")->boolean_value());
+}
+
+TEST_F(ImportManagerTest, FunctionsDependingOnToolchain) {
+  files_["//print.gni"] =
+      "print(\"hello\")\n"
+      "foo = 1\n";
+
+  Scope scope(setup_.settings()->base_config());
+  ASSERT_TRUE(Import(&scope, "//print.gni"));
+  Scope other_scope(other_settings_.base_config());
+  ASSERT_TRUE(Import(&other_scope, "//print.gni"));
+
+  // Printed once per toolchain, as before.
+  EXPECT_EQ("hello\nhello\n", setup_.print_output());
+}
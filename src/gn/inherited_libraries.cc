@@ -6,47 +6,109 @@
 
 #include "gn/target.h"
 
+// Accumulates the flattened list. Expanding the entries in order and keeping
+// the first occurrence of each library gives the same order as appending the
+// libraries one by one would have.
+struct InheritedLibraries::Collector {
+  void Add(const Target* target, bool is_public) {
+    auto inserted = index.emplace(target, result.size());
+    if (inserted.second)
+      result.emplace_back(target, is_public);
+    else if (is_public)
+      result[inserted.first->second].second = true;
+  }
+
+  std::vector<std::pair<const Target*, bool>> result;
+  std::unordered_map<const Target*, size_t> index;
+
+  // Lists already expanded, and whether that was with their public flags.
+  // All their libraries are in |result| already, so a list only needs to be
+  // expanded again to make some of them public.
+  std::unordered_map<const InheritedLibraries*, bool> visited;
+};
+
 InheritedLibraries::InheritedLibraries() = default;
 
 InheritedLibraries::~InheritedLibraries() = default;
 
-std::vector<std::pair<const Target*, bool>>
-InheritedLibraries::GetOrderedAndPublicFlag() const {
-  std::vector<std::pair<const Target*, bool>> result;
-  result.reserve(targets_.size());
-  for (size_t i = 0; i < targets_.size(); ++i)
-    result.emplace_back(targets_[i], public_flags_[i]);
+std::vector<const Target*> InheritedLibraries::GetOrdered() const {
+  Collector collector;
+  const std::vector<std::pair<const Target*, bool>>* flattened =
+      GetFlattened();
+  if (!flattened) {
+    Collect(true, &collector);
+    flattened = &collector.result;
+  }
+
+  std::vector<const Target*> result;
+  result.reserve(flattened->size());
+  for (const auto& pair : *flattened)
+    result.push_back(pair.first);
   return result;
 }
 
-void InheritedLibraries::Append(const Target* target, bool is_public) {
-  // Try to insert a new node.
-  auto ret = targets_.PushBackWithIndex(target);
-  if (ret.first) {
-    public_flags_.push_back(is_public);
-  } else if (is_public) {
-    // Target already present, if |is_public|, set its flag.
-    public_flags_[ret.second] = true;
+const std::vector<std::pair<const Target*, bool>>&
+InheritedLibraries::GetOrderedAndPublicFlag() const {
+  std::lock_guard<std::mutex> lock(flattened_lock_);
+  if (!flattened_) {
+    Collector collector;
+    Collect(true, &collector);
+    flattened_ = std::make_unique<std::vector<std::pair<const Target*, bool>>>(
+        std::move(collector.result));
   }
+  return *flattened_;
+}
+
+void InheritedLibraries::Append(const Target* target, bool is_public) {
+  AppendEntry(target, Entry{target, nullptr, is_public});
 }
 
 void InheritedLibraries::AppendInherited(const InheritedLibraries& other,
                                          bool is_public) {
-  // Append all items in order, mark them public only if the're already public
-  // and we're adding them publicly.
-  for (size_t i = 0; i < other.targets_.size(); ++i) {
-    Append(other.targets_[i], is_public && other.public_flags_[i]);
-  }
+  // Items are marked public only if they're already public and we're adding
+  // them publicly, which is applied when the lists are expanded.
+  if (!other.entries_.empty())
+    AppendEntry(&other, Entry{nullptr, &other, is_public});
 }
 
 void InheritedLibraries::AppendPublicSharedLibraries(
     const InheritedLibraries& other,
     bool is_public) {
-  for (size_t i = 0; i < other.targets_.size(); ++i) {
-    const Target* target = other.targets_[i];
-    if (target->output_type() == Target::SHARED_LIBRARY &&
-        other.public_flags_[i]) {
-      Append(target, is_public);
+  for (const auto& pair : other.GetOrderedAndPublicFlag()) {
+    if (pair.first->output_type() == Target::SHARED_LIBRARY && pair.second)
+      Append(pair.first, is_public);
+  }
+}
+
+void InheritedLibraries::Collect(bool is_public, Collector* collector) const {
+  for (const Entry& entry : entries_) {
+    bool entry_public = is_public && entry.is_public;
+    if (!entry.list) {
+      collector->Add(entry.target, entry_public);
+      continue;
     }
+
+    auto inserted = collector->visited.emplace(entry.list, entry_public);
+    if (!inserted.second) {
+      if (inserted.first->second || !entry_public)
+        continue;
+      inserted.first->second = true;
+    }
+    entry.list->Collect(entry_public, collector);
   }
 }
+
+const std::vector<std::pair<const Target*, bool>>*
+InheritedLibraries::GetFlattened() const {
+  std::lock_guard<std::mutex> lock(flattened_lock_);
+  return flattened_.get();
+}
+
+void InheritedLibraries::AppendEntry(const void* key, const Entry& entry) {
+  flattened_.reset();
+  auto inserted = entry_index_.emplace(key, entries_.size());
+  if (inserted.second)
+    entries_.push_back(entry);
+  else if (entry.is_public)
+    entries_[inserted.first->second].is_public = true;
+}
@@ -7,11 +7,12 @@
 
 #include <stddef.h>
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
-#include "gn/unique_vector.h"
-
 class Target;
 
 // Represents an ordered uniquified set of all shared/static libraries for
@@ -24,15 +25,29 @@ class Target;
 // append a new item if the target already exists. However, the existing one
 // may have its is_public flag updated. "Public" always wins, so is_public will
 // be true if any dependency with that name has been set to public.
+//
+// Lists are structurally shared: appending the list of a dependency only
+// records a reference to it, and the full list is computed when requested.
+// Otherwise every target in a deep chain would hold a copy of the libraries
+// of everything below it. As a consequence, a list that has been appended to
+// another must outlive it and not be modified anymore, which is the case for
+// the lists of resolved dependencies.
+//
+// The flattened list with public flags is kept once computed, since the lists
+// of libraries are read again for every target depending on them. It is
+// dropped when the list is modified, which only happens before the list is
+// shared, so reading it is thread-safe.
 class InheritedLibraries {
  public:
   InheritedLibraries();
   ~InheritedLibraries();
 
   // Returns the list of dependencies in order, optionally with the flag
-  // indicating whether the dependency is public.
-  std::vector<const Target*> GetOrdered() const { return targets_.vector(); }
-  std::vector<std::pair<const Target*, bool>> GetOrderedAndPublicFlag() const;
+  // indicating whether the dependency is public. GetOrdered is meant for
+  // reading a list once and doesn't keep the flattened list.
+  std::vector<const Target*> GetOrdered() const;
+  const std::vector<std::pair<const Target*, bool>>& GetOrderedAndPublicFlag()
+      const;
 
   // Adds a single dependency to the end of the list. See note on adding above.
   void Append(const Target* target, bool is_public);
@@ -53,8 +68,31 @@ class InheritedLibraries {
                                    bool is_public);
 
  private:
-  UniqueVector<const Target*> targets_;
-  std::vector<bool> public_flags_;
+  struct Collector;
+
+  // Either a single library, or all the libraries of another list.
+  struct Entry {
+    const Target* target;
+    const InheritedLibraries* list;
+    bool is_public;
+  };
+
+  // Adds the libraries to |collector|, public ones only if |is_public|.
+  void Collect(bool is_public, Collector* collector) const;
+
+  // Adds an entry for |key|, a target or a list, or updates the public flag of
+  // the existing one. Appending the same thing twice only changes flags.
+  void AppendEntry(const void* key, const Entry& entry);
+
+  // Returns the flattened list if it has been computed already.
+  const std::vector<std::pair<const Target*, bool>>* GetFlattened() const;
+
+  std::vector<Entry> entries_;
+  std::unordered_map<const void*, size_t> entry_index_;
+
+  mutable std::mutex flattened_lock_;
+  mutable std::unique_ptr<std::vector<std::pair<const Target*, bool>>>
+      flattened_;
 
   InheritedLibraries(const InheritedLibraries&) = delete;
   InheritedLibraries& operator=(const InheritedLibraries&) = delete;
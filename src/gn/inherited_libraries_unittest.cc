@@ -133,3 +133,47 @@ TEST(InheritedLibraries, AppendPublicSharedLibraries) {
   ASSERT_EQ(1u, result.size());
   EXPECT_EQ(Pair(&sh_pub, true), result[0]);
 }
+
+// A list reachable through several dependencies, privately through one and
+// publicly through the other, must appear once with the public flags kept.
+TEST(InheritedLibraries, SharedDiamond) {
+  TestWithScope setup;
+  Target a(setup.settings(), Label(SourceDir("//foo/"), "a"));
+  Target b(setup.settings(), Label(SourceDir("//foo/"), "b"));
+  Target c(setup.settings(), Label(SourceDir("//foo/"), "c"));
+  Target d(setup.settings(), Label(SourceDir("//foo/"), "d"));
+
+  InheritedLibraries bottom;
+  bottom.Append(&a, true);
+  bottom.Append(&b, false);
+
+  InheritedLibraries left;
+  left.Append(&c, false);
+  left.AppendInherited(bottom, false);
+
+  InheritedLibraries right;
+  right.AppendInherited(bottom, true);
+  right.Append(&d, true);
+
+  InheritedLibraries top;
+  top.AppendInherited(left, true);
+  top.AppendInherited(right, true);
+
+  auto result = top.GetOrderedAndPublicFlag();
+  ASSERT_EQ(4u, result.size());
+  EXPECT_EQ(Pair(&c, false), result[0]);
+  EXPECT_EQ(Pair(&a, true), result[1]);  // Public through |right|.
+  EXPECT_EQ(Pair(&b, false), result[2]);
+  EXPECT_EQ(Pair(&d, true), result[3]);
+
+  // Only the public path forwards public flags.
+  InheritedLibraries top_private;
+  top_private.AppendInherited(right, false);
+  top_private.AppendInherited(left, true);
+  result = top_private.GetOrderedAndPublicFlag();
+  ASSERT_EQ(4u, result.size());
+  EXPECT_EQ(Pair(&a, false), result[0]);
+  EXPECT_EQ(Pair(&b, false), result[1]);
+  EXPECT_EQ(Pair(&d, false), result[2]);
+  EXPECT_EQ(Pair(&c, false), result[3]);
+}
@@ -5,13 +5,17 @@
 #include "gn/input_conversion.h"
 
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <utility>
 
 #include "base/json/json_reader.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
-#include "base/values.h"
+#include "base/strings/stringprintf.h"
+#include "base/strings/utf_string_conversion_utils.h"
+#include "base/third_party/icu/icu_utf.h"
 #include "gn/build_settings.h"
 #include "gn/err.h"
 #include "gn/input_file.h"
@@ -21,6 +25,7 @@
 #include "gn/scheduler.h"
 #include "gn/scope.h"
 #include "gn/settings.h"
+#include "gn/string_atom.h"
 #include "gn/tokenizer.h"
 #include "gn/value.h"
 
@@ -33,7 +38,7 @@ enum ValueOrScope {
 
 // Sets the origin of the value and any nested values with the given node.
 Value ParseValueOrScope(const Settings* settings,
-                        const std::string& input,
+                        std::string_view input,
                         ValueOrScope what,
                         const ParseNode* origin,
                         Err* err) {
@@ -45,7 +50,7 @@ Value ParseValueOrScope(const Settings* settings,
   g_scheduler->input_file_manager()->AddDynamicInput(SourceFile(), &input_file,
                                                      &tokens, &parse_root_ptr);
 
-  input_file->SetContents(input);
+  input_file->SetContents(std::string(input));
   if (origin) {
     // This description will be the blame for any error messages caused by
     // script parsing or if a value is blamed. It will say
@@ -90,7 +95,7 @@ Value ParseValueOrScope(const Settings* settings,
   return result;
 }
 
-Value ParseList(const std::string& input, const ParseNode* origin, Err* err) {
+Value ParseList(std::string_view input, const ParseNode* origin, Err* err) {
   Value ret(origin, Value::LIST);
   std::vector<std::string> as_lines = base::SplitString(
       input, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_ALL);
@@ -117,83 +122,578 @@ bool IsIdentifier(std::string_view buffer) {
   return true;
 }
 
-Value ParseJSONValue(const Settings* settings,
-                     const base::Value& value,
-                     const ParseNode* origin,
-                     InputFile* input_file,
-                     Err* err) {
-  switch (value.type()) {
-    case base::Value::Type::NONE:
-      *err = Err(origin, "Null values are not supported.");
-      return Value();
-    case base::Value::Type::BOOLEAN:
-      return Value(origin, value.GetBool());
-    case base::Value::Type::INTEGER:
-      return Value(origin, static_cast<int64_t>(value.GetInt()));
-    case base::Value::Type::STRING:
-      return Value(origin, value.GetString());
-    case base::Value::Type::BINARY:
-      *err = Err(origin, "Binary values are not supported.");
-      return Value();
-    case base::Value::Type::DICTIONARY: {
-      std::unique_ptr<Scope> scope = std::make_unique<Scope>(settings);
-      for (auto it : value.DictItems()) {
-        Value parsed_value =
-            ParseJSONValue(settings, it.second, origin, input_file, err);
-        if (!IsIdentifier(it.first)) {
-          *err = Err(origin, "Invalid identifier \"" + it.first + "\".");
-          return Value();
+// Parses JSON directly into GN values, without building a base::Value tree
+// first. The grammar and the syntax error messages are the ones of
+// base::JSONReader with JSON_PARSE_RFC, which this replaced.
+class JSONValueParser {
+ public:
+  JSONValueParser(const Settings* settings,
+                  std::string_view input,
+                  const ParseNode* origin)
+      : settings_(settings), input_(input), origin_(origin) {}
+
+  Value Parse(Err* err);
+
+ private:
+  enum Token {
+    T_OBJECT_BEGIN,
+    T_OBJECT_END,
+    T_ARRAY_BEGIN,
+    T_ARRAY_END,
+    T_STRING,
+    T_NUMBER,
+    T_BOOL_TRUE,
+    T_BOOL_FALSE,
+    T_NULL,
+    T_LIST_SEPARATOR,
+    T_OBJECT_PAIR_SEPARATOR,
+    T_END_OF_INPUT,
+    T_INVALID_TOKEN,
+  };
+
+  // Returns the next character without consuming it, or 0 at the end of the
+  // input. JSON tokens never start with 0.
+  char PeekChar() const {
+    return index_ < input_.size() ? input_[index_] : 0;
+  }
+
+  Token GetNextToken();
+  void EatWhitespaceAndComments();
+  bool EatComment();
+
+  // The functions parsing a value return false on syntax errors. Other errors
+  // are reported with ReportValueError() and parsing goes on, so that syntax
+  // errors take precedence.
+  bool ParseToken(Token token, Value* out);
+  bool ConsumeDictionary(Value* out);
+  bool ConsumeList(Value* out);
+  bool ConsumeString(std::string* out);
+  bool DecodeUTF16(uint32_t* out_code_point);
+  bool ConsumeNumber(Value* out);
+  bool ReadInt(bool allow_leading_zeros);
+  bool ConsumeLiteral(Value* out);
+  bool ConsumeIfMatch(std::string_view match);
+
+  void ReportError(base::JSONReader::JsonParseError code, int column_adjust);
+  void ReportValueError(const std::string& message);
+
+  const Settings* settings_;
+  std::string_view input_;
+  const ParseNode* origin_;
+
+  size_t index_ = 0;
+  int stack_depth_ = 0;
+  int line_number_ = 1;
+  size_t index_last_line_ = 0;
+
+  base::JSONReader::JsonParseError error_code_ =
+      base::JSONReader::JSON_NO_ERROR;
+  int error_line_ = 0;
+  int error_column_ = 0;
+
+  // The first error that isn't a syntax error.
+  Err value_err_;
+};
+
+Value JSONValueParser::Parse(Err* err) {
+  // The base reader uses 32-bit indices.
+  if (input_.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+    ReportError(base::JSONReader::JSON_TOO_LARGE, 0);
+
+  // Skip the UTF-8 byte order mark.
+  if (error_code_ == base::JSONReader::JSON_NO_ERROR)
+    ConsumeIfMatch("\xEF\xBB\xBF");
+
+  Value result;
+  bool ok = error_code_ == base::JSONReader::JSON_NO_ERROR &&
+            ParseToken(GetNextToken(), &result);
+  if (ok && GetNextToken() != T_END_OF_INPUT) {
+    ReportError(base::JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, 1);
+    ok = false;
+  }
+
+  if (!ok) {
+    std::string message = base::JSONReader::ErrorCodeToString(error_code_);
+    if (error_line_ || error_column_) {
+      message = base::StringPrintf("Line: %i, column: %i, %s", error_line_,
+                                   error_column_, message.c_str());
+    }
+    *err = Err(origin_, "Input is not a valid JSON: " + message);
+    return Value();
+  }
+  if (value_err_.has_error()) {
+    *err = value_err_;
+    return Value();
+  }
+  return result;
+}
+
+JSONValueParser::Token JSONValueParser::GetNextToken() {
+  EatWhitespaceAndComments();
+  if (index_ == input_.size())
+    return T_END_OF_INPUT;
+
+  switch (input_[index_]) {
+    case '{':
+      return T_OBJECT_BEGIN;
+    case '}':
+      return T_OBJECT_END;
+    case '[':
+      return T_ARRAY_BEGIN;
+    case ']':
+      return T_ARRAY_END;
+    case '"':
+      return T_STRING;
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+    case '-':
+      return T_NUMBER;
+    case 't':
+      return T_BOOL_TRUE;
+    case 'f':
+      return T_BOOL_FALSE;
+    case 'n':
+      return T_NULL;
+    case ',':
+      return T_LIST_SEPARATOR;
+    case ':':
+      return T_OBJECT_PAIR_SEPARATOR;
+    default:
+      return T_INVALID_TOKEN;
+  }
+}
+
+void JSONValueParser::EatWhitespaceAndComments() {
+  while (index_ < input_.size()) {
+    char c = input_[index_];
+    switch (c) {
+      case '\r':
+      case '\n':
+        index_last_line_ = index_;
+        // Don't increment line_number_ twice for "\r\n".
+        if (!(c == '\n' && index_ > 0 && input_[index_ - 1] == '\r'))
+          ++line_number_;
+        ++index_;
+        break;
+      case ' ':
+      case '\t':
+        ++index_;
+        break;
+      case '/':
+        if (!EatComment())
+          return;
+        break;
+      default:
+        return;
+    }
+  }
+}
+
+bool JSONValueParser::EatComment() {
+  if (index_ + 2 > input_.size())
+    return false;
+  std::string_view comment_start = input_.substr(index_, 2);
+  index_ += 2;
+
+  if (comment_start == "//") {
+    // Single line comment, read to newline.
+    while (index_ < input_.size()) {
+      if (input_[index_] == '\n' || input_[index_] == '\r')
+        return true;
+      ++index_;
+    }
+  } else if (comment_start == "/*") {
+    // Block comment, read until end marker.
+    char previous_char = '\0';
+    while (index_ < input_.size()) {
+      char c = input_[index_++];
+      if (previous_char == '*' && c == '/')
+        return true;
+      previous_char = c;
+    }
+    // If the comment is unterminated, GetNextToken will report T_END_OF_INPUT.
+  }
+  return false;
+}
+
+bool JSONValueParser::ParseToken(Token token, Value* out) {
+  switch (token) {
+    case T_OBJECT_BEGIN:
+      return ConsumeDictionary(out);
+    case T_ARRAY_BEGIN:
+      return ConsumeList(out);
+    case T_STRING: {
+      std::string str;
+      if (!ConsumeString(&str))
+        return false;
+      *out = Value(origin_, std::move(str));
+      return true;
+    }
+    case T_NUMBER:
+      return ConsumeNumber(out);
+    case T_BOOL_TRUE:
+    case T_BOOL_FALSE:
+    case T_NULL:
+      return ConsumeLiteral(out);
+    default:
+      ReportError(base::JSONReader::JSON_UNEXPECTED_TOKEN, 1);
+      return false;
+  }
+}
+
+bool JSONValueParser::ConsumeDictionary(Value* out) {
+  ++index_;  // Opening '{'.
+  if (++stack_depth_ >= base::JSONReader::kStackMaxDepth) {
+    ReportError(base::JSONReader::JSON_TOO_MUCH_NESTING, 0);
+    return false;
+  }
+
+  std::unique_ptr<Scope> scope = std::make_unique<Scope>(settings_);
+  Token token = GetNextToken();
+  while (token != T_OBJECT_END) {
+    if (token != T_STRING) {
+      ReportError(base::JSONReader::JSON_UNQUOTED_DICTIONARY_KEY, 1);
+      return false;
+    }
+
+    std::string key;
+    if (!ConsumeString(&key))
+      return false;
+
+    token = GetNextToken();
+    if (token != T_OBJECT_PAIR_SEPARATOR) {
+      ReportError(base::JSONReader::JSON_SYNTAX_ERROR, 1);
+      return false;
+    }
+    ++index_;
+
+    Value value;
+    if (!ParseToken(GetNextToken(), &value))
+      return false;
+
+    if (key.empty() || !IsIdentifier(key)) {
+      ReportValueError("Invalid identifier \"" + key + "\".");
+    } else {
+      // Scopes don't own their keys, so they are interned.
+      scope->SetValue(StringAtom(key).str(), std::move(value), origin_);
+    }
+
+    token = GetNextToken();
+    if (token == T_LIST_SEPARATOR) {
+      ++index_;
+      token = GetNextToken();
+      if (token == T_OBJECT_END) {
+        ReportError(base::JSONReader::JSON_TRAILING_COMMA, 1);
+        return false;
+      }
+    } else if (token != T_OBJECT_END) {
+      ReportError(base::JSONReader::JSON_SYNTAX_ERROR, 0);
+      return false;
+    }
+  }
+  ++index_;  // Closing '}'.
+  --stack_depth_;
+
+  *out = Value(origin_, std::move(scope));
+  return true;
+}
+
+bool JSONValueParser::ConsumeList(Value* out) {
+  ++index_;  // Opening '['.
+  if (++stack_depth_ >= base::JSONReader::kStackMaxDepth) {
+    ReportError(base::JSONReader::JSON_TOO_MUCH_NESTING, 0);
+    return false;
+  }
+
+  *out = Value(origin_, Value::LIST);
+  std::vector<Value>& list = out->list_value();
+  Token token = GetNextToken();
+  while (token != T_ARRAY_END) {
+    list.emplace_back();
+    if (!ParseToken(token, &list.back()))
+      return false;
+
+    token = GetNextToken();
+    if (token == T_LIST_SEPARATOR) {
+      ++index_;
+      token = GetNextToken();
+      if (token == T_ARRAY_END) {
+        ReportError(base::JSONReader::JSON_TRAILING_COMMA, 1);
+        return false;
+      }
+    } else if (token != T_ARRAY_END) {
+      ReportError(base::JSONReader::JSON_SYNTAX_ERROR, 1);
+      return false;
+    }
+  }
+  ++index_;  // Closing ']'.
+  --stack_depth_;
+  return true;
+}
+
+bool JSONValueParser::ConsumeString(std::string* out) {
+  ++index_;  // Opening '"'.
+
+  // Runs of characters that don't need decoding are copied at once.
+  size_t run_start = index_;
+  while (index_ < input_.size()) {
+    unsigned char c = input_[index_];
+    if (c >= 0x80) {
+      // Only validate multi-byte characters, their encoding is kept.
+      int32_t char_index = static_cast<int32_t>(index_);
+      uint32_t code_point;
+      bool valid = base::ReadUnicodeCharacter(
+                       input_.data(), static_cast<int32_t>(input_.size()),
+                       &char_index, &code_point) &&
+                   base::IsValidCharacter(code_point);
+      index_ = char_index;
+      if (!valid) {
+        ReportError(base::JSONReader::JSON_UNSUPPORTED_ENCODING, 1);
+        return false;
+      }
+      ++index_;
+      continue;
+    }
+    if (c == '"') {
+      out->append(input_.data() + run_start, index_ - run_start);
+      ++index_;
+      return true;
+    }
+    if (c != '\\') {
+      ++index_;
+      continue;
+    }
+
+    out->append(input_.data() + run_start, index_ - run_start);
+    // Read past the escape '\' and ensure there's a character following.
+    if (index_ + 2 > input_.size()) {
+      ReportError(base::JSONReader::JSON_INVALID_ESCAPE, 0);
+      return false;
+    }
+    char escaped = input_[index_ + 1];
+    index_ += 2;
+    switch (escaped) {
+      case 'x': {
+        // UTF-8 \x escape sequences are not allowed in the spec, but
+        // base::JSONReader supports them.
+        if (index_ + 2 > input_.size()) {
+          ReportError(base::JSONReader::JSON_INVALID_ESCAPE, -2);
+          return false;
         }
-        // Search for the key in the input file. We know it's present because
-        // it was parsed by the JSON reader, but we need its location to
-        // construct a std::string_view that can be used as key in the Scope.
-        size_t off = input_file->contents().find("\"" + it.first + "\"");
-        if (off == std::string::npos) {
-          *err = Err(origin, "Invalid encoding \"" + it.first + "\".");
-          return Value();
+        int hex_digit = 0;
+        bool valid =
+            base::HexStringToInt(input_.substr(index_, 2), &hex_digit) &&
+            base::IsValidCharacter(hex_digit);
+        index_ += 2;
+        if (!valid) {
+          ReportError(base::JSONReader::JSON_INVALID_ESCAPE, -2);
+          return false;
         }
-        std::string_view key(&input_file->contents()[off + 1], it.first.size());
-        scope->SetValue(key, std::move(parsed_value), origin);
+        base::WriteUnicodeCharacter(hex_digit, out);
+        break;
       }
-      return Value(origin, std::move(scope));
-    }
-    case base::Value::Type::LIST: {
-      Value result(origin, Value::LIST);
-      result.list_value().reserve(value.GetList().size());
-      for (const auto& val : value.GetList()) {
-        Value parsed_value =
-            ParseJSONValue(settings, val, origin, input_file, err);
-        result.list_value().push_back(parsed_value);
+      case 'u': {
+        uint32_t code_point;
+        if (!DecodeUTF16(&code_point)) {
+          ReportError(base::JSONReader::JSON_INVALID_ESCAPE, 0);
+          return false;
+        }
+        base::WriteUnicodeCharacter(code_point, out);
+        break;
       }
-      return result;
+      case '"':
+      case '\\':
+      case '/':
+        out->push_back(escaped);
+        break;
+      case 'b':
+        out->push_back('\b');
+        break;
+      case 'f':
+        out->push_back('\f');
+        break;
+      case 'n':
+        out->push_back('\n');
+        break;
+      case 'r':
+        out->push_back('\r');
+        break;
+      case 't':
+        out->push_back('\t');
+        break;
+      case 'v':  // Not listed as valid escape sequence in the RFC.
+        out->push_back('\v');
+        break;
+      default:
+        ReportError(base::JSONReader::JSON_INVALID_ESCAPE, 0);
+        return false;
     }
+    run_start = index_;
   }
-  return Value();
+
+  ReportError(base::JSONReader::JSON_SYNTAX_ERROR, 0);
+  return false;
+}
+
+// Entry is at the first X in \uXXXX.
+bool JSONValueParser::DecodeUTF16(uint32_t* out_code_point) {
+  if (index_ + 4 > input_.size())
+    return false;
+
+  // Consume the UTF-16 code unit, which may be a high surrogate.
+  int code_unit16_high = 0;
+  bool valid =
+      base::HexStringToInt(input_.substr(index_, 4), &code_unit16_high);
+  index_ += 4;
+  if (!valid)
+    return false;
+
+  if (!CBU16_IS_SURROGATE(code_unit16_high)) {
+    if (!base::IsValidCharacter(code_unit16_high))
+      return false;
+    *out_code_point = code_unit16_high;
+    return true;
+  }
+
+  // A high surrogate must be followed by a low surrogate.
+  if (!CBU16_IS_SURROGATE_LEAD(code_unit16_high) || !ConsumeIfMatch("\\u") ||
+      index_ + 4 > input_.size())
+    return false;
+
+  int code_unit16_low = 0;
+  valid = base::HexStringToInt(input_.substr(index_, 4), &code_unit16_low);
+  index_ += 4;
+  if (!valid || !CBU16_IS_TRAIL(code_unit16_low))
+    return false;
+
+  uint32_t code_point =
+      CBU16_GET_SUPPLEMENTARY(code_unit16_high, code_unit16_low);
+  if (!base::IsValidCharacter(code_point))
+    return false;
+  *out_code_point = code_point;
+  return true;
+}
+
+bool JSONValueParser::ConsumeNumber(Value* out) {
+  size_t start_index = index_;
+  if (PeekChar() == '-')
+    ++index_;
+
+  if (!ReadInt(false)) {
+    ReportError(base::JSONReader::JSON_SYNTAX_ERROR, 1);
+    return false;
+  }
+  size_t end_index = index_;
+
+  // The optional fraction part.
+  if (PeekChar() == '.') {
+    ++index_;
+    if (!ReadInt(true)) {
+      ReportError(base::JSONReader::JSON_SYNTAX_ERROR, 1);
+      return false;
+    }
+    end_index = index_;
+  }
+
+  // Optional exponent part.
+  if (PeekChar() == 'e' || PeekChar() == 'E') {
+    ++index_;
+    if (PeekChar() == '-' || PeekChar() == '+')
+      ++index_;
+    if (!ReadInt(true)) {
+      ReportError(base::JSONReader::JSON_SYNTAX_ERROR, 1);
+      return false;
+    }
+    end_index = index_;
+  }
+
+  // Numbers have no sentinel, so make sure the next token is one which is
+  // valid after a number, then come back.
+  size_t exit_index = index_;
+  int exit_line_number = line_number_;
+  size_t exit_index_last_line = index_last_line_;
+  switch (GetNextToken()) {
+    case T_OBJECT_END:
+    case T_ARRAY_END:
+    case T_LIST_SEPARATOR:
+    case T_END_OF_INPUT:
+      break;
+    default:
+      ReportError(base::JSONReader::JSON_SYNTAX_ERROR, 1);
+      return false;
+  }
+  index_ = exit_index;
+  line_number_ = exit_line_number;
+  index_last_line_ = exit_index_last_line;
+
+  // Like base::Value, only 32-bit integers are supported, and anything else
+  // fails without a message.
+  int num_int;
+  if (!base::StringToInt(
+          input_.substr(start_index, end_index - start_index), &num_int))
+    return false;
+  *out = Value(origin_, static_cast<int64_t>(num_int));
+  return true;
+}
+
+bool JSONValueParser::ReadInt(bool allow_leading_zeros) {
+  size_t start = index_;
+  while (index_ < input_.size() && base::IsAsciiDigit(input_[index_]))
+    ++index_;
+
+  size_t len = index_ - start;
+  if (len == 0)
+    return false;
+  return allow_leading_zeros || len == 1 || input_[start] != '0';
+}
+
+bool JSONValueParser::ConsumeLiteral(Value* out) {
+  if (ConsumeIfMatch("true")) {
+    *out = Value(origin_, true);
+  } else if (ConsumeIfMatch("false")) {
+    *out = Value(origin_, false);
+  } else if (ConsumeIfMatch("null")) {
+    ReportValueError("Null values are not supported.");
+  } else {
+    ReportError(base::JSONReader::JSON_SYNTAX_ERROR, 1);
+    return false;
+  }
+  return true;
+}
+
+bool JSONValueParser::ConsumeIfMatch(std::string_view match) {
+  if (input_.substr(index_, match.size()) != match)
+    return false;
+  index_ += match.size();
+  return true;
+}
+
+void JSONValueParser::ReportError(base::JSONReader::JsonParseError code,
+                                  int column_adjust) {
+  error_code_ = code;
+  error_line_ = line_number_;
+  error_column_ = static_cast<int>(index_ - index_last_line_) + column_adjust;
+}
+
+void JSONValueParser::ReportValueError(const std::string& message) {
+  if (!value_err_.has_error())
+    value_err_ = Err(origin_, message);
 }
 
 // Parses the JSON string and converts it to GN value.
 Value ParseJSON(const Settings* settings,
-                const std::string& input,
+                std::string_view input,
                 const ParseNode* origin,
                 Err* err) {
-  InputFile* input_file;
-  std::vector<Token>* tokens;
-  std::unique_ptr<ParseNode>* parse_root_ptr;
-  g_scheduler->input_file_manager()->AddDynamicInput(SourceFile(), &input_file,
-                                                     &tokens, &parse_root_ptr);
-  input_file->SetContents(input);
-
-  int error_code_out;
-  std::string error_msg_out;
-  std::unique_ptr<base::Value> value = base::JSONReader::ReadAndReturnError(
-      input, base::JSONParserOptions::JSON_PARSE_RFC, &error_code_out,
-      &error_msg_out);
-  if (!value) {
-    *err = Err(origin, "Input is not a valid JSON: " + error_msg_out);
-    return Value();
-  }
-
-  return ParseJSONValue(settings, *value, origin, input_file, err);
+  return JSONValueParser(settings, input, origin).Parse(err);
 }
 
 // Backend for ConvertInputToValue, this takes the extracted string for the
@@ -201,7 +701,7 @@ Value ParseJSON(const Settings* settings,
 // "trim" prefix. This original value is also kept for the purposes of throwing
 // errors.
 Value DoConvertInputToValue(const Settings* settings,
-                            const std::string& input,
+                            std::string_view input,
                             const ParseNode* origin,
                             const Value& original_input_conversion,
                             const std::string& input_conversion,
@@ -212,8 +712,8 @@ Value DoConvertInputToValue(const Settings* settings,
   const char kTrimPrefix[] = "trim ";
   if (base::StartsWith(input_conversion, kTrimPrefix,
                        base::CompareCase::SENSITIVE)) {
-    std::string trimmed;
-    base::TrimWhitespaceASCII(input, base::TRIM_ALL, &trimmed);
+    std::string_view trimmed =
+        base::TrimWhitespaceASCII(input, base::TRIM_ALL);
 
     // Remove "trim" prefix from the input conversion and re-run.
     return DoConvertInputToValue(
@@ -224,7 +724,7 @@ Value DoConvertInputToValue(const Settings* settings,
   if (input_conversion == "value")
     return ParseValueOrScope(settings, input, PARSE_VALUE, origin, err);
   if (input_conversion == "string")
-    return Value(origin, input);
+    return Value(origin, std::string(input));
   if (input_conversion == "list lines")
     return ParseList(input, origin, err);
   if (input_conversion == "scope")
@@ -345,7 +845,7 @@ const char kInputOutputConversion_Help[] =
 )";
 
 Value ConvertInputToValue(const Settings* settings,
-                          const std::string& input,
+                          std::string_view input,
                           const ParseNode* origin,
                           const Value& input_conversion_value,
                           Err* err) {
@@ -225,6 +225,50 @@ TEST_F(InputConversionTest, ValueJSONUnsupported) {
   EXPECT_EQ("Input is not a valid JSON: ", err.message());
 }
 
+TEST_F(InputConversionTest, ValueJSONSyntax) {
+  Err err;
+  std::string input(
+      "\xEF\xBB\xBF"
+      R"*({
+  // Comments are allowed.
+  "a": [ "\"\\\/\b\f\n\r\t\v\x41é😀", "é" ],
+  /* Later keys replace earlier ones. */
+  "b": 1,
+  "b": -2
+})*");
+  Value result = ConvertInputToValue(settings(), input, nullptr,
+                                     Value(nullptr, "json"), &err);
+  EXPECT_FALSE(err.has_error());
+  ASSERT_EQ(Value::SCOPE, result.type());
+
+  const Value* a_value = result.scope_value()->GetValue("a");
+  ASSERT_TRUE(a_value);
+  ASSERT_EQ(Value::LIST, a_value->type());
+  ASSERT_EQ(2u, a_value->list_value().size());
+  EXPECT_EQ("\"\\/\b\f\n\r\t\vA\xC3\xA9\xF0\x9F\x98\x80",
+            a_value->list_value()[0].string_value());
+  EXPECT_EQ("\xC3\xA9", a_value->list_value()[1].string_value());
+
+  const Value* b_value = result.scope_value()->GetValue("b");
+  ASSERT_TRUE(b_value);
+  EXPECT_EQ(-2, b_value->int_value());
+}
+
+TEST_F(InputConversionTest, ValueJSONErrorPrecedence) {
+  // Syntax errors are reported before unsupported values, wherever they are.
+  Err err;
+  ConvertInputToValue(settings(), "[ null, 1,\n  2 3 ]", nullptr,
+                      Value(nullptr, "json"), &err);
+  EXPECT_EQ("Input is not a valid JSON: Line: 2, column: 6, Syntax error.",
+            err.message());
+
+  // Otherwise the first one is reported.
+  err = Err();
+  ConvertInputToValue(settings(), R"*({ "a b": 1, "c": null })*", nullptr,
+                      Value(nullptr, "json"), &err);
+  EXPECT_EQ("Invalid identifier \"a b\".", err.message());
+}
+
 TEST_F(InputConversionTest, ValueEmpty) {
   Err err;
   Value result = ConvertInputToValue(settings(), "", nullptr,
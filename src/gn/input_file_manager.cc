@@ -4,11 +4,13 @@
 
 #include "gn/input_file_manager.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
 #include "base/stl_util.h"
 #include "gn/filesystem_utils.h"
+#include "gn/parse_node_arena.h"
 #include "gn/parser.h"
 #include "gn/scheduler.h"
 #include "gn/scope_per_file_provider.h"
@@ -34,14 +36,13 @@ void InvokeFileLoadCallback(const InputFileManager::FileLoadCallback& cb,
   cb(node);
 }
 
-bool DoLoadFile(const LocationRange& origin,
-                const BuildSettings* build_settings,
-                const SourceFile& name,
-                InputFileManager::SyncLoadFileCallback load_file_callback,
-                InputFile* file,
-                std::vector<Token>* tokens,
-                std::unique_ptr<ParseNode>* root,
-                Err* err) {
+// Reads the file into |file|. On error, sets the Err and return false.
+bool ReadInputFile(const LocationRange& origin,
+                   const BuildSettings* build_settings,
+                   const SourceFile& name,
+                   InputFileManager::SyncLoadFileCallback load_file_callback,
+                   InputFile* file,
+                   Err* err) {
   // Do all of this stuff outside the lock. We should not give out file
   // pointers until the read is complete.
   if (g_scheduler->verbose_logging()) {
@@ -79,17 +80,37 @@ bool DoLoadFile(const LocationRange& origin,
       return false;
     }
   }
-  load_trace.Done();
+  return true;
+}
 
+// Tokenizes and parses a file that was read, allocating the tree from
+// |arena|. On error, sets the Err and return false.
+bool ParseInputFile(const SourceFile& name,
+                    const InputFile* file,
+                    ParseNodeArena* arena,
+                    std::unique_ptr<ParseNode>* root,
+                    Err* err) {
   ScopedTrace exec_trace(TraceItem::TRACE_FILE_PARSE, name.value());
 
   // Tokenize.
-  *tokens = Tokenizer::Tokenize(file, err);
+  std::vector<Token> tokens = Tokenizer::Tokenize(file, err);
   if (err->has_error())
     return false;
 
+  // Comments are only needed for formatting. Without them, the parser doesn't
+  // attach comment blocks to the nodes. The nodes keep copies of their
+  // tokens, so the vector isn't needed after parsing either.
+  tokens.erase(std::remove_if(tokens.begin(), tokens.end(),
+                              [](const Token& token) {
+                                return token.type() == Token::LINE_COMMENT ||
+                                       token.type() == Token::SUFFIX_COMMENT ||
+                                       token.type() == Token::BLOCK_COMMENT;
+                              }),
+               tokens.end());
+
   // Parse.
-  *root = Parser::Parse(*tokens, err);
+  ScopedParseNodeArena scoped_arena(arena);
+  *root = Parser::Parse(tokens, err);
   if (err->has_error())
     return false;
 
@@ -119,6 +140,7 @@ bool InputFileManager::AsyncLoadFile(const LocationRange& origin,
   // want to schedule should return early. Otherwise, this will be scheduled
   // after we leave the lock.
   std::function<void()> schedule_this;
+  bool blocking = false;
   {
     std::lock_guard<std::mutex> lock(lock_);
 
@@ -132,6 +154,7 @@ bool InputFileManager::AsyncLoadFile(const LocationRange& origin,
                        file = &data->file]() {
         BackgroundLoadFile(origin, build_settings, file_name, file);
       };
+      blocking = true;
       input_files_[file_name] = std::move(data);
 
     } else {
@@ -164,7 +187,10 @@ bool InputFileManager::AsyncLoadFile(const LocationRange& origin,
       }
     }
   }
-  g_scheduler->ScheduleWork(std::move(schedule_this));
+  if (blocking)
+    g_scheduler->ScheduleBlockingWork(std::move(schedule_this));
+  else
+    g_scheduler->ScheduleWork(std::move(schedule_this));
   return true;
 }
 
@@ -278,9 +304,22 @@ void InputFileManager::BackgroundLoadFile(const LocationRange& origin,
                                           const BuildSettings* build_settings,
                                           const SourceFile& name,
                                           InputFile* file) {
+  // This runs on the I/O lane of the worker pool. Only the read happens here:
+  // parsing the file and running the callbacks, which execute it, are
+  // scheduled as CPU-bound work so they can't be held up by other reads.
   Err err;
-  if (!LoadFile(origin, build_settings, name, file, &err))
+  if (!ReadInputFile(origin, build_settings, name, load_file_callback_, file,
+                     &err)) {
+    FinishLoadFile(name, file, false, &err);
     g_scheduler->FailWithError(err);
+    return;
+  }
+
+  g_scheduler->ScheduleWork([this, name, file]() {
+    Err err;
+    if (!FinishLoadFile(name, file, true, &err))
+      g_scheduler->FailWithError(err);
+  });
 }
 
 bool InputFileManager::LoadFile(const LocationRange& origin,
@@ -288,10 +327,19 @@ bool InputFileManager::LoadFile(const LocationRange& origin,
                                 const SourceFile& name,
                                 InputFile* file,
                                 Err* err) {
-  std::vector<Token> tokens;
+  bool read = ReadInputFile(origin, build_settings, name, load_file_callback_,
+                            file, err);
+  return FinishLoadFile(name, file, read, err);
+}
+
+bool InputFileManager::FinishLoadFile(const SourceFile& name,
+                                      InputFile* file,
+                                      bool read,
+                                      Err* err) {
+  // Must outlive |root|.
+  std::unique_ptr<ParseNodeArena> arena = std::make_unique<ParseNodeArena>();
   std::unique_ptr<ParseNode> root;
-  bool success =
-      DoLoadFile(origin, build_settings, name, load_file_callback_, file, &tokens, &root, err);
+  bool success = read && ParseInputFile(name, file, arena.get(), &root, err);
   // Can't return early. We have to ensure that the completion event is
   // signaled in all cases because another thread could be blocked on this one.
 
@@ -307,7 +355,7 @@ bool InputFileManager::LoadFile(const LocationRange& origin,
     InputFileData* data = input_files_[name].get();
     data->loaded = true;
     if (success) {
-      data->tokens = std::move(tokens);
+      data->arena = std::move(arena);
       data->parsed_root = std::move(root);
     } else {
       data->parse_error = *err;
@@ -24,6 +24,7 @@ class BuildSettings;
 class Err;
 class LocationRange;
 class ParseNode;
+class ParseNodeArena;
 class Token;
 
 // Manages loading and parsing files from disk. This doesn't actually have
@@ -129,8 +130,13 @@ class InputFileManager : public base::RefCountedThreadSafe<InputFileManager> {
     // only happens for imports).
     std::unique_ptr<AutoResetEvent> completion_event;
 
+    // Only used by dynamic inputs. The tokens of loaded files are dropped
+    // after parsing.
     std::vector<Token> tokens;
 
+    // Holds the nodes of |parsed_root|, so must be declared before it.
+    std::unique_ptr<ParseNodeArena> arena;
+
     // Null before the file is loaded or if loading failed.
     std::unique_ptr<ParseNode> parsed_root;
     Err parse_error;
@@ -150,6 +156,13 @@ class InputFileManager : public base::RefCountedThreadSafe<InputFileManager> {
                 InputFile* file,
                 Err* err);
 
+  // Parses the given file if it was |read|, records the result and runs the
+  // callbacks waiting for it. On error, sets the Err and return false.
+  bool FinishLoadFile(const SourceFile& name,
+                      InputFile* file,
+                      bool read,
+                      Err* err);
+
   mutable std::mutex lock_;
 
   // Maps repo-relative filenames to the corresponding owned pointer.
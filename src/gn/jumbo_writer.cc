@@ -6,12 +6,12 @@
 
 #include <sstream>
 
-#include "base/files/file_util.h"
 #include "gn/build_settings.h"
 #include "gn/filesystem_utils.h"
 #include "gn/scheduler.h"
 #include "gn/settings.h"
 #include "gn/string_output_buffer.h"
+#include "gn/trace.h"
 
 JumboWriter::JumboWriter(const Target* target)
     : target_(target),
@@ -30,7 +30,10 @@ void JumboWriter::Run() const {
   if (target_->jumbo_files().empty())
     return;
 
-  base::CreateDirectory(target_->settings()
+  ScopedTrace trace(TraceItem::TRACE_JUMBO_WRITE, target_->label());
+  trace.SetToolchain(target_->settings()->toolchain_label());
+
+  CreateDirectoryCached(target_->settings()
                             ->build_settings()
                             ->GetFullPath(target_->jumbo_files()[0].first)
                             .DirName());
@@ -44,14 +47,13 @@ void JumboWriter::Run() const {
 bool JumboWriter::WriteJumboFile(
     const Target::JumboSourceFile& jumbo_file) const {
   StringOutputBuffer storage;
-  std::ostream content(&storage);
-  content << "/* This is a Jumbo file. Don't edit. "
+  storage << "/* This is a Jumbo file. Don't edit. "
           << "Generated with 'gn gen' command. */\n\n";
 
   for (const SourceFile* source_file : jumbo_file.second) {
-    content << "#include \"";
-    path_output_.WriteFile(content, *source_file);
-    content << "\"\n";
+    storage << "#include \"";
+    path_output_.WriteFile(storage, *source_file);
+    storage << "\"\n";
   }
 
   Err err;
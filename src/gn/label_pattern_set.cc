@@ -0,0 +1,135 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/label_pattern_set.h"
+
+#include <algorithm>
+
+namespace {
+
+// Splits a directory into its components, each including its trailing slash,
+// so that "//foo/bar/" gives "/", "/", "foo/" and "bar/". A directory is then
+// a string prefix of another exactly when its components are a prefix of the
+// other's components. Returns the component starting at |*pos| and advances
+// it, or returns an empty string at the end.
+std::string_view NextComponent(std::string_view dir, size_t* pos) {
+  size_t begin = *pos;
+  size_t slash = dir.find('/', begin);
+  *pos = slash == std::string_view::npos ? dir.size() : slash + 1;
+  return dir.substr(begin, *pos - begin);
+}
+
+}  // namespace
+
+LabelPatternSet::LabelPatternSet() : nodes_(1) {}
+
+LabelPatternSet::LabelPatternSet(std::vector<LabelPattern> patterns)
+    : patterns_(std::move(patterns)), nodes_(1) {
+  for (size_t i = 0; i < patterns_.size(); i++) {
+    const LabelPattern& pattern = patterns_[i];
+    std::string_view dir = pattern.dir().value();
+    if (!dir.empty() && dir.back() != '/') {
+      unindexed_.push_back(static_cast<int>(i));
+      continue;
+    }
+
+    size_t node = 0;
+    size_t pos = 0;
+    while (pos < dir.size()) {
+      std::string_view component = NextComponent(dir, &pos);
+      size_t child = FindChild(node, component);
+      if (!child) {
+        child = nodes_.size();
+        nodes_.emplace_back();
+        auto& children = nodes_[node].children;
+        children.insert(
+            std::lower_bound(children.begin(), children.end(),
+                             std::make_pair(component, size_t(0))),
+            std::make_pair(component, child));
+      }
+      node = child;
+    }
+
+    if (pattern.type() == LabelPattern::RECURSIVE_DIRECTORY)
+      nodes_[node].recursive.push_back(static_cast<int>(i));
+    else
+      nodes_[node].directory.push_back(static_cast<int>(i));
+  }
+}
+
+LabelPatternSet::LabelPatternSet(const LabelPatternSet&) = default;
+LabelPatternSet::LabelPatternSet(LabelPatternSet&&) = default;
+LabelPatternSet::~LabelPatternSet() = default;
+
+LabelPatternSet& LabelPatternSet::operator=(const LabelPatternSet&) = default;
+LabelPatternSet& LabelPatternSet::operator=(LabelPatternSet&&) = default;
+
+bool LabelPatternSet::Matches(const Label& label) const {
+  return Find(label, false) >= 0;
+}
+
+int LabelPatternSet::FirstMatch(const Label& label) const {
+  return Find(label, true);
+}
+
+size_t LabelPatternSet::FindChild(size_t node,
+                                  std::string_view component) const {
+  const auto& children = nodes_[node].children;
+  auto found = std::lower_bound(
+      children.begin(), children.end(), component,
+      [](const std::pair<std::string_view, size_t>& child,
+         std::string_view value) { return child.first < value; });
+  if (found == children.end() || found->first != component)
+    return 0;
+  return found->second;
+}
+
+bool LabelPatternSet::MatchesExceptDir(int index, const Label& label) const {
+  const LabelPattern& pattern = patterns_[index];
+  if (!pattern.toolchain().is_null() &&
+      (pattern.toolchain().dir() != label.toolchain_dir() ||
+       pattern.toolchain().name() != label.toolchain_name()))
+    return false;
+  return pattern.type() != LabelPattern::MATCH ||
+         pattern.name() == label.name();
+}
+
+int LabelPatternSet::Find(const Label& label, bool lowest_index) const {
+  int result = -1;
+  auto check = [this, &label, &result](const std::vector<int>& indices) {
+    for (int index : indices) {
+      if ((result < 0 || index < result) && MatchesExceptDir(index, label)) {
+        // Indices are increasing within a node.
+        result = index;
+        return;
+      }
+    }
+  };
+
+  for (int index : unindexed_) {
+    if (patterns_[index].Matches(label)) {
+      result = index;
+      break;
+    }
+  }
+  if (result >= 0 && !lowest_index)
+    return result;
+
+  // Recursive patterns match along the path, the others only at the end.
+  std::string_view dir = label.dir().value();
+  size_t node = 0;
+  size_t pos = 0;
+  for (;;) {
+    check(nodes_[node].recursive);
+    if (result >= 0 && !lowest_index)
+      return result;
+    if (pos == dir.size())
+      break;
+    node = FindChild(node, NextComponent(dir, &pos));
+    if (!node)
+      return result;
+  }
+  check(nodes_[node].directory);
+  return result;
+}
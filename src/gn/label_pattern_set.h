@@ -0,0 +1,81 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TOOLS_GN_LABEL_PATTERN_SET_H_
+#define TOOLS_GN_LABEL_PATTERN_SET_H_
+
+#include <stddef.h>
+
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "gn/label_pattern.h"
+
+// A list of label patterns compiled for matching many labels against it.
+//
+// The patterns are indexed in a trie of directory components, so matching a
+// label only looks at the patterns for the directories along its path instead
+// of comparing it against every pattern. This is used where the same list is
+// checked a large number of times, such as visibility for every dependency
+// edge or filters for every target.
+class LabelPatternSet {
+ public:
+  LabelPatternSet();
+  explicit LabelPatternSet(std::vector<LabelPattern> patterns);
+  LabelPatternSet(const LabelPatternSet&);
+  LabelPatternSet(LabelPatternSet&&);
+  ~LabelPatternSet();
+
+  LabelPatternSet& operator=(const LabelPatternSet&);
+  LabelPatternSet& operator=(LabelPatternSet&&);
+
+  const std::vector<LabelPattern>& patterns() const { return patterns_; }
+  bool empty() const { return patterns_.empty(); }
+
+  // Returns true if any of the patterns matches the label. This is equivalent
+  // to LabelPattern::VectorMatches() on patterns().
+  bool Matches(const Label& label) const;
+
+  // Returns the index in patterns() of the first pattern matching the label,
+  // or -1 if none matches.
+  int FirstMatch(const Label& label) const;
+
+ private:
+  struct Node {
+    // Child directories, sorted by path component. Components include their
+    // trailing slash and point into the interned directory of a pattern.
+    std::vector<std::pair<std::string_view, size_t>> children;
+
+    // Indices of the RECURSIVE_DIRECTORY patterns for this directory.
+    std::vector<int> recursive;
+
+    // Indices of the DIRECTORY and MATCH patterns for this directory.
+    std::vector<int> directory;
+  };
+
+  // Returns the index of the child of the given node for |component|, or 0 if
+  // there is none (the root is never a child).
+  size_t FindChild(size_t node, std::string_view component) const;
+
+  // Returns whether the toolchain and name of the label match the pattern
+  // with the given index. Its directory is expected to match.
+  bool MatchesExceptDir(int index, const Label& label) const;
+
+  // Returns the index of a pattern matching the label, or -1. With
+  // |lowest_index| this is the first matching pattern of the list, otherwise
+  // it is whichever is found first.
+  int Find(const Label& label, bool lowest_index) const;
+
+  std::vector<LabelPattern> patterns_;
+
+  // The trie, nodes_[0] being the root (the empty directory).
+  std::vector<Node> nodes_;
+
+  // Patterns whose directory doesn't end in a slash, which are matched one
+  // by one.
+  std::vector<int> unindexed_;
+};
+
+#endif  // TOOLS_GN_LABEL_PATTERN_SET_H_
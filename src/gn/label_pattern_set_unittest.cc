@@ -0,0 +1,80 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/label_pattern_set.h"
+
+#include <string>
+#include <vector>
+
+#include "util/test/test.h"
+
+namespace {
+
+LabelPattern Pattern(LabelPattern::Type type,
+                     const char* dir,
+                     const char* name = "",
+                     const Label& toolchain = Label()) {
+  return LabelPattern(type, SourceDir(dir), name, toolchain);
+}
+
+}  // namespace
+
+TEST(LabelPatternSet, Empty) {
+  LabelPatternSet set;
+  EXPECT_TRUE(set.empty());
+  EXPECT_FALSE(set.Matches(Label(SourceDir("//foo/"), "bar")));
+  EXPECT_EQ(-1, set.FirstMatch(Label(SourceDir("//foo/"), "bar")));
+}
+
+// Compares the set against matching every pattern one by one.
+TEST(LabelPatternSet, MatchesLikeVector) {
+  Label other_toolchain(SourceDir("//tc/"), "other");
+  std::vector<LabelPattern> patterns = {
+      Pattern(LabelPattern::MATCH, "//foo/bar/", "baz"),
+      Pattern(LabelPattern::DIRECTORY, "//foo/"),
+      Pattern(LabelPattern::RECURSIVE_DIRECTORY, "//foo/bar/"),
+      Pattern(LabelPattern::RECURSIVE_DIRECTORY, "//lib/", "", other_toolchain),
+      Pattern(LabelPattern::MATCH, "//", "root"),
+      Pattern(LabelPattern::RECURSIVE_DIRECTORY, "/abs/"),
+      Pattern(LabelPattern::DIRECTORY, "//foo/bar/"),
+  };
+  LabelPatternSet set(patterns);
+  ASSERT_EQ(patterns.size(), set.patterns().size());
+
+  Label default_toolchain(SourceDir("//tc/"), "default");
+  std::vector<Label> labels;
+  for (const char* dir :
+       {"//", "//foo/", "//foobar/", "//foo/bar/", "//foo/bar/x/", "//foo/ba/",
+        "//lib/", "//lib/sub/", "/abs/", "/abs/x/", "/", "//other/"}) {
+    for (const char* name : {"baz", "root", "other"}) {
+      for (const Label& toolchain : {default_toolchain, other_toolchain}) {
+        labels.push_back(Label(SourceDir(dir), name, toolchain.dir(),
+                               toolchain.name()));
+      }
+    }
+  }
+
+  for (const Label& label : labels) {
+    int expected = -1;
+    for (size_t i = 0; i < patterns.size(); i++) {
+      if (patterns[i].Matches(label)) {
+        expected = static_cast<int>(i);
+        break;
+      }
+    }
+    EXPECT_EQ(expected, set.FirstMatch(label))
+        << label.GetUserVisibleName(true);
+    EXPECT_EQ(LabelPattern::VectorMatches(patterns, label), set.Matches(label))
+        << label.GetUserVisibleName(true);
+  }
+}
+
+TEST(LabelPatternSet, Public) {
+  // An empty recursive directory matches everything.
+  LabelPatternSet set(
+      {Pattern(LabelPattern::RECURSIVE_DIRECTORY, "")});
+  EXPECT_TRUE(set.Matches(Label(SourceDir("//foo/"), "bar")));
+  EXPECT_TRUE(set.Matches(Label(SourceDir("/abs/"), "bar")));
+  EXPECT_EQ(0, set.FirstMatch(Label(SourceDir("//"), "bar")));
+}
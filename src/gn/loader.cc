@@ -5,10 +5,12 @@
 #include "gn/loader.h"
 
 #include <memory>
+#include <vector>
 
 #include "gn/build_settings.h"
 #include "gn/err.h"
 #include "gn/filesystem_utils.h"
+#include "gn/import_manager.h"
 #include "gn/input_file_manager.h"
 #include "gn/parse_tree.h"
 #include "gn/scheduler.h"
@@ -73,6 +75,26 @@ struct LoaderImpl::ToolchainRecord {
   std::vector<SourceFileAndOrigin> waiting_on_me;
 };
 
+// The build config of the non-default toolchains with the same arguments.
+//
+// These toolchains usually end up with the same build config, so the first one
+// executes the build config file with a BuildConfigProbe and, unless the result
+// depends on the toolchain, the others copy it.
+struct LoaderImpl::BuildConfigRecord {
+  // Held while the first toolchain executes the build config file.
+  std::mutex lock;
+
+  // Set once the first toolchain executed the build config file.
+  bool executed = false;
+
+  // The settings of the toolchain whose build config can be copied, or null
+  // if the build config depends on the toolchain or failed.
+  const Settings* source = nullptr;
+
+  // The files imported by the build config of |source|.
+  std::vector<SourceFile> imports;
+};
+
 // -----------------------------------------------------------------------------
 
 const void* const Loader::kDefaultToolchainKey = &kDefaultToolchainKey;
@@ -207,6 +229,7 @@ void LoaderImpl::ScheduleLoadFile(const Settings* settings,
                                   const SourceFile& file) {
   Err err;
   pending_loads_++;
+  AddTraceCounter(TraceCounter::kPendingLoads, pending_loads_);
   if (!AsyncLoadFile(
           origin, settings->build_settings(), file,
           [this, settings, file, origin](const ParseNode* parse_node) {
@@ -223,6 +246,7 @@ void LoaderImpl::ScheduleLoadBuildConfig(
     const Scope::KeyValueMap& toolchain_overrides) {
   Err err;
   pending_loads_++;
+  AddTraceCounter(TraceCounter::kPendingLoads, pending_loads_);
   if (!AsyncLoadFile(
           LocationRange(), settings->build_settings(),
           settings->build_settings()->build_config_file(),
@@ -303,6 +327,29 @@ void LoaderImpl::BackgroundLoadBuildConfig(
   settings->build_settings()->build_args().SetupRootScope(base_config,
                                                           toolchain_overrides);
 
+  BuildConfigRecord* record = nullptr;
+  std::unique_lock<std::mutex> record_lock;
+  if (!settings->is_default()) {
+    record = GetBuildConfigRecord(toolchain_overrides);
+    record_lock = std::unique_lock<std::mutex>(record->lock);
+    if (record->source) {
+      CopyBuildConfig(*record, settings);
+      task_runner_->PostTask(
+          [this, toolchain_label = settings->toolchain_label()]() {
+            DidLoadBuildConfig(toolchain_label);
+          });
+      return;
+    }
+    if (record->executed) {
+      // Executed by another toolchain and not reusable.
+      record = nullptr;
+      record_lock.unlock();
+    }
+  }
+  std::unique_ptr<BuildConfigProbe> probe;
+  if (record)
+    probe = std::make_unique<BuildConfigProbe>();
+
   base_config->SetProcessingBuildConfig();
 
   // See kDefaultToolchainKey in the header.
@@ -332,6 +379,15 @@ void LoaderImpl::BackgroundLoadBuildConfig(
   // underscore aren't exported.
   base_config->RemovePrivateIdentifiers();
 
+  if (record) {
+    record->executed = true;
+    if (!err.has_error() && !probe->depends_on_toolchain()) {
+      record->source = settings;
+      record->imports = settings->import_manager().GetImportedFiles();
+    }
+    probe.reset();
+  }
+
   trace.Done();
 
   if (err.has_error()) {
@@ -363,6 +419,41 @@ void LoaderImpl::BackgroundLoadBuildConfig(
       });
 }
 
+LoaderImpl::BuildConfigRecord* LoaderImpl::GetBuildConfigRecord(
+    const Scope::KeyValueMap& toolchain_overrides) {
+  std::string fingerprint;
+  for (const auto& pair : toolchain_overrides) {
+    fingerprint.append(pair.first);
+    fingerprint.push_back('=');
+    fingerprint.append(pair.second.ToString(true));
+    fingerprint.push_back('\n');
+  }
+
+  std::lock_guard<std::mutex> lock(build_config_records_lock_);
+  std::unique_ptr<BuildConfigRecord>& record =
+      build_config_records_[fingerprint];
+  if (!record)
+    record = std::make_unique<BuildConfigRecord>();
+  return record.get();
+}
+
+void LoaderImpl::CopyBuildConfig(const BuildConfigRecord& record,
+                                 Settings* settings) {
+  ScopedTrace trace(TraceItem::TRACE_FILE_EXECUTE,
+                    settings->build_settings()->build_config_file().value());
+  trace.SetToolchain(settings->toolchain_label());
+
+  // The build config of |record.source| is complete and won't change anymore.
+  const Scope* source_config = record.source->base_config();
+  Scope* base_config = settings->base_config();
+  ToolchainScopeCopier copier(record.source, settings);
+  copier.CopyTo(source_config, base_config);
+  settings->import_manager().CopyImportsFrom(
+      &record.source->import_manager(), record.imports, &copier);
+  settings->build_settings()->build_args().CopyDeclaredArgs(source_config,
+                                                            base_config);
+}
+
 void LoaderImpl::DidLoadFile() {
   DecrementPendingLoads();
 }
@@ -430,6 +521,7 @@ void LoaderImpl::DidLoadBuildConfig(const Label& label) {
 void LoaderImpl::DecrementPendingLoads() {
   DCHECK_GT(pending_loads_, 0);
   pending_loads_--;
+  AddTraceCounter(TraceCounter::kPendingLoads, pending_loads_);
   if (pending_loads_ == 0 && complete_callback_)
     complete_callback_();
 }
@@ -8,7 +8,9 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
+#include <string>
 
 #include "base/memory/ref_counted.h"
 #include "gn/label.h"
@@ -117,6 +119,7 @@ class LoaderImpl : public Loader {
   }
 
  private:
+  struct BuildConfigRecord;
   struct LoadID;
   struct ToolchainRecord;
 
@@ -139,6 +142,15 @@ class LoaderImpl : public Loader {
                                  const Scope::KeyValueMap& toolchain_overrides,
                                  const ParseNode* root);
 
+  // Returns the record of the build config for the toolchains other than the
+  // default one with the given arguments. Thread-safe.
+  BuildConfigRecord* GetBuildConfigRecord(
+      const Scope::KeyValueMap& toolchain_overrides);
+
+  // Makes the build config of |settings| a copy of the one in |record|,
+  // instead of executing the build config file.
+  void CopyBuildConfig(const BuildConfigRecord& record, Settings* settings);
+
   // Posted to the main thread when any file other than a build config file
   // file has completed running.
   void DidLoadFile();
@@ -182,6 +194,12 @@ class LoaderImpl : public Loader {
   ToolchainRecordMap toolchain_records_;
 
   std::string build_file_extension_;
+
+  // Records for the build configs of the non-default toolchains, indexed by
+  // a fingerprint of their arguments. Accessed from the background threads.
+  std::mutex build_config_records_lock_;
+  std::map<std::string, std::unique_ptr<BuildConfigRecord>>
+      build_config_records_;
 };
 
 #endif  // TOOLS_GN_LOADER_H_
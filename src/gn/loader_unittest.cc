@@ -2,18 +2,22 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <functional>
 #include <map>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "gn/build_settings.h"
 #include "gn/err.h"
 #include "gn/loader.h"
 #include "gn/parse_tree.h"
 #include "gn/parser.h"
 #include "gn/scheduler.h"
+#include "gn/template.h"
 #include "gn/test_with_scheduler.h"
 #include "gn/tokenizer.h"
 #include "util/msg_loop.h"
@@ -391,3 +395,123 @@ TEST_F(LoaderTest, NonDefaultBuildFileName) {
 
   EXPECT_FALSE(scheduler().is_failed());
 }
+
+TEST_F(LoaderTest, BuildConfigSharedBySameArgs) {
+  // The build config reads a file, which records it as a dependency of the
+  // build each time the build config is executed.
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  build_settings_.SetRootPath(temp_dir.GetPath());
+  base::FilePath data_path = temp_dir.GetPath().AppendASCII("data.txt");
+  ASSERT_EQ(4, base::WriteFile(data_path, "data", 4));
+  auto count_executions = [&data_path]() {
+    std::vector<base::FilePath> deps = g_scheduler->GetGenDependencies();
+    return std::count(deps.begin(), deps.end(), data_path);
+  };
+
+  SourceFile build_config("//build/config/BUILDCONFIG.gn");
+  build_settings_.set_build_config_file(build_config);
+
+  scoped_refptr<LoaderImpl> loader(new LoaderImpl(&build_settings_));
+  mock_ifm_.AddCannedResponse(
+      build_config,
+      "set_default_toolchain(\"//tc:tc\")\n"
+      "declare_args() {\n"
+      "  tc_arg = false\n"
+      "}\n"
+      "import(\"//defs.gni\")\n"
+      "template(\"config_template\") {\n"
+      "  not_needed([ \"invoker\", \"target_name\" ])\n"
+      "}\n"
+      "config_value = read_file(\"//data.txt\", \"string\")\n"
+      "scope_value = {\n"
+      "  a = 1\n"
+      "}\n"
+      "scope_list = [ { b = 2 } ]\n");
+  mock_ifm_.AddCannedResponse(
+      SourceFile("//defs.gni"),
+      "template(\"defs_template\") {\n"
+      "  not_needed([ \"invoker\", \"target_name\" ])\n"
+      "}\n");
+  SourceFile file("//foo/BUILD.gn");
+  mock_ifm_.AddCannedResponse(file,
+                              "import(\"//defs.gni\")\n"
+                              "defs_template(\"a\") {}\n"
+                              "config_template(\"b\") {}\n");
+
+  loader->set_async_load_file(mock_ifm_.GetAsyncCallback());
+
+  SourceFile root_build("//BUILD.gn");
+  loader->Load(root_build, LocationRange(), Label());
+  mock_ifm_.IssueAllPending();
+  MsgLoop::Current()->RunUntilIdleForTesting();
+  mock_ifm_.IssueAllPending();
+  MsgLoop::Current()->RunUntilIdleForTesting();
+  EXPECT_EQ(1, count_executions());
+
+  // Two toolchains without arguments. The second one copies the build config
+  // of the first one.
+  Label second_tc(SourceDir("//tc2/"), "tc2");
+  Label third_tc(SourceDir("//tc3/"), "tc3");
+  loader->Load(file, LocationRange(), second_tc);
+  loader->Load(file, LocationRange(), third_tc);
+  mock_ifm_.IssueAllPending();
+  MsgLoop::Current()->RunUntilIdleForTesting();
+
+  const Settings* default_settings = loader->GetToolchainSettings(Label());
+  Toolchain second_tc_object(default_settings, second_tc);
+  Toolchain third_tc_object(default_settings, third_tc);
+  loader->ToolchainLoaded(&second_tc_object);
+  loader->ToolchainLoaded(&third_tc_object);
+  mock_ifm_.IssueAllPending();
+  MsgLoop::Current()->RunUntilIdleForTesting();
+  EXPECT_EQ(2, count_executions());
+
+  // Importing the same file again and invoking the templates works in both.
+  EXPECT_TRUE(mock_ifm_.HasTwoPending(file, file));
+  mock_ifm_.IssueAllPending();
+  MsgLoop::Current()->RunUntilIdleForTesting();
+  EXPECT_FALSE(scheduler().is_failed());
+
+  for (const Label& label : {second_tc, third_tc}) {
+    const Settings* settings = loader->GetToolchainSettings(label);
+    const Scope* base_config = settings->base_config();
+    EXPECT_EQ("data", base_config->GetValue("config_value")->string_value());
+
+    // The templates and scope values refer to the toolchain they're used in.
+    const Template* config_template =
+        base_config->GetTemplate("config_template");
+    ASSERT_TRUE(config_template);
+    EXPECT_EQ(settings, config_template->closure()->settings());
+    const Template* defs_template = base_config->GetTemplate("defs_template");
+    ASSERT_TRUE(defs_template);
+    EXPECT_EQ(base_config, defs_template->closure()->containing());
+    const Scope* scope_value =
+        base_config->GetValue("scope_value")->scope_value();
+    EXPECT_EQ(settings, scope_value->settings());
+    EXPECT_EQ(1, scope_value->GetValue("a")->int_value());
+    const Value* scope_list = base_config->GetValue("scope_list");
+    ASSERT_EQ(1u, scope_list->list_value().size());
+    EXPECT_EQ(settings, scope_list->list_value()[0].scope_value()->settings());
+  }
+
+  // A toolchain with other arguments executes the build config again.
+  Label fourth_tc(SourceDir("//tc4/"), "tc4");
+  loader->Load(file, LocationRange(), fourth_tc);
+  mock_ifm_.IssueAllPending();
+  MsgLoop::Current()->RunUntilIdleForTesting();
+  Toolchain fourth_tc_object(default_settings, fourth_tc);
+  fourth_tc_object.args()["tc_arg"] = Value(nullptr, true);
+  loader->ToolchainLoaded(&fourth_tc_object);
+  mock_ifm_.IssueAllPending();
+  MsgLoop::Current()->RunUntilIdleForTesting();
+  EXPECT_EQ(3, count_executions());
+  EXPECT_TRUE(mock_ifm_.HasOnePending(file));
+  mock_ifm_.IssueAllPending();
+  MsgLoop::Current()->RunUntilIdleForTesting();
+  EXPECT_FALSE(scheduler().is_failed());
+
+  const Scope* fourth_config =
+      loader->GetToolchainSettings(fourth_tc)->base_config();
+  EXPECT_TRUE(fourth_config->GetValue("tc_arg")->boolean_value());
+}
@@ -17,7 +17,7 @@
 #include "gn/target.h"
 
 NinjaActionTargetWriter::NinjaActionTargetWriter(const Target* target,
-                                                 std::ostream& out)
+                                                 StringOutputBuffer& out)
     : NinjaTargetWriter(target, out),
       path_output_no_escaping_(
           target->settings()->build_settings()->build_dir(),
@@ -51,7 +51,7 @@ void NinjaActionTargetWriter::Run() {
       target_->output_type() == Target::ACTION ? 1u : target_->sources().size();
   std::vector<OutputFile> input_deps =
       WriteInputDepsStampAndGetDep(additional_hard_deps, num_stamp_uses);
-  out_ << std::endl;
+  out_ << '\n';
 
   // Collects all output files for writing below.
   std::vector<OutputFile> output_files;
@@ -76,7 +76,7 @@ void NinjaActionTargetWriter::Run() {
       out_ << " |";
       path_output_.WriteFiles(out_, input_deps);
     }
-    out_ << std::endl;
+    out_ << '\n';
     if (target_->action_values().has_depfile()) {
       WriteDepfile(SourceFile());
     }
@@ -84,10 +84,10 @@ void NinjaActionTargetWriter::Run() {
       out_ << "  pool = ";
       out_ << target_->action_values().pool().ptr->GetNinjaName(
           settings_->default_toolchain_label());
-      out_ << std::endl;
+      out_ << '\n';
     }
   }
-  out_ << std::endl;
+  out_ << '\n';
 
   // Write the stamp, which also depends on all data deps. These are needed at
   // runtime and should be compiled when the action is, but don't need to be
@@ -114,7 +114,7 @@ std::string NinjaActionTargetWriter::WriteRuleDefinition() {
   EscapeOptions args_escape_options;
   args_escape_options.mode = ESCAPE_NINJA_COMMAND;
 
-  out_ << "rule " << custom_rule_name << std::endl;
+  out_ << "rule " << custom_rule_name << '\n';
 
   if (target_->action_values().uses_rsp_file()) {
     // Needs a response file. The unique_name part is for action_foreach so
@@ -125,7 +125,7 @@ std::string NinjaActionTargetWriter::WriteRuleDefinition() {
     if (!target_->sources().empty())
       rspfile += ".$unique_name";
     rspfile += ".rsp";
-    out_ << "  rspfile = " << rspfile << std::endl;
+    out_ << "  rspfile = " << rspfile << '\n';
 
     // Response file contents.
     out_ << "  rspfile_content =";
@@ -135,7 +135,7 @@ std::string NinjaActionTargetWriter::WriteRuleDefinition() {
       SubstitutionWriter::WriteWithNinjaVariables(arg, args_escape_options,
                                                   out_);
     }
-    out_ << std::endl;
+    out_ << '\n';
   }
 
   out_ << "  command = ";
@@ -146,15 +146,15 @@ std::string NinjaActionTargetWriter::WriteRuleDefinition() {
     out_ << " ";
     SubstitutionWriter::WriteWithNinjaVariables(arg, args_escape_options, out_);
   }
-  out_ << std::endl;
-  out_ << "  description = ACTION " << target_label << std::endl;
-  out_ << "  restat = 1" << std::endl;
+  out_ << '\n';
+  out_ << "  description = ACTION " << target_label << '\n';
+  out_ << "  restat = 1" << '\n';
   const Tool* tool = target_->toolchain()->GetTool(GeneralTool::kGeneralToolAction);
   if (tool && tool->pool().ptr) {
     out_ << "  pool = ";
     out_ << tool->pool().ptr->GetNinjaName(
         settings_->default_toolchain_label());
-    out_ << std::endl;
+    out_ << '\n';
   }
 
   return custom_rule_name;
@@ -185,11 +185,11 @@ void NinjaActionTargetWriter::WriteSourceRules(
       out_ << " |";
       path_output_.WriteFiles(out_, input_deps);
     }
-    out_ << std::endl;
+    out_ << '\n';
 
     // Response files require a unique name be defined.
     if (target_->action_values().uses_rsp_file())
-      out_ << "  unique_name = " << i << std::endl;
+      out_ << "  unique_name = " << i << '\n';
 
     // The required types is the union of the args and response file. This
     // might theoretically duplicate a definition if the same substitution is
@@ -212,7 +212,7 @@ void NinjaActionTargetWriter::WriteSourceRules(
       out_ << "  pool = ";
       out_ << target_->action_values().pool().ptr->GetNinjaName(
           settings_->default_toolchain_label());
-      out_ << std::endl;
+      out_ << '\n';
     }
   }
 }
@@ -238,13 +238,13 @@ void NinjaActionTargetWriter::WriteDepfile(const SourceFile& source) {
       out_,
       SubstitutionWriter::ApplyPatternToSourceAsOutputFile(
           target_, settings_, target_->action_values().depfile(), source));
-  out_ << std::endl;
+  out_ << '\n';
   // Using "deps = gcc" allows Ninja to read and store the depfile content in
   // its internal database which improves performance, especially for large
   // depfiles. The use of this feature with depfiles that contain multiple
   // outputs require Ninja version 1.9.0 or newer.
   if (settings_->build_settings()->ninja_required_version() >=
       Version{1, 9, 0}) {
-    out_ << "  deps = gcc" << std::endl;
+    out_ << "  deps = gcc" << '\n';
   }
 }
@@ -3,7 +3,6 @@
 // found in the LICENSE file.
 
 #include <algorithm>
-#include <sstream>
 
 #include "gn/ninja_action_target_writer.h"
 #include "gn/pool.h"
@@ -26,7 +25,7 @@ TEST(NinjaActionTargetWriter, WriteOutputFilesForBuildLine) {
   target.SetToolchain(setup.toolchain());
   ASSERT_TRUE(target.OnResolved(&err));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaActionTargetWriter writer(&target, out);
 
   SourceFile source("//foo/bar.in");
@@ -56,7 +55,7 @@ TEST(NinjaActionTargetWriter, ActionNoSources) {
   setup.build_settings()->set_python_path(
       base::FilePath(FILE_PATH_LITERAL("/usr/bin/python")));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaActionTargetWriter writer(&target, out);
   writer.Run();
 
@@ -98,7 +97,7 @@ TEST(NinjaActionTargetWriter, ActionNoSourcesConsole) {
   setup.build_settings()->set_python_path(
       base::FilePath(FILE_PATH_LITERAL("/usr/bin/python")));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaActionTargetWriter writer(&target, out);
   writer.Run();
 
@@ -140,7 +139,7 @@ TEST(NinjaActionTargetWriter, ActionWithSources) {
   setup.build_settings()->set_python_path(
       base::FilePath(FILE_PATH_LITERAL("/usr/bin/python")));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaActionTargetWriter writer(&target, out);
   writer.Run();
 
@@ -209,7 +208,7 @@ TEST(NinjaActionTargetWriter, ForEach) {
   setup.build_settings()->set_python_path(
       base::FilePath(FILE_PATH_LITERAL("/usr/bin/python")));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaActionTargetWriter writer(&target, out);
   writer.Run();
 
@@ -276,7 +275,7 @@ TEST(NinjaActionTargetWriter, ForEachWithDepfile) {
       base::FilePath(FILE_PATH_LITERAL("/usr/bin/python")));
   setup.build_settings()->set_ninja_required_version(Version{1, 9, 0});
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaActionTargetWriter writer(&target, out);
   writer.Run();
 
@@ -333,7 +332,7 @@ TEST(NinjaActionTargetWriter, ForEachWithResponseFile) {
   setup.build_settings()->set_python_path(
       base::FilePath(FILE_PATH_LITERAL("/usr/bin/python")));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaActionTargetWriter writer(&target, out);
   writer.Run();
 
@@ -391,7 +390,7 @@ TEST(NinjaActionTargetWriter, ForEachWithPool) {
   setup.build_settings()->set_python_path(
       base::FilePath(FILE_PATH_LITERAL("/usr/bin/python")));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaActionTargetWriter writer(&target, out);
   writer.Run();
 
@@ -438,7 +437,7 @@ TEST(NinjaActionTargetWriter, NoTransitiveHardDeps) {
   ASSERT_TRUE(foo.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaActionTargetWriter writer(&foo, out);
     writer.Run();
 
@@ -467,7 +466,7 @@ TEST(NinjaActionTargetWriter, NoTransitiveHardDeps) {
   ASSERT_TRUE(bar.OnResolved(&err)) << err.message();
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaActionTargetWriter writer(&bar, out);
     writer.Run();
 
@@ -5,7 +5,6 @@
 #include "gn/ninja_binary_target_writer.h"
 
 #include <algorithm>
-#include <sstream>
 
 #include "base/strings/string_util.h"
 #include "gn/args.h"
@@ -36,7 +35,7 @@ EscapeOptions GetFlagOptions() {
 }  // namespace
 
 NinjaBinaryTargetWriter::NinjaBinaryTargetWriter(const Target* target,
-                                                 std::ostream& out)
+                                                 StringOutputBuffer& out)
     : NinjaTargetWriter(target, out),
       rule_prefix_(GetNinjaRulePrefixForToolchain(settings_)) {}
 
@@ -130,7 +129,7 @@ std::vector<OutputFile> NinjaBinaryTargetWriter::WriteInputsStampAndGetDep(
     path_output_.WriteFile(out_, *input);
   }
 
-  out_ << std::endl;
+  out_ << '\n';
   return {stamp_file};
 }
 
@@ -327,11 +326,11 @@ void NinjaBinaryTargetWriter::WriteCompilerBuildLine(
     out_ << " ||";
     path_output_.WriteFiles(out_, order_only_deps);
   }
-  out_ << std::endl;
+  out_ << '\n';
 }
 
 void NinjaBinaryTargetWriter::WriteCustomLinkerFlags(
-    std::ostream& out,
+    StringOutputBuffer& out,
     const Tool* tool) {
 
   if (tool->AsC() || (tool->AsRust() && tool->AsRust()->MayLink())) {
@@ -343,7 +342,7 @@ void NinjaBinaryTargetWriter::WriteCustomLinkerFlags(
 }
 
 void NinjaBinaryTargetWriter::WriteLibrarySearchPath(
-    std::ostream& out,
+    StringOutputBuffer& out,
     const Tool* tool) {
   // Write library search paths that have been recursively pushed
   // through the dependency tree.
@@ -377,7 +376,7 @@ void NinjaBinaryTargetWriter::WriteLibrarySearchPath(
 }
 
 void NinjaBinaryTargetWriter::WriteLinkerFlags(
-    std::ostream& out,
+    StringOutputBuffer& out,
     const Tool* tool,
     const SourceFile* optional_def_file) {
   // First any ldflags
@@ -391,7 +390,8 @@ void NinjaBinaryTargetWriter::WriteLinkerFlags(
   }
 }
 
-void NinjaBinaryTargetWriter::WriteLibs(std::ostream& out, const Tool* tool) {
+void NinjaBinaryTargetWriter::WriteLibs(StringOutputBuffer& out,
+                                        const Tool* tool) {
   // Libraries that have been recursively pushed through the dependency tree.
   // Since we're passing these on the command line to the linker and not
   // to Ninja, we need to do shell escaping.
@@ -414,7 +414,7 @@ void NinjaBinaryTargetWriter::WriteLibs(std::ostream& out, const Tool* tool) {
   }
 }
 
-void NinjaBinaryTargetWriter::WriteFrameworks(std::ostream& out,
+void NinjaBinaryTargetWriter::WriteFrameworks(StringOutputBuffer& out,
                                               const Tool* tool) {
   // Frameworks that have been recursively pushed through the dependency tree.
   FrameworksWriter writer(tool->framework_switch());
@@ -431,7 +431,7 @@ void NinjaBinaryTargetWriter::WriteFrameworks(std::ostream& out,
 }
 
 void NinjaBinaryTargetWriter::WriteSwiftModules(
-    std::ostream& out,
+    StringOutputBuffer& out,
     const Tool* tool,
     const std::vector<OutputFile>& swiftmodules) {
   // Since we're passing these on the command line to the linker and not
@@ -18,7 +18,7 @@ struct EscapeOptions;
 // library, or a static library).
 class NinjaBinaryTargetWriter : public NinjaTargetWriter {
  public:
-  NinjaBinaryTargetWriter(const Target* target, std::ostream& out);
+  NinjaBinaryTargetWriter(const Target* target, StringOutputBuffer& out);
   ~NinjaBinaryTargetWriter() override;
 
   void Run() override;
@@ -75,14 +75,14 @@ class NinjaBinaryTargetWriter : public NinjaTargetWriter {
                               const char* tool_name,
                               const std::vector<OutputFile>& outputs);
 
-  void WriteLinkerFlags(std::ostream& out,
+  void WriteLinkerFlags(StringOutputBuffer& out,
                         const Tool* tool,
                         const SourceFile* optional_def_file);
-  void WriteCustomLinkerFlags(std::ostream& out, const Tool* tool);
-  void WriteLibrarySearchPath(std::ostream& out, const Tool* tool);
-  void WriteLibs(std::ostream& out, const Tool* tool);
-  void WriteFrameworks(std::ostream& out, const Tool* tool);
-  void WriteSwiftModules(std::ostream& out,
+  void WriteCustomLinkerFlags(StringOutputBuffer& out, const Tool* tool);
+  void WriteLibrarySearchPath(StringOutputBuffer& out, const Tool* tool);
+  void WriteLibs(StringOutputBuffer& out, const Tool* tool);
+  void WriteFrameworks(StringOutputBuffer& out, const Tool* tool);
+  void WriteSwiftModules(StringOutputBuffer& out,
                          const Tool* tool,
                          const std::vector<OutputFile>& swiftmodules);
 
@@ -28,7 +28,7 @@ TEST_F(NinjaBinaryTargetWriterTest, CSources) {
   target.SetToolchain(setup.toolchain());
   ASSERT_TRUE(target.OnResolved(&err));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaBinaryTargetWriter writer(&target, out);
   writer.Run();
 
@@ -60,7 +60,7 @@ TEST_F(NinjaBinaryTargetWriterTest, NoSourcesSourceSet) {
   target.SetToolchain(setup.toolchain());
   ASSERT_TRUE(target.OnResolved(&err));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaBinaryTargetWriter writer(&target, out);
   writer.Run();
 
@@ -87,7 +87,7 @@ TEST_F(NinjaBinaryTargetWriterTest, NoSourcesStaticLib) {
   target.SetToolchain(setup.toolchain());
   ASSERT_TRUE(target.OnResolved(&err));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaBinaryTargetWriter writer(&target, out);
   writer.Run();
 
@@ -122,7 +122,7 @@ TEST_F(NinjaBinaryTargetWriterTest, Inputs) {
     target.SetToolchain(setup.toolchain());
     ASSERT_TRUE(target.OnResolved(&err));
 
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -155,7 +155,7 @@ TEST_F(NinjaBinaryTargetWriterTest, Inputs) {
     target.SetToolchain(setup.toolchain());
     ASSERT_TRUE(target.OnResolved(&err));
 
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaBinaryTargetWriter writer(&target, out);
     writer.Run();
 
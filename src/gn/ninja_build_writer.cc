@@ -6,10 +6,8 @@
 
 #include <stddef.h>
 
-#include <fstream>
 #include <map>
 #include <set>
-#include <sstream>
 
 #include "base/command_line.h"
 #include "base/files/file_util.h"
@@ -26,6 +24,7 @@
 #include "gn/pool.h"
 #include "gn/scheduler.h"
 #include "gn/string_atom.h"
+#include "gn/string_output_buffer.h"
 #include "gn/switches.h"
 #include "gn/target.h"
 #include "gn/trace.h"
@@ -198,8 +197,8 @@ NinjaBuildWriter::NinjaBuildWriter(
     const std::vector<const Target*>& all_targets,
     const Toolchain* default_toolchain,
     const std::vector<const Target*>& default_toolchain_targets,
-    std::ostream& out,
-    std::ostream& dep_out)
+    StringOutputBuffer& out,
+    StringOutputBuffer& dep_out)
     : build_settings_(build_settings),
       used_toolchains_(used_toolchains),
       all_targets_(all_targets),
@@ -253,8 +252,8 @@ bool NinjaBuildWriter::RunAndWriteFile(const BuildSettings* build_settings,
     }
   }
 
-  std::stringstream file;
-  std::stringstream depfile;
+  StringOutputBuffer file;
+  StringOutputBuffer depfile;
   NinjaBuildWriter gen(build_settings, used_toolchains, all_targets,
                        default_toolchain, default_toolchain_targets, file,
                        depfile);
@@ -267,23 +266,13 @@ bool NinjaBuildWriter::RunAndWriteFile(const BuildSettings* build_settings,
   // if the contents haven't been changed.
   base::FilePath ninja_file_name(build_settings->GetFullPath(
       SourceFile(build_settings->build_dir().value() + "build.ninja")));
-  base::CreateDirectory(ninja_file_name.DirName());
-  std::string ninja_contents = file.str();
-  if (base::WriteFile(ninja_file_name, ninja_contents.data(),
-                      static_cast<int>(ninja_contents.size())) !=
-      static_cast<int>(ninja_contents.size()))
+  if (!file.WriteToFile(ninja_file_name, nullptr))
     return false;
 
   // Dep file listing build dependencies.
   base::FilePath dep_file_name(build_settings->GetFullPath(
       SourceFile(build_settings->build_dir().value() + "build.ninja.d")));
-  std::string dep_contents = depfile.str();
-  if (base::WriteFile(dep_file_name, dep_contents.data(),
-                      static_cast<int>(dep_contents.size())) !=
-      static_cast<int>(dep_contents.size()))
-    return false;
-
-  return true;
+  return depfile.WriteToFile(dep_file_name, nullptr);
 }
 
 void NinjaBuildWriter::WriteNinjaRules() {
@@ -335,7 +324,7 @@ void NinjaBuildWriter::WriteNinjaRules() {
 
   sorter.IterateOver(item_callback);
 
-  out_ << std::endl;
+  out_ << '\n';
 }
 
 void NinjaBuildWriter::WriteAllPools() {
@@ -369,9 +358,9 @@ void NinjaBuildWriter::WriteAllPools() {
     std::string name = pool_name(pool);
     if (name == "console")
       continue;
-    out_ << "pool " << name << std::endl
-         << "  depth = " << pool->depth() << std::endl
-         << std::endl;
+    out_ << "pool " << name << '\n'
+         << "  depth = " << pool->depth() << '\n'
+         << '\n';
   }
 }
 
@@ -407,11 +396,11 @@ bool NinjaBuildWriter::WriteSubninjas(Err* err) {
 
     out_ << "subninja ";
     path_output_.WriteFile(out_, subninja);
-    out_ << std::endl;
+    out_ << '\n';
     previous_subninja = subninja;
     previous_toolchain = pair.second;
   }
-  out_ << std::endl;
+  out_ << '\n';
   return true;
 }
 
@@ -616,19 +605,19 @@ bool NinjaBuildWriter::WritePhonyAndAllRules(Err* err) {
       path_output_.WriteFile(out_, target->dependency_output_file());
     }
   }
-  out_ << std::endl;
+  out_ << '\n';
 
   if (default_target) {
     // Use the short name when available
     if (written_rules.find(StringAtom("default")) != written_rules.end()) {
-      out_ << "\ndefault default" << std::endl;
+      out_ << "\ndefault default" << '\n';
     } else {
       out_ << "\ndefault ";
       path_output_.WriteFile(out_, default_target->dependency_output_file());
-      out_ << std::endl;
+      out_ << '\n';
     }
   } else if (!default_toolchain_targets_.empty()) {
-    out_ << "\ndefault all" << std::endl;
+    out_ << "\ndefault all" << '\n';
   }
 
   return true;
@@ -644,5 +633,5 @@ void NinjaBuildWriter::WritePhonyRule(const Target* target,
 
   out_ << "build " << escaped << ": phony ";
   path_output_.WriteFile(out_, target->dependency_output_file());
-  out_ << std::endl;
+  out_ << '\n';
 }
@@ -5,7 +5,6 @@
 #ifndef TOOLS_GN_NINJA_BUILD_WRITER_H_
 #define TOOLS_GN_NINJA_BUILD_WRITER_H_
 
-#include <iosfwd>
 #include <map>
 #include <string_view>
 #include <unordered_map>
@@ -17,6 +16,7 @@ class Builder;
 class BuildSettings;
 class Err;
 class Settings;
+class StringOutputBuffer;
 class Target;
 class Toolchain;
 
@@ -35,8 +35,8 @@ class NinjaBuildWriter {
                    const std::vector<const Target*>& all_targets,
                    const Toolchain* default_toolchain,
                    const std::vector<const Target*>& default_toolchain_targets,
-                   std::ostream& out,
-                   std::ostream& dep_out);
+                   StringOutputBuffer& out,
+                   StringOutputBuffer& dep_out);
   ~NinjaBuildWriter();
 
   // The design of this class is that this static factory function takes the
@@ -65,8 +65,8 @@ class NinjaBuildWriter {
   const Toolchain* default_toolchain_;
   const std::vector<const Target*>& default_toolchain_targets_;
 
-  std::ostream& out_;
-  std::ostream& dep_out_;
+  StringOutputBuffer& out_;
+  StringOutputBuffer& dep_out_;
   PathOutput path_output_;
 
   NinjaBuildWriter(const NinjaBuildWriter&) = delete;
@@ -2,13 +2,12 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
-#include <sstream>
-
 #include "base/command_line.h"
 #include "base/files/file_util.h"
 #include "gn/ninja_build_writer.h"
 #include "gn/pool.h"
 #include "gn/scheduler.h"
+#include "gn/string_output_buffer.h"
 #include "gn/switches.h"
 #include "gn/target.h"
 #include "gn/test_with_scheduler.h"
@@ -135,8 +134,8 @@ TEST_F(NinjaBuildWriterTest, TwoTargets) {
 
   std::vector<const Target*> targets = {&target_foo, &target_bar, &target_baz};
 
-  std::ostringstream ninja_out;
-  std::ostringstream depfile_out;
+  StringOutputBuffer ninja_out;
+  StringOutputBuffer depfile_out;
 
   NinjaBuildWriter writer(setup.build_settings(), used_toolchains, targets,
                           setup.toolchain(), targets, ninja_out, depfile_out);
@@ -201,8 +200,8 @@ TEST_F(NinjaBuildWriterTest, SpaceInDepfile) {
   std::unordered_map<const Settings*, const Toolchain*> used_toolchains;
   used_toolchains[setup.settings()] = setup.toolchain();
   std::vector<const Target*> targets;
-  std::ostringstream ninja_out;
-  std::ostringstream depfile_out;
+  StringOutputBuffer ninja_out;
+  StringOutputBuffer depfile_out;
   NinjaBuildWriter writer(setup.build_settings(), used_toolchains, targets,
                           setup.toolchain(), targets, ninja_out, depfile_out);
   ASSERT_TRUE(writer.Run(&err));
@@ -234,8 +233,8 @@ TEST_F(NinjaBuildWriterTest, DuplicateOutputs) {
   std::unordered_map<const Settings*, const Toolchain*> used_toolchains;
   used_toolchains[setup.settings()] = setup.toolchain();
   std::vector<const Target*> targets = {&target_foo, &target_bar};
-  std::ostringstream ninja_out;
-  std::ostringstream depfile_out;
+  StringOutputBuffer ninja_out;
+  StringOutputBuffer depfile_out;
   NinjaBuildWriter writer(setup.build_settings(), used_toolchains, targets,
                           setup.toolchain(), targets, ninja_out, depfile_out);
   ASSERT_FALSE(writer.Run(&err));
@@ -5,7 +5,6 @@
 #include "gn/ninja_bundle_data_target_writer.h"
 
 #include <algorithm>
-#include <sstream>
 
 #include "gn/target.h"
 #include "gn/test_with_scope.h"
@@ -37,7 +36,7 @@ TEST(NinjaBundleDataTargetWriter, Run) {
   bundle_data.visibility().SetPublic();
   ASSERT_TRUE(bundle_data.OnResolved(&err));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaBundleDataTargetWriter writer(&bundle_data, out);
   writer.Run();
 
@@ -10,7 +10,6 @@
 #include <cstring>
 #include <iterator>
 #include <set>
-#include <sstream>
 
 #include "base/strings/string_util.h"
 #include "gn/c_substitution_type.h"
@@ -181,7 +180,7 @@ const char* PrepareCompilerBuildLine(
 }  // namespace
 
 NinjaCBinaryTargetWriter::NinjaCBinaryTargetWriter(const Target* target,
-                                                   std::ostream& out)
+                                                   StringOutputBuffer& out)
     : NinjaBinaryTargetWriter(target, out),
       tool_(target->toolchain()->GetToolForTargetFinalOutputAsC(target)) {}
 
@@ -295,7 +294,7 @@ void NinjaCBinaryTargetWriter::WriteCompilerVars(
     RecursiveTargetConfigToStream<std::string>(kRecursiveWriterSkipDuplicates,
                                                target_, &ConfigValues::defines,
                                                DefineWriter(), out_);
-    out_ << std::endl;
+    out_ << '\n';
   }
 
   // Framework search path.
@@ -311,7 +310,7 @@ void NinjaCBinaryTargetWriter::WriteCompilerVars(
         FrameworkDirsWriter(framework_dirs_output,
                             tool->framework_dir_switch()),
         out_);
-    out_ << std::endl;
+    out_ << '\n';
   }
 
   // Include directories.
@@ -323,7 +322,7 @@ void NinjaCBinaryTargetWriter::WriteCompilerVars(
     RecursiveTargetConfigToStream<SourceDir>(
         kRecursiveWriterSkipDuplicates, target_, &ConfigValues::include_dirs,
         IncludeWriter(include_path_output), out_);
-    out_ << std::endl;
+    out_ << '\n';
   }
 
   if (!module_dep_info.empty()) {
@@ -384,7 +383,7 @@ void NinjaCBinaryTargetWriter::WriteCompilerVars(
     if (subst.used.count(&CSubstitutionSwiftModuleName)) {
       out_ << CSubstitutionSwiftModuleName.ninja_name << " = ";
       EscapeStringToStream(out_, target_->swift_values().module_name(), opts);
-      out_ << std::endl;
+      out_ << '\n';
     }
 
     if (subst.used.count(&CSubstitutionSwiftBridgeHeader)) {
@@ -394,7 +393,7 @@ void NinjaCBinaryTargetWriter::WriteCompilerVars(
       } else {
         out_ << R"("")";
       }
-      out_ << std::endl;
+      out_ << '\n';
     }
 
     if (subst.used.count(&CSubstitutionSwiftModuleDirs)) {
@@ -412,7 +411,7 @@ void NinjaCBinaryTargetWriter::WriteCompilerVars(
       for (const SourceDir& swiftmodule_dir : swiftmodule_dirs) {
         swiftmodule_path_writer(swiftmodule_dir, out_);
       }
-      out_ << std::endl;
+      out_ << '\n';
     }
 
     WriteOneFlag(kRecursiveWriterKeepDuplicates, target_,
@@ -443,7 +442,7 @@ void NinjaCBinaryTargetWriter::WriteModuleDepsSubstitution(
       }
     }
 
-    out_ << std::endl;
+    out_ << '\n';
   }
 }
 
@@ -564,7 +563,7 @@ void NinjaCBinaryTargetWriter::WriteGCCPCHCommand(
 
   // Write two blank lines to help separate the PCH build lines from the
   // regular source build lines.
-  out_ << std::endl << std::endl;
+  out_ << '\n' << '\n';
 }
 
 void NinjaCBinaryTargetWriter::WriteWindowsPCHCommand(
@@ -600,7 +599,7 @@ void NinjaCBinaryTargetWriter::WriteWindowsPCHCommand(
 
   // Write two blank lines to help separate the PCH build lines from the
   // regular source build lines.
-  out_ << std::endl << std::endl;
+  out_ << '\n' << '\n';
 }
 
 void NinjaCBinaryTargetWriter::WriteSources(
@@ -661,7 +660,7 @@ void NinjaCBinaryTargetWriter::WriteSources(
     }
   }
 
-  out_ << std::endl;
+  out_ << '\n';
 }
 
 void NinjaCBinaryTargetWriter::WriteSwiftSources(
@@ -735,7 +734,7 @@ void NinjaCBinaryTargetWriter::WriteSwiftSources(
                            {swiftmodule_output_file});
 
     if (!additional_outputs.empty()) {
-      out_ << std::endl;
+      out_ << '\n';
       WriteCompilerBuildLine(
           {swiftmodule_output_file.AsSourceFile(settings_->build_settings())},
           input_deps, swift_order_only_deps.vector(),
@@ -743,7 +742,7 @@ void NinjaCBinaryTargetWriter::WriteSwiftSources(
     }
   }
 
-  out_ << std::endl;
+  out_ << '\n';
 }
 
 void NinjaCBinaryTargetWriter::WriteLinkerStuff(
@@ -873,7 +872,7 @@ void NinjaCBinaryTargetWriter::WriteLinkerStuff(
   WriteOrderOnlyDependencies(classified_deps.non_linkable_deps);
 
   // End of the link "build" line.
-  out_ << std::endl;
+  out_ << '\n';
 
   // The remaining things go in the inner scope of the link line.
   if (target_->output_type() == Target::EXECUTABLE ||
@@ -881,22 +880,22 @@ void NinjaCBinaryTargetWriter::WriteLinkerStuff(
       target_->output_type() == Target::LOADABLE_MODULE) {
     out_ << "  ldflags =";
     WriteLinkerFlags(out_, tool_, optional_def_file);
-    out_ << std::endl;
+    out_ << '\n';
     out_ << "  libs =";
     WriteLibs(out_, tool_);
-    out_ << std::endl;
+    out_ << '\n';
     out_ << "  frameworks =";
     WriteFrameworks(out_, tool_);
-    out_ << std::endl;
+    out_ << '\n';
     out_ << "  swiftmodules =";
     WriteSwiftModules(out_, tool_, swiftmodules);
-    out_ << std::endl;
+    out_ << '\n';
   } else if (target_->output_type() == Target::STATIC_LIBRARY) {
     out_ << "  arflags =";
     RecursiveTargetConfigStringsToStream(kRecursiveWriterKeepDuplicates,
                                          target_, &ConfigValues::arflags,
                                          GetFlagOptions(), out_);
-    out_ << std::endl;
+    out_ << '\n';
   }
   WriteOutputSubstitutions();
   WriteLibsList("solibs", solibs);
@@ -907,11 +906,11 @@ void NinjaCBinaryTargetWriter::WriteOutputSubstitutions() {
   out_ << "  output_extension = "
        << SubstitutionWriter::GetLinkerSubstitution(
               target_, tool_, &SubstitutionOutputExtension);
-  out_ << std::endl;
+  out_ << '\n';
   out_ << "  output_dir = "
        << SubstitutionWriter::GetLinkerSubstitution(target_, tool_,
                                                     &SubstitutionOutputDir);
-  out_ << std::endl;
+  out_ << '\n';
 }
 
 void NinjaCBinaryTargetWriter::WriteLibsList(
@@ -925,7 +924,7 @@ void NinjaCBinaryTargetWriter::WriteLibsList(
                     settings_->build_settings()->root_path_utf8(),
                     ESCAPE_NINJA_COMMAND);
   output.WriteFiles(out_, libs);
-  out_ << std::endl;
+  out_ << '\n';
 }
 
 void NinjaCBinaryTargetWriter::WriteOrderOnlyDependencies(
@@ -5,7 +5,6 @@
 #include "gn/ninja_c_binary_target_writer.h"
 
 #include <memory>
-#include <sstream>
 #include <utility>
 
 #include "gn/config.h"
@@ -39,7 +38,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, SourceSet) {
 
   // Source set itself.
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -69,7 +68,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, SourceSet) {
   ASSERT_TRUE(shlib_target.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&shlib_target, out);
     writer.Run();
 
@@ -105,7 +104,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, SourceSet) {
   ASSERT_TRUE(stlib_target.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&stlib_target, out);
     writer.Run();
 
@@ -130,7 +129,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, SourceSet) {
   // Make the static library 'complete', which means it should be linked.
   stlib_target.set_complete_static_lib(true);
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&stlib_target, out);
     writer.Run();
 
@@ -166,7 +165,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, EscapeDefines) {
   target.config_values().defines().push_back("STR_DEF=\"ABCD-1\"");
   ASSERT_TRUE(target.OnResolved(&err));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaCBinaryTargetWriter writer(&target, out);
   writer.Run();
 
@@ -190,7 +189,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, StaticLibrary) {
   target.config_values().arflags().push_back("--asdf");
   ASSERT_TRUE(target.OnResolved(&err));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaCBinaryTargetWriter writer(&target, out);
   writer.Run();
 
@@ -236,7 +235,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, CompleteStaticLibrary) {
   // should link in the dependent object files as if the dependent target
   // were a source set.
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -265,7 +264,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, CompleteStaticLibrary) {
 
   // Dependent complete static libraries should not be linked directly.
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -315,7 +314,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, OutputExtensionAndInputDeps) {
   target.SetToolchain(setup.toolchain());
   ASSERT_TRUE(target.OnResolved(&err));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaCBinaryTargetWriter writer(&target, out);
   writer.Run();
 
@@ -378,7 +377,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, NoHardDepsToNoPublicHeaderTarget) {
   gen_obj.SetToolchain(setup.toolchain());
   ASSERT_TRUE(gen_obj.OnResolved(&err));
 
-  std::ostringstream obj_out;
+  StringOutputBuffer obj_out;
   NinjaCBinaryTargetWriter obj_writer(&gen_obj, obj_out);
   obj_writer.Run();
 
@@ -414,7 +413,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, NoHardDepsToNoPublicHeaderTarget) {
   gen_lib.SetToolchain(setup.toolchain());
   ASSERT_TRUE(gen_lib.OnResolved(&err));
 
-  std::ostringstream lib_out;
+  StringOutputBuffer lib_out;
   NinjaCBinaryTargetWriter lib_writer(&gen_lib, lib_out);
   lib_writer.Run();
 
@@ -452,7 +451,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, NoHardDepsToNoPublicHeaderTarget) {
   executable.SetToolchain(setup.toolchain());
   ASSERT_TRUE(executable.OnResolved(&err)) << err.message();
 
-  std::ostringstream final_out;
+  StringOutputBuffer final_out;
   NinjaCBinaryTargetWriter final_writer(&executable, final_out);
   final_writer.Run();
 
@@ -496,7 +495,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, LibsAndLibDirs) {
   target.SetToolchain(setup.toolchain());
   ASSERT_TRUE(target.OnResolved(&err));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaCBinaryTargetWriter writer(&target, out);
   writer.Run();
 
@@ -556,7 +555,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, FrameworksAndFrameworkDirs) {
   target.SetToolchain(setup.toolchain());
   ASSERT_TRUE(target.OnResolved(&err));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaCBinaryTargetWriter writer(&target, out);
   writer.Run();
 
@@ -599,7 +598,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, EmptyOutputExtension) {
   target.SetToolchain(setup.toolchain());
   ASSERT_TRUE(target.OnResolved(&err));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaCBinaryTargetWriter writer(&target, out);
   writer.Run();
 
@@ -650,7 +649,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, SourceSetDataDeps) {
   ASSERT_TRUE(inter.OnResolved(&err)) << err.message();
 
   // Write out the intermediate target.
-  std::ostringstream inter_out;
+  StringOutputBuffer inter_out;
   NinjaCBinaryTargetWriter inter_writer(&inter, inter_out);
   inter_writer.Run();
 
@@ -681,7 +680,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, SourceSetDataDeps) {
   exe.source_types_used().Set(SourceFile::SOURCE_CPP);
   ASSERT_TRUE(exe.OnResolved(&err));
 
-  std::ostringstream final_out;
+  StringOutputBuffer final_out;
   NinjaCBinaryTargetWriter final_writer(&exe, final_out);
   final_writer.Run();
 
@@ -725,7 +724,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, SharedLibraryModuleDefinitionFile) {
   shared_lib.source_types_used().Set(SourceFile::SOURCE_DEF);
   ASSERT_TRUE(shared_lib.OnResolved(&err));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaCBinaryTargetWriter writer(&shared_lib, out);
   writer.Run();
 
@@ -762,7 +761,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, LoadableModule) {
   loadable_module.source_types_used().Set(SourceFile::SOURCE_CPP);
   ASSERT_TRUE(loadable_module.OnResolved(&err)) << err.message();
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaCBinaryTargetWriter writer(&loadable_module, out);
   writer.Run();
 
@@ -795,7 +794,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, LoadableModule) {
   exe.source_types_used().Set(SourceFile::SOURCE_CPP);
   ASSERT_TRUE(exe.OnResolved(&err)) << err.message();
 
-  std::ostringstream final_out;
+  StringOutputBuffer final_out;
   NinjaCBinaryTargetWriter final_writer(&exe, final_out);
   final_writer.Run();
 
@@ -874,7 +873,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, WinPrecompiledHeaders) {
     no_pch_target.SetToolchain(&pch_toolchain);
     ASSERT_TRUE(no_pch_target.OnResolved(&err));
 
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&no_pch_target, out);
     writer.Run();
 
@@ -912,7 +911,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, WinPrecompiledHeaders) {
     pch_target.SetToolchain(&pch_toolchain);
     ASSERT_TRUE(pch_target.OnResolved(&err));
 
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&pch_target, out);
     writer.Run();
 
@@ -1008,7 +1007,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, GCCPrecompiledHeaders) {
     no_pch_target.SetToolchain(&pch_toolchain);
     ASSERT_TRUE(no_pch_target.OnResolved(&err));
 
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&no_pch_target, out);
     writer.Run();
 
@@ -1046,7 +1045,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, GCCPrecompiledHeaders) {
     pch_target.SetToolchain(&pch_toolchain);
     ASSERT_TRUE(pch_target.OnResolved(&err));
 
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&pch_target, out);
     writer.Run();
 
@@ -1097,7 +1096,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, DupeObjFileError) {
 
   scheduler().SuppressOutputForTesting(true);
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaCBinaryTargetWriter writer(&target, out);
   writer.Run();
 
@@ -1125,7 +1124,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, InputFiles) {
     target.SetToolchain(setup.toolchain());
     ASSERT_TRUE(target.OnResolved(&err));
 
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -1158,7 +1157,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, InputFiles) {
     target.SetToolchain(setup.toolchain());
     ASSERT_TRUE(target.OnResolved(&err));
 
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -1194,7 +1193,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, InputFiles) {
     target.SetToolchain(setup.toolchain());
     ASSERT_TRUE(target.OnResolved(&err));
 
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -1244,7 +1243,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, InputFiles) {
     target.SetToolchain(setup.toolchain());
     ASSERT_TRUE(target.OnResolved(&err));
 
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -1297,7 +1296,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, RustDeps) {
     target.SetToolchain(setup.toolchain());
     ASSERT_TRUE(target.OnResolved(&err));
 
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -1409,7 +1408,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, RustDeps) {
     target.SetToolchain(setup.toolchain());
     ASSERT_TRUE(target.OnResolved(&err));
 
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -1472,7 +1471,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, RustDeps) {
     target.SetToolchain(setup.toolchain());
     ASSERT_TRUE(target.OnResolved(&err));
 
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -1517,7 +1516,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, ModuleMapInStaticLibrary) {
   target.source_types_used().Set(SourceFile::SOURCE_MODULEMAP);
   ASSERT_TRUE(target.OnResolved(&err));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaCBinaryTargetWriter writer(&target, out);
   writer.Run();
 
@@ -1558,7 +1557,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, SwiftModule) {
   ASSERT_TRUE(foo_target.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&foo_target, out);
     writer.Run();
 
@@ -1595,7 +1594,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, SwiftModule) {
     bar_target.SetToolchain(setup.toolchain());
     ASSERT_TRUE(bar_target.OnResolved(&err));
 
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&bar_target, out);
     writer.Run();
 
@@ -1641,7 +1640,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, SwiftModule) {
     bar_target.SetToolchain(setup.toolchain());
     ASSERT_TRUE(bar_target.OnResolved(&err));
 
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&bar_target, out);
     writer.Run();
 
@@ -1676,7 +1675,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, SwiftModule) {
     bar_target.SetToolchain(setup.toolchain());
     ASSERT_TRUE(bar_target.OnResolved(&err));
 
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&bar_target, out);
     writer.Run();
 
@@ -1774,7 +1773,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, DependOnModule) {
 
   // The library first.
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -1815,7 +1814,7 @@ build obj/blah/liba.a: alink obj/blah/liba.a.o
 
   // A second library to make sure the depender includes both.
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&target2, out);
     writer.Run();
 
@@ -1855,7 +1854,7 @@ build obj/stuff/libb.a: alink obj/stuff/libb.b.o
   // A third library that depends on one of the previous static libraries, to
   // check module_deps_no_self.
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&target3, out);
     writer.Run();
 
@@ -1894,7 +1893,7 @@ build obj/things/libc.a: alink || obj/blah/liba.a
 
   // Then the executable that depends on it.
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaCBinaryTargetWriter writer(&depender, out);
     writer.Run();
 
@@ -1952,7 +1951,7 @@ TEST_F(NinjaCBinaryTargetWriterTest, SolibsEscaping) {
   target.SetToolchain(&toolchain_with_toc);
   ASSERT_TRUE(target.OnResolved(&err));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaCBinaryTargetWriter writer(&target, out);
   writer.Run();
 
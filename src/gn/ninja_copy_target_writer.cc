@@ -16,7 +16,7 @@
 #include "gn/toolchain.h"
 
 NinjaCopyTargetWriter::NinjaCopyTargetWriter(const Target* target,
-                                             std::ostream& out)
+                                             StringOutputBuffer& out)
     : NinjaTargetWriter(target, out) {}
 
 NinjaCopyTargetWriter::~NinjaCopyTargetWriter() = default;
@@ -53,7 +53,7 @@ void NinjaCopyTargetWriter::Run() {
 
   std::vector<OutputFile> output_files;
   WriteCopyRules(&output_files);
-  out_ << std::endl;
+  out_ << '\n';
   WriteStampForTarget(output_files, std::vector<OutputFile>());
 }
 
@@ -119,6 +119,6 @@ void NinjaCopyTargetWriter::WriteCopyRules(
       path_output_.WriteFiles(out_, input_deps);
       path_output_.WriteFiles(out_, data_outs);
     }
-    out_ << std::endl;
+    out_ << '\n';
   }
 }
@@ -3,7 +3,6 @@
 // found in the LICENSE file.
 
 #include <algorithm>
-#include <sstream>
 
 #include "gn/ninja_copy_target_writer.h"
 #include "gn/target.h"
@@ -27,7 +26,7 @@ TEST(NinjaCopyTargetWriter, Run) {
   target.SetToolchain(setup.toolchain());
   ASSERT_TRUE(target.OnResolved(&err));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaCopyTargetWriter writer(&target, out);
   writer.Run();
 
@@ -56,7 +55,7 @@ TEST(NinjaCopyTargetWriter, ToolchainDeps) {
   target.SetToolchain(setup.toolchain());
   ASSERT_TRUE(target.OnResolved(&err));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaCopyTargetWriter writer(&target, out);
   writer.Run();
 
@@ -81,7 +80,7 @@ TEST(NinjaCopyTargetWriter, OrderOnlyDeps) {
   target.SetToolchain(setup.toolchain());
   ASSERT_TRUE(target.OnResolved(&err));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaCopyTargetWriter writer(&target, out);
   writer.Run();
 
@@ -113,7 +112,7 @@ TEST(NinjaCopyTargetWriter, DataDeps) {
   target.SetToolchain(setup.toolchain());
   ASSERT_TRUE(target.OnResolved(&err));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaCopyTargetWriter writer(&target, out);
   writer.Run();
 
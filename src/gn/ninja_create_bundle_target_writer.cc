@@ -67,7 +67,7 @@ bool EnsureAllToolsAvailable(const Target* target) {
 
 NinjaCreateBundleTargetWriter::NinjaCreateBundleTargetWriter(
     const Target* target,
-    std::ostream& out)
+    StringOutputBuffer& out)
     : NinjaTargetWriter(target, out) {}
 
 NinjaCreateBundleTargetWriter::~NinjaCreateBundleTargetWriter() = default;
@@ -102,7 +102,7 @@ void NinjaCreateBundleTargetWriter::Run() {
       OutputFile(settings_->build_settings(),
                  target_->bundle_data().GetBundleRootDirOutput(settings_)));
   out_ << ": phony " << target_->dependency_output_file().value();
-  out_ << std::endl;
+  out_ << '\n';
 }
 
 std::string NinjaCreateBundleTargetWriter::WriteCodeSigningRuleDefinition() {
@@ -114,7 +114,7 @@ std::string NinjaCreateBundleTargetWriter::WriteCodeSigningRuleDefinition() {
   base::ReplaceChars(custom_rule_name, ":/()", "_", &custom_rule_name);
   custom_rule_name.append("_code_signing_rule");
 
-  out_ << "rule " << custom_rule_name << std::endl;
+  out_ << "rule " << custom_rule_name << '\n';
   out_ << "  command = ";
   path_output_.WriteFile(out_, settings_->build_settings()->python_path());
   out_ << " ";
@@ -128,10 +128,10 @@ std::string NinjaCreateBundleTargetWriter::WriteCodeSigningRuleDefinition() {
     out_ << " ";
     SubstitutionWriter::WriteWithNinjaVariables(arg, args_escape_options, out_);
   }
-  out_ << std::endl;
-  out_ << "  description = CODE SIGNING " << target_label << std::endl;
-  out_ << "  restat = 1" << std::endl;
-  out_ << std::endl;
+  out_ << '\n';
+  out_ << "  description = CODE SIGNING " << target_label << '\n';
+  out_ << "  restat = 1" << '\n';
+  out_ << '\n';
 
   return custom_rule_name;
 }
@@ -172,7 +172,7 @@ void NinjaCreateBundleTargetWriter::WriteCopyBundleFileRuleSteps(
       path_output_.WriteFiles(out_, order_only_deps);
     }
 
-    out_ << std::endl;
+    out_ << '\n';
   }
 }
 
@@ -213,7 +213,7 @@ void NinjaCreateBundleTargetWriter::WriteCompileAssetsCatalogStep(
       out_ << " ||";
       path_output_.WriteFiles(out_, order_only_deps);
     }
-    out_ << std::endl;
+    out_ << '\n';
     return;
   }
 
@@ -250,15 +250,15 @@ void NinjaCreateBundleTargetWriter::WriteCompileAssetsCatalogStep(
     path_output_.WriteFiles(out_, order_only_deps);
   }
 
-  out_ << std::endl;
+  out_ << '\n';
 
   out_ << "  product_type = " << target_->bundle_data().product_type()
-       << std::endl;
+       << '\n';
 
   if (partial_info_plist != OutputFile()) {
     out_ << "  partial_info_plist = ";
     path_output_.WriteFile(out_, partial_info_plist);
-    out_ << std::endl;
+    out_ << '\n';
   }
 
   const std::vector<SubstitutionPattern>& flags =
@@ -272,7 +272,7 @@ void NinjaCreateBundleTargetWriter::WriteCompileAssetsCatalogStep(
       SubstitutionWriter::WriteWithNinjaVariables(flag, args_escape_options,
                                                   out_);
     }
-    out_ << std::endl;
+    out_ << '\n';
   }
 }
 
@@ -297,7 +297,7 @@ NinjaCreateBundleTargetWriter::WriteCompileAssetsCatalogInputDepsStamp(
     out_ << " ";
     path_output_.WriteFile(out_, target->dependency_output_file());
   }
-  out_ << std::endl;
+  out_ << '\n';
   return xcassets_input_stamp_file;
 }
 
@@ -327,7 +327,7 @@ void NinjaCreateBundleTargetWriter::WriteCodeSigningStep(
   out_ << ": " << code_signing_rule_name;
   out_ << " | ";
   path_output_.WriteFile(out_, code_signing_input_stamp_file);
-  out_ << std::endl;
+  out_ << '\n';
 }
 
 OutputFile NinjaCreateBundleTargetWriter::WriteCodeSigningInputDepsStamp(
@@ -367,6 +367,6 @@ OutputFile NinjaCreateBundleTargetWriter::WriteCodeSigningInputDepsStamp(
     out_ << " ||";
     path_output_.WriteFiles(out_, order_only_deps);
   }
-  out_ << std::endl;
+  out_ << '\n';
   return code_signing_input_stamp_file;
 }
@@ -58,7 +58,7 @@ TEST_F(NinjaGeneratedFileTargetWriterTest, Run) {
   target.SetToolchain(setup.toolchain());
   ASSERT_TRUE(target.OnResolved(&err)) << err.message();
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaGeneratedFileTargetWriter writer(&target, out);
   writer.Run();
 
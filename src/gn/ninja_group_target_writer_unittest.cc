@@ -49,7 +49,7 @@ TEST(NinjaGroupTargetWriter, Run) {
   target.SetToolchain(setup.toolchain());
   ASSERT_TRUE(target.OnResolved(&err));
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   NinjaGroupTargetWriter writer(&target, out);
   writer.Run();
 
@@ -4,8 +4,6 @@
 
 #include "gn/ninja_rust_binary_target_writer.h"
 
-#include <sstream>
-
 #include "base/strings/string_util.h"
 #include "gn/deps_iterator.h"
 #include "gn/filesystem_utils.h"
@@ -29,16 +27,16 @@ EscapeOptions GetFlagOptions() {
 void WriteVar(const char* name,
               const std::string& value,
               EscapeOptions opts,
-              std::ostream& out) {
+              StringOutputBuffer& out) {
   out << name << " = ";
   EscapeStringToStream(out, value, opts);
-  out << std::endl;
+  out << '\n';
 }
 
 void WriteCrateVars(const Target* target,
                     const Tool* tool,
                     EscapeOptions opts,
-                    std::ostream& out) {
+                    StringOutputBuffer& out) {
   WriteVar(kRustSubstitutionCrateName.ninja_name,
            target->rust_values().crate_name(), opts, out);
 
@@ -99,8 +97,9 @@ void WriteCrateVars(const Target* target,
 
 }  // namespace
 
-NinjaRustBinaryTargetWriter::NinjaRustBinaryTargetWriter(const Target* target,
-                                                         std::ostream& out)
+NinjaRustBinaryTargetWriter::NinjaRustBinaryTargetWriter(
+    const Target* target,
+    StringOutputBuffer& out)
     : NinjaBinaryTargetWriter(target, out),
       tool_(target->toolchain()->GetToolForTargetFinalOutputAsRust(target)) {}
 
@@ -243,7 +242,7 @@ void NinjaRustBinaryTargetWriter::WriteSourcesAndInputs() {
     out_ << " ";
     path_output_.WriteFile(out_, OutputFile(settings_->build_settings(), data));
   }
-  out_ << std::endl;
+  out_ << '\n';
 }
 
 void NinjaRustBinaryTargetWriter::WriteExterns(
@@ -283,7 +282,7 @@ void NinjaRustBinaryTargetWriter::WriteExterns(
     }
   }
 
-  out_ << std::endl;
+  out_ << '\n';
 }
 
 void NinjaRustBinaryTargetWriter::WriteRustdeps(
@@ -331,8 +330,8 @@ void NinjaRustBinaryTargetWriter::WriteRustdeps(
   }
   WriteLibrarySearchPath(out_, tool_);
   WriteLibs(out_, tool_);
-  out_ << std::endl;
+  out_ << '\n';
   out_ << "  ldflags =";
   WriteCustomLinkerFlags(out_, tool_);
-  out_ << std::endl;
+  out_ << '\n';
 }
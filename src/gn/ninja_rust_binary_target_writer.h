@@ -14,7 +14,7 @@ struct EscapeOptions;
 // library, or a static library).
 class NinjaRustBinaryTargetWriter : public NinjaBinaryTargetWriter {
  public:
-  NinjaRustBinaryTargetWriter(const Target* target, std::ostream& out);
+  NinjaRustBinaryTargetWriter(const Target* target, StringOutputBuffer& out);
   ~NinjaRustBinaryTargetWriter() override;
 
   void Run() override;
@@ -47,7 +47,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, RustExecutable) {
   ASSERT_TRUE(target.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -90,7 +90,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, RlibDeps) {
   ASSERT_TRUE(rlib.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&rlib, out);
     writer.Run();
 
@@ -142,7 +142,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, RlibDeps) {
   ASSERT_TRUE(target.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -186,7 +186,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, DylibDeps) {
   ASSERT_TRUE(dylib.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&dylib, out);
     writer.Run();
 
@@ -239,7 +239,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, DylibDeps) {
   ASSERT_TRUE(target.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -283,7 +283,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, RlibDepsAcrossGroups) {
   ASSERT_TRUE(procmacro.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&procmacro, out);
     writer.Run();
 
@@ -329,7 +329,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, RlibDepsAcrossGroups) {
   ASSERT_TRUE(rlib.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&rlib, out);
     writer.Run();
 
@@ -369,7 +369,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, RlibDepsAcrossGroups) {
   ASSERT_TRUE(target.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -426,7 +426,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, RenamedDeps) {
   ASSERT_TRUE(target.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -522,7 +522,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, NonRustDeps) {
   ASSERT_TRUE(nonrust.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&nonrust, out);
     writer.Run();
 
@@ -567,7 +567,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, NonRustDeps) {
   ASSERT_TRUE(nonrust_only.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&nonrust_only, out);
     writer.Run();
 
@@ -606,7 +606,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, NonRustDeps) {
   ASSERT_TRUE(rstaticlib.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&rstaticlib, out);
     writer.Run();
 
@@ -653,7 +653,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, RustOutputExtensionAndDir) {
   ASSERT_TRUE(target.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -699,7 +699,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, LibsAndLibDirs) {
   ASSERT_TRUE(target.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -759,7 +759,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, RustProcMacro) {
   ASSERT_TRUE(procmacro.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&procmacro, out);
     writer.Run();
 
@@ -798,7 +798,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, RustProcMacro) {
   ASSERT_TRUE(target.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -841,7 +841,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, GroupDeps) {
   ASSERT_TRUE(rlib.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&rlib, out);
     writer.Run();
 
@@ -887,7 +887,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, GroupDeps) {
   ASSERT_TRUE(target.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -938,7 +938,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, Externs) {
   ASSERT_TRUE(target.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -984,7 +984,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, Inputs) {
   ASSERT_TRUE(target.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -1028,7 +1028,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, CdylibDeps) {
   cdylib.SetToolchain(setup.toolchain());
   ASSERT_TRUE(cdylib.OnResolved(&err));
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&cdylib, out);
     writer.Run();
     const char expected[] =
@@ -1065,7 +1065,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, CdylibDeps) {
   target.SetToolchain(setup.toolchain());
   ASSERT_TRUE(target.OnResolved(&err));
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&target, out);
     writer.Run();
 
@@ -1140,7 +1140,7 @@ TEST_F(NinjaRustBinaryTargetWriterTest, TransitivePublicNonRustDeps) {
   ASSERT_TRUE(target.OnResolved(&err));
 
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     NinjaRustBinaryTargetWriter writer(&target, out);
     writer.Run();
 
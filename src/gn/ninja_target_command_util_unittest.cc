@@ -5,7 +5,6 @@
 #include "gn/ninja_target_command_util.h"
 
 #include <algorithm>
-#include <sstream>
 
 #include "util/build_config.h"
 #include "util/test/test.h"
@@ -16,7 +15,7 @@ namespace {
 // the generated output as a string.
 template <typename Writer, typename Item>
 std::string FormatWithWriter(Writer writer, std::vector<Item> items) {
-  std::ostringstream out;
+  StringOutputBuffer out;
   for (const Item& item : items) {
     writer(item, out);
   }
@@ -36,7 +35,7 @@ void TestWriter(Writer writer,
   // see the difference in the error message (by default the error message
   // would just be "formatted == expected").
   if (formatted != expected) {
-    std::ostringstream stream;
+    StringOutputBuffer stream;
     stream << '"' << expected << "\" == \"" << formatted << '"';
     std::string message = stream.str();
 
@@ -4,7 +4,7 @@
 
 #include "gn/ninja_target_writer.h"
 
-#include <sstream>
+#include <memory>
 
 #include "base/files/file_util.h"
 #include "base/strings/string_util.h"
@@ -22,6 +22,7 @@
 #include "gn/ninja_group_target_writer.h"
 #include "gn/ninja_utils.h"
 #include "gn/output_file.h"
+#include "gn/output_writer.h"
 #include "gn/scheduler.h"
 #include "gn/string_output_buffer.h"
 #include "gn/string_utils.h"
@@ -29,7 +30,8 @@
 #include "gn/target.h"
 #include "gn/trace.h"
 
-NinjaTargetWriter::NinjaTargetWriter(const Target* target, std::ostream& out)
+NinjaTargetWriter::NinjaTargetWriter(const Target* target,
+                                     StringOutputBuffer& out)
     : settings_(target->settings()),
       target_(target),
       out_(out),
@@ -40,10 +42,11 @@ NinjaTargetWriter::NinjaTargetWriter(const Target* target, std::ostream& out)
 NinjaTargetWriter::~NinjaTargetWriter() = default;
 
 // static
-std::string NinjaTargetWriter::RunAndWriteFile(const Target* target) {
+void NinjaTargetWriter::RunAndWriteFile(const Target* target,
+                                        StringOutputBuffer* rules_buffer) {
   const Settings* settings = target->settings();
 
-  ScopedTrace trace(TraceItem::TRACE_FILE_WRITE,
+  ScopedTrace trace(TraceItem::TRACE_TARGET_WRITE,
                     target->label().GetUserVisibleName(false));
   trace.SetToolchain(settings->toolchain_label());
 
@@ -51,9 +54,10 @@ std::string NinjaTargetWriter::RunAndWriteFile(const Target* target) {
     g_scheduler->Log("Computing", target->label().GetUserVisibleName(true));
 
   // It's ridiculously faster to write to a string and then write that to
-  // disk in one operation than to use an fstream here.
-  StringOutputBuffer storage;
-  std::ostream rules(&storage);
+  // disk in one operation than to use an fstream here. Binary targets are
+  // written to |storage|, other targets straight to |rules_buffer|.
+  auto storage = std::make_unique<StringOutputBuffer>();
+  StringOutputBuffer& rules = target->IsBinary() ? *storage : *rules_buffer;
 
   // Call out to the correct sub-type of writer. Binary targets need to be
   // written to separate files for compiler flag scoping, but other target
@@ -103,22 +107,21 @@ std::string NinjaTargetWriter::RunAndWriteFile(const Target* target) {
     SourceFile ninja_file = GetNinjaFileForTarget(target);
     base::FilePath full_ninja_file =
         settings->build_settings()->GetFullPath(ninja_file);
-    storage.WriteToFileIfChanged(full_ninja_file, nullptr);
+    if (g_output_writer)
+      g_output_writer->WriteFileIfChanged(full_ninja_file, std::move(storage));
+    else
+      storage->WriteToFileIfChanged(full_ninja_file, nullptr);
 
     EscapeOptions options;
     options.mode = ESCAPE_NINJA;
 
-    // Return the subninja command to load the rules file.
-    std::string result = "subninja ";
-    result.append(EscapeString(
+    // Append the subninja command to load the rules file.
+    rules_buffer->Append("subninja ");
+    rules_buffer->Append(EscapeString(
         OutputFile(target->settings()->build_settings(), ninja_file).value(),
         options, nullptr));
-    result.push_back('\n');
-    return result;
+    rules_buffer->Append('\n');
   }
-
-  // No separate file required, just return the rules.
-  return storage.str();
 }
 
 void NinjaTargetWriter::WriteEscapedSubstitution(const Substitution* type) {
@@ -128,7 +131,7 @@ void NinjaTargetWriter::WriteEscapedSubstitution(const Substitution* type) {
   out_ << type->ninja_name << " = ";
   EscapeStringToStream(
       out_, SubstitutionWriter::GetTargetSubstitution(target_, type), opts);
-  out_ << std::endl;
+  out_ << '\n';
 }
 
 void NinjaTargetWriter::WriteSharedVars(const SubstitutionBits& bits) {
@@ -185,7 +188,7 @@ void NinjaTargetWriter::WriteSharedVars(const SubstitutionBits& bits) {
   // If we wrote any vars, separate them from the rest of the file that follows
   // with a blank line.
   if (written_anything)
-    out_ << std::endl;
+    out_ << '\n';
 }
 
 std::vector<OutputFile> NinjaTargetWriter::WriteInputDepsStampAndGetDep(
@@ -338,5 +341,5 @@ void NinjaTargetWriter::WriteStampForTarget(
     out_ << " ||";
     path_output_.WriteFiles(out_, order_only_deps);
   }
-  out_ << std::endl;
+  out_ << '\n';
 }
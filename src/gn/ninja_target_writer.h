@@ -5,9 +5,8 @@
 #ifndef TOOLS_GN_NINJA_TARGET_WRITER_H_
 #define TOOLS_GN_NINJA_TARGET_WRITER_H_
 
-#include <iosfwd>
-
 #include "gn/path_output.h"
+#include "gn/string_output_buffer.h"
 #include "gn/substitution_type.h"
 
 class OutputFile;
@@ -19,17 +18,18 @@ struct SubstitutionBits;
 // generated by the NinjaBuildWriter.
 class NinjaTargetWriter {
  public:
-  NinjaTargetWriter(const Target* target, std::ostream& out);
+  NinjaTargetWriter(const Target* target, StringOutputBuffer& out);
   virtual ~NinjaTargetWriter();
 
-  // Returns the build line to be written to the toolchain build file.
+  // Appends the build line to be written to the toolchain build file to
+  // |rules|.
   //
   // Some targets have their rules written to separate files, and some can have
   // their rules coalesced in the main build file. For the coalesced case, this
-  // function will return the rules as a string. For the separate file case,
-  // the separate ninja file will be written and the return string will be the
-  // subninja command to load that file.
-  static std::string RunAndWriteFile(const Target* target);
+  // function will stream the rules directly into |rules|. For the separate
+  // file case, the separate ninja file will be written and the subninja
+  // command to load that file will be appended.
+  static void RunAndWriteFile(const Target* target, StringOutputBuffer* rules);
 
   virtual void Run() = 0;
 
@@ -58,7 +58,7 @@ class NinjaTargetWriter {
 
   const Settings* settings_;  // Non-owning.
   const Target* target_;      // Non-owning.
-  std::ostream& out_;
+  StringOutputBuffer& out_;
   PathOutput path_output_;
 
  private:
@@ -2,8 +2,6 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
-#include <sstream>
-
 #include "gn/ninja_action_target_writer.h"
 #include "gn/ninja_target_writer.h"
 #include "gn/target.h"
@@ -16,7 +14,7 @@ class TestingNinjaTargetWriter : public NinjaTargetWriter {
  public:
   TestingNinjaTargetWriter(const Target* target,
                            const Toolchain* toolchain,
-                           std::ostream& out)
+                           StringOutputBuffer& out)
       : NinjaTargetWriter(target, out) {}
 
   void Run() override {}
@@ -69,7 +67,7 @@ TEST(NinjaTargetWriter, WriteInputDepsStampAndGetDep) {
 
   // Input deps for the base (should be only the script itself).
   {
-    std::ostringstream stream;
+    StringOutputBuffer stream;
     TestingNinjaTargetWriter writer(&base_target, setup.toolchain(), stream);
     std::vector<OutputFile> dep =
         writer.WriteInputDepsStampAndGetDep(std::vector<const Target*>(), 10u);
@@ -83,7 +81,7 @@ TEST(NinjaTargetWriter, WriteInputDepsStampAndGetDep) {
 
   // Input deps for the target (should depend on the base).
   {
-    std::ostringstream stream;
+    StringOutputBuffer stream;
     TestingNinjaTargetWriter writer(&target, setup.toolchain(), stream);
     std::vector<OutputFile> dep =
         writer.WriteInputDepsStampAndGetDep(std::vector<const Target*>(), 10u);
@@ -95,7 +93,7 @@ TEST(NinjaTargetWriter, WriteInputDepsStampAndGetDep) {
   }
 
   {
-    std::ostringstream stream;
+    StringOutputBuffer stream;
     NinjaActionTargetWriter writer(&action, stream);
     writer.Run();
     EXPECT_EQ(
@@ -114,7 +112,7 @@ TEST(NinjaTargetWriter, WriteInputDepsStampAndGetDep) {
   // Input deps for action which should depend on the base since its a hard dep
   // that is a (indirect) dependency, as well as the the action source.
   {
-    std::ostringstream stream;
+    StringOutputBuffer stream;
     TestingNinjaTargetWriter writer(&action, setup.toolchain(), stream);
     std::vector<OutputFile> dep =
         writer.WriteInputDepsStampAndGetDep(std::vector<const Target*>(), 10u);
@@ -150,7 +148,7 @@ TEST(NinjaTargetWriter, WriteInputDepsStampAndGetDepWithToolchainDeps) {
   target.SetToolchain(setup.toolchain());
   ASSERT_TRUE(target.OnResolved(&err));
 
-  std::ostringstream stream;
+  StringOutputBuffer stream;
   TestingNinjaTargetWriter writer(&target, setup.toolchain(), stream);
   std::vector<OutputFile> dep =
       writer.WriteInputDepsStampAndGetDep(std::vector<const Target*>(), 10u);
@@ -4,17 +4,16 @@
 
 #include "gn/ninja_toolchain_writer.h"
 
-#include <fstream>
-
-#include "base/files/file_util.h"
 #include "base/strings/stringize_macros.h"
 #include "gn/build_settings.h"
 #include "gn/c_tool.h"
+#include "gn/file_writer.h"
 #include "gn/filesystem_utils.h"
 #include "gn/general_tool.h"
 #include "gn/ninja_utils.h"
 #include "gn/pool.h"
 #include "gn/settings.h"
+#include "gn/string_output_buffer.h"
 #include "gn/substitution_writer.h"
 #include "gn/target.h"
 #include "gn/toolchain.h"
@@ -28,7 +27,7 @@ const char kIndent[] = "  ";
 
 NinjaToolchainWriter::NinjaToolchainWriter(const Settings* settings,
                                            const Toolchain* toolchain,
-                                           std::ostream& out)
+                                           StringOutputBuffer& out)
     : settings_(settings),
       toolchain_(toolchain),
       out_(out),
@@ -38,8 +37,7 @@ NinjaToolchainWriter::NinjaToolchainWriter(const Settings* settings,
 
 NinjaToolchainWriter::~NinjaToolchainWriter() = default;
 
-void NinjaToolchainWriter::Run(
-    const std::vector<NinjaWriter::TargetRulePair>& rules) {
+void NinjaToolchainWriter::Run() {
   std::string rule_prefix = GetNinjaRulePrefixForToolchain(settings_);
 
   for (const auto& tool : toolchain_->tools()) {
@@ -47,37 +45,43 @@ void NinjaToolchainWriter::Run(
       continue;
     WriteToolRule(tool.second.get(), rule_prefix);
   }
-  out_ << std::endl;
-
-  for (const auto& pair : rules)
-    out_ << pair.second;
+  out_ << '\n';
 }
 
 // static
 bool NinjaToolchainWriter::RunAndWriteFile(
     const Settings* settings,
     const Toolchain* toolchain,
-    const std::vector<NinjaWriter::TargetRulePair>& rules) {
+    const std::vector<NinjaWriter::TargetRules>& rules) {
   base::FilePath ninja_file(settings->build_settings()->GetFullPath(
       GetNinjaFileForToolchain(settings)));
   ScopedTrace trace(TraceItem::TRACE_FILE_WRITE, FilePathToUTF8(ninja_file));
 
-  base::CreateDirectory(ninja_file.DirName());
+  StringOutputBuffer tool_rules;
+  NinjaToolchainWriter gen(settings, toolchain, tool_rules);
+  gen.Run();
 
-  std::ofstream file;
-  file.open(FilePathToUTF8(ninja_file).c_str(),
-            std::ios_base::out | std::ios_base::binary);
-  if (file.fail())
+  // Stream the target rules to the file rather than copying them all in
+  // another buffer first.
+  if (!CreateDirectoryCached(ninja_file.DirName()))
     return false;
-
-  NinjaToolchainWriter gen(settings, toolchain, file);
-  gen.Run(rules);
-  return true;
+  FileWriter writer;
+  bool success = writer.Create(ninja_file) &&
+                 tool_rules.WriteRange(&writer, 0, tool_rules.size());
+  for (const auto& target_rules : rules) {
+    if (!success)
+      break;
+    success = target_rules.buffer->WriteRange(&writer, target_rules.begin,
+                                              target_rules.end);
+  }
+  if (!writer.Close())
+    success = false;
+  return success;
 }
 
 void NinjaToolchainWriter::WriteToolRule(Tool* tool,
                                          const std::string& rule_prefix) {
-  out_ << "rule " << rule_prefix << tool->name() << std::endl;
+  out_ << "rule " << rule_prefix << tool->name() << '\n';
 
   // Rules explicitly include shell commands, so don't try to escape.
   EscapeOptions options;
@@ -95,26 +99,26 @@ void NinjaToolchainWriter::WriteToolRule(Tool* tool,
       // GCC-style deps require a depfile.
       if (!c_tool->depfile().empty()) {
         WriteRulePattern("depfile", tool->depfile(), options);
-        out_ << kIndent << "deps = gcc" << std::endl;
+        out_ << kIndent << "deps = gcc" << '\n';
       }
     } else if (c_tool->depsformat() == CTool::DEPS_MSVC) {
       // MSVC deps don't have a depfile.
-      out_ << kIndent << "deps = msvc" << std::endl;
+      out_ << kIndent << "deps = msvc" << '\n';
     }
   } else if (!tool->depfile().empty()) {
     WriteRulePattern("depfile", tool->depfile(), options);
-    out_ << kIndent << "deps = gcc" << std::endl;
+    out_ << kIndent << "deps = gcc" << '\n';
   }
 
   // Use pool is specified.
   if (tool->pool().ptr) {
     std::string pool_name =
         tool->pool().ptr->GetNinjaName(settings_->default_toolchain_label());
-    out_ << kIndent << "pool = " << pool_name << std::endl;
+    out_ << kIndent << "pool = " << pool_name << '\n';
   }
 
   if (tool->restat())
-    out_ << kIndent << "restat = 1" << std::endl;
+    out_ << kIndent << "restat = 1" << '\n';
 }
 
 void NinjaToolchainWriter::WriteRulePattern(const char* name,
@@ -124,7 +128,7 @@ void NinjaToolchainWriter::WriteRulePattern(const char* name,
     return;
   out_ << kIndent << name << " = ";
   SubstitutionWriter::WriteWithNinjaVariables(pattern, options, out_);
-  out_ << std::endl;
+  out_ << '\n';
 }
 
 void NinjaToolchainWriter::WriteCommandRulePattern(
@@ -137,5 +141,5 @@ void NinjaToolchainWriter::WriteCommandRulePattern(
   if (!launcher.empty())
     out_ << launcher << " ";
   SubstitutionWriter::WriteWithNinjaVariables(command, options, out_);
-  out_ << std::endl;
+  out_ << '\n';
 }
@@ -5,7 +5,6 @@
 #ifndef TOOLS_GN_NINJA_TOOLCHAIN_WRITER_H_
 #define TOOLS_GN_NINJA_TOOLCHAIN_WRITER_H_
 
-#include <iosfwd>
 #include <set>
 #include <string>
 #include <vector>
@@ -17,6 +16,7 @@
 
 struct EscapeOptions;
 class Settings;
+class StringOutputBuffer;
 class Tool;
 
 class NinjaToolchainWriter {
@@ -26,7 +26,7 @@ class NinjaToolchainWriter {
   static bool RunAndWriteFile(
       const Settings* settings,
       const Toolchain* toolchain,
-      const std::vector<NinjaWriter::TargetRulePair>& rules);
+      const std::vector<NinjaWriter::TargetRules>& rules);
 
  private:
   FRIEND_TEST_ALL_PREFIXES(NinjaToolchainWriter, WriteToolRule);
@@ -34,10 +34,12 @@ class NinjaToolchainWriter {
 
   NinjaToolchainWriter(const Settings* settings,
                        const Toolchain* toolchain,
-                       std::ostream& out);
+                       StringOutputBuffer& out);
   ~NinjaToolchainWriter();
 
-  void Run(const std::vector<NinjaWriter::TargetRulePair>& extra_rules);
+  // Writes the tool rules. The rules of the targets are appended to the file
+  // directly from the buffers of the target writers.
+  void Run();
 
   void WriteRules();
   void WriteToolRule(Tool* tool, const std::string& rule_prefix);
@@ -51,7 +53,7 @@ class NinjaToolchainWriter {
 
   const Settings* settings_;
   const Toolchain* toolchain_;
-  std::ostream& out_;
+  StringOutputBuffer& out_;
   PathOutput path_output_;
 
   NinjaToolchainWriter(const NinjaToolchainWriter&) = delete;
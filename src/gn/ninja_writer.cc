@@ -4,6 +4,8 @@
 
 #include "gn/ninja_writer.h"
 
+#include <algorithm>
+
 #include "gn/builder.h"
 #include "gn/loader.h"
 #include "gn/location.h"
@@ -11,6 +13,7 @@
 #include "gn/ninja_toolchain_writer.h"
 #include "gn/settings.h"
 #include "gn/target.h"
+#include "util/worker_pool.h"
 
 NinjaWriter::NinjaWriter(const Builder& builder) : builder_(builder) {}
 
@@ -36,16 +39,29 @@ bool NinjaWriter::WriteToolchains(const PerToolchainRules& per_toolchain_rules,
     return false;
   }
 
-  for (const auto& i : per_toolchain_rules) {
-    const Toolchain* toolchain = i.first;
-    const Settings* settings =
-        builder_.loader()->GetToolchainSettings(toolchain->label());
-    if (!NinjaToolchainWriter::RunAndWriteFile(settings, toolchain, i.second)) {
-      *err =
-          Err(Location(), "Couldn't open toolchain buildfile(s) for writing");
-      return false;
+  // Each toolchain file can be hundreds of MB for large builds, and they are
+  // independent of each other, so write them in parallel.
+  std::vector<char> succeeded(per_toolchain_rules.size(), false);
+  {
+    TaskGroup tasks(WorkerPool::Get());
+    size_t index = 0;
+    for (const auto& i : per_toolchain_rules) {
+      const Toolchain* toolchain = i.first;
+      const Settings* settings =
+          builder_.loader()->GetToolchainSettings(toolchain->label());
+      tasks.PostTask([settings, toolchain, rules = &i.second,
+                     result = &succeeded[index++]]() {
+        *result =
+            NinjaToolchainWriter::RunAndWriteFile(settings, toolchain, *rules);
+      });
     }
+    // Destroying the group waits for all the posted tasks to complete.
   }
 
+  if (std::find(succeeded.begin(), succeeded.end(), false) !=
+      succeeded.end()) {
+    *err = Err(Location(), "Couldn't open toolchain buildfile(s) for writing");
+    return false;
+  }
   return true;
 }
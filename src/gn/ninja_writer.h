@@ -13,21 +13,29 @@
 class Builder;
 class BuildSettings;
 class Err;
+class StringOutputBuffer;
 class Target;
 class Toolchain;
 
 class NinjaWriter {
  public:
-  // Combines a target and the computed build rule for it.
-  using TargetRulePair = std::pair<const Target*, std::string>;
+  // Combines a target and the computed build rules for it. The rules are
+  // stored as the [begin, end) range of an output buffer shared with other
+  // targets, which must outlive this object.
+  struct TargetRules {
+    const Target* target;
+    const StringOutputBuffer* buffer;
+    size_t begin;
+    size_t end;
+  };
 
   // Associates the build rules with each toolchain.
   using PerToolchainRules =
-      std::map<const Toolchain*, std::vector<TargetRulePair>>;
+      std::map<const Toolchain*, std::vector<TargetRules>>;
 
   // On failure will populate |err| and will return false.  The map contains
   // the per-toolchain set of rules collected to write to the toolchain build
-  // files.
+  // files. The toolchain build files are written concurrently.
   static bool RunAndWriteFiles(const BuildSettings* build_settings,
                                const Builder& builder,
                                const PerToolchainRules& per_toolchain_rules,
@@ -4,18 +4,108 @@
 
 #include "gn/output_file.h"
 
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
 #include "gn/filesystem_utils.h"
 #include "gn/source_file.h"
 
+namespace {
+
+// Identifies the rebasing of a source directory to a build directory. All the
+// strings are atoms so they are compared by address.
+struct RebasedDirKey {
+  const std::string* dir;
+  const std::string* build_dir;
+  const std::string* root_path;
+
+  bool operator==(const RebasedDirKey& other) const {
+    return dir == other.dir && build_dir == other.build_dir &&
+           root_path == other.root_path;
+  }
+};
+
+struct RebasedDirKeyHash {
+  size_t operator()(const RebasedDirKey& key) const {
+    size_t hash = std::hash<const void*>()(key.dir);
+    hash = hash * 31 + std::hash<const void*>()(key.build_dir);
+    return hash * 31 + std::hash<const void*>()(key.root_path);
+  }
+};
+
+struct RebasedDir {
+  // What to prepend to the file names, ending with a slash or empty.
+  std::string prefix;
+
+  // False if RebasePath() must be called for each file instead, like when the
+  // directory contains the build directory: a file with the same path as one
+  // of the parents of the build directory is rebased to ".".
+  bool usable;
+};
+
+// Returns |dir| rebased to the build directory. The same directories are
+// rebased for every file and every target in them, so the results are
+// memoized. Like SourceFile::GetInfo, each thread has its own memo so the
+// global mutex is only taken on a miss. Results are never freed, and deques
+// never move their elements.
+const RebasedDir& GetRebasedDir(const BuildSettings* build_settings,
+                                const SourceDir& dir) {
+  using RebasedDirMap =
+      std::unordered_map<RebasedDirKey, const RebasedDir*, RebasedDirKeyHash>;
+  static std::mutex& mutex = *new std::mutex;
+  static RebasedDirMap& rebased_dirs = *new RebasedDirMap;
+  static std::deque<RebasedDir>& storage = *new std::deque<RebasedDir>;
+  thread_local RebasedDirMap local_rebased_dirs;
+
+  RebasedDirKey key{&dir.value(), &build_settings->build_dir().value(),
+                    &build_settings->root_path_utf8()};
+  const RebasedDir*& local_rebased = local_rebased_dirs[key];
+  if (local_rebased)
+    return *local_rebased;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  const RebasedDir*& rebased = rebased_dirs[key];
+  if (!rebased) {
+    std::string prefix;
+    bool usable = true;
+    if (dir != build_settings->build_dir()) {
+      prefix = RebasePath(dir.value(), build_settings->build_dir(),
+                          build_settings->root_path_utf8());
+      // Only made of "../" for the parents of the build directory.
+      size_t i = 0;
+      while (prefix.compare(i, 3, "../") == 0)
+        i += 3;
+      usable = i < prefix.size() && prefix.back() == '/';
+    }
+    storage.push_back({std::move(prefix), usable});
+    rebased = &storage.back();
+  }
+  local_rebased = rebased;
+  return *rebased;
+}
+
+}  // namespace
+
 OutputFile::OutputFile(std::string&& v) : value_(std::move(v)) {}
 
 OutputFile::OutputFile(const std::string& v) : value_(v) {}
 
 OutputFile::OutputFile(const BuildSettings* build_settings,
-                       const SourceFile& source_file)
-    : value_(RebasePath(source_file.value(),
-                        build_settings->build_dir(),
-                        build_settings->root_path_utf8())) {}
+                       const SourceFile& source_file) {
+  SourceDir dir = source_file.GetDir();
+  const RebasedDir& rebased_dir = GetRebasedDir(build_settings, dir);
+  if (!rebased_dir.usable) {
+    value_ = RebasePath(source_file.value(), build_settings->build_dir(),
+                        build_settings->root_path_utf8());
+    return;
+  }
+  std::string_view name =
+      std::string_view(source_file.value()).substr(dir.value().size());
+  value_.reserve(rebased_dir.prefix.size() + name.size());
+  value_.append(rebased_dir.prefix);
+  value_.append(name);
+}
 
 SourceFile OutputFile::AsSourceFile(const BuildSettings* build_settings) const {
   DCHECK(!value_.empty());
@@ -0,0 +1,133 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/output_manifest.h"
+
+#include <charconv>
+#include <string_view>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "gn/filesystem_utils.h"
+#include "gn/string_output_buffer.h"
+
+OutputManifest* g_output_manifest = nullptr;
+
+namespace {
+
+const char kHeader[] = "# GN output manifest v1\n";
+
+// Reads a decimal number followed by a space at the beginning of |line| and
+// removes them.
+bool ConsumeNumber(std::string_view* line, uint64_t* value) {
+  const char* end = line->data() + line->size();
+  auto result = std::from_chars(line->data(), end, *value);
+  if (result.ec != std::errc() || result.ptr == end || *result.ptr != ' ')
+    return false;
+  line->remove_prefix(result.ptr + 1 - line->data());
+  return true;
+}
+
+bool GetLastModified(const base::FilePath& file_path,
+                     uint64_t size,
+                     Ticks* last_modified) {
+  base::File::Info info;
+  if (!base::GetFileInfo(file_path, &info) || info.is_directory ||
+      static_cast<uint64_t>(info.size) != size)
+    return false;
+  *last_modified = info.last_modified;
+  return true;
+}
+
+}  // namespace
+
+OutputManifest::OutputManifest() = default;
+
+OutputManifest::~OutputManifest() = default;
+
+void OutputManifest::Load(const base::FilePath& file_path) {
+  std::string contents;
+  base::File::Info manifest_info;
+  if (!base::GetFileInfo(file_path, &manifest_info) ||
+      !base::ReadFileToString(file_path, &contents) ||
+      contents.compare(0, sizeof(kHeader) - 1, kHeader) != 0)
+    return;
+
+  std::lock_guard<std::mutex> lock(lock_);
+  std::string_view remaining(contents);
+  remaining.remove_prefix(sizeof(kHeader) - 1);
+  while (!remaining.empty()) {
+    size_t line_end = remaining.find('\n');
+    if (line_end == std::string_view::npos)
+      break;  // Truncated.
+    std::string_view line = remaining.substr(0, line_end);
+    remaining.remove_prefix(line_end + 1);
+
+    Entry entry;
+    if (!ConsumeNumber(&line, &entry.size) ||
+        !ConsumeNumber(&line, &entry.hash) ||
+        !ConsumeNumber(&line, &entry.last_modified) || line.empty())
+      continue;
+
+    // Like for Ninja and git, a file with the same modification time as the
+    // manifest (or newer) may have been modified again after being recorded
+    // without its modification time changing.
+    entry.trusted = entry.last_modified < manifest_info.last_modified;
+    entries_[std::string(line)] = entry;
+  }
+}
+
+bool OutputManifest::Save(const base::FilePath& file_path, Err* err) const {
+  StringOutputBuffer out;
+  out << kHeader;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    for (const auto& [path, entry] : entries_) {
+      if (!entry.used || !entry.trusted)
+        continue;
+      out << entry.size << ' ' << entry.hash << ' ' << entry.last_modified
+          << ' ' << path << '\n';
+    }
+  }
+  return out.WriteToFile(file_path, err);
+}
+
+bool OutputManifest::IsUnchanged(const base::FilePath& file_path,
+                                 size_t size,
+                                 uint64_t hash) {
+  std::string path = FilePathToUTF8(file_path);
+  Ticks last_modified;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    auto found = entries_.find(path);
+    if (found == entries_.end() || !found->second.trusted ||
+        found->second.size != size || found->second.hash != hash)
+      return false;
+    last_modified = found->second.last_modified;
+  }
+
+  // Only look at the file without the lock held.
+  Ticks file_last_modified;
+  if (!GetLastModified(file_path, size, &file_last_modified) ||
+      file_last_modified != last_modified)
+    return false;
+
+  std::lock_guard<std::mutex> lock(lock_);
+  entries_[path].used = true;
+  return true;
+}
+
+void OutputManifest::Record(const base::FilePath& file_path,
+                            size_t size,
+                            uint64_t hash) {
+  Entry entry;
+  entry.size = size;
+  entry.hash = hash;
+  entry.used = true;
+  entry.trusted = GetLastModified(file_path, size, &entry.last_modified);
+
+  std::lock_guard<std::mutex> lock(lock_);
+  entries_[FilePathToUTF8(file_path)] = entry;
+}
@@ -0,0 +1,83 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TOOLS_GN_OUTPUT_MANIFEST_H_
+#define TOOLS_GN_OUTPUT_MANIFEST_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "util/ticks.h"
+
+namespace base {
+class FilePath;
+}
+
+class Err;
+
+// Remembers the size, content hash and modification time of the files
+// written by "gn gen", so that the next run can tell that an output is
+// unchanged without reading it back: if the new content has the same size and
+// hash, and the file hasn't been modified since it was recorded, there is
+// nothing to write.
+//
+// Anything else (unknown file, different size or hash, different or suspicious
+// modification time) falls back to comparing the contents, so a missing or
+// stale manifest only costs performance.
+//
+// The functions checking and recording outputs are thread-safe.
+class OutputManifest {
+ public:
+  OutputManifest();
+  ~OutputManifest();
+
+  // Loads the manifest saved by a previous run. A missing or invalid file
+  // leaves the manifest empty.
+  void Load(const base::FilePath& file_path);
+
+  // Saves the outputs recorded or found unchanged since the manifest was
+  // loaded. Files that weren't written by this run are dropped.
+  bool Save(const base::FilePath& file_path, Err* err) const;
+
+  // Returns true if the file at |file_path| is known to have the given size and
+  // content hash and hasn't been modified since. This doesn't read the file.
+  bool IsUnchanged(const base::FilePath& file_path,
+                   size_t size,
+                   uint64_t hash);
+
+  // Records that the file at |file_path|, which has just been written or
+  // compared, has the given size and content hash.
+  void Record(const base::FilePath& file_path, size_t size, uint64_t hash);
+
+ private:
+  struct Entry {
+    uint64_t size = 0;
+    uint64_t hash = 0;
+    Ticks last_modified = 0;
+
+    // Whether the modification time can be trusted. It can't when the file may
+    // have been modified again within the timestamp granularity of the file
+    // system after being recorded.
+    bool trusted = false;
+
+    // Whether the file was written or checked by this run.
+    bool used = false;
+  };
+
+  mutable std::mutex lock_;
+  std::unordered_map<std::string, Entry> entries_;
+
+  OutputManifest(const OutputManifest&) = delete;
+  OutputManifest& operator=(const OutputManifest&) = delete;
+};
+
+// The manifest used by StringOutputBuffer::WriteToFileIfChanged(), set by
+// "gn gen". When null, outputs are always compared with their files.
+extern OutputManifest* g_output_manifest;
+
+#endif  // TOOLS_GN_OUTPUT_MANIFEST_H_
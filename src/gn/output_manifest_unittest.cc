@@ -0,0 +1,130 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/output_manifest.h"
+
+#include <string>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "gn/string_output_buffer.h"
+#include "util/test/test.h"
+
+namespace {
+
+Ticks GetLastModified(const base::FilePath& file_path) {
+  base::File::Info info;
+  EXPECT_TRUE(base::GetFileInfo(file_path, &info));
+  return info.last_modified;
+}
+
+// Saves the manifest until its modification time is after the one of
+// |output|, as it is after a real run. Otherwise the entry for |output| isn't
+// trusted when loaded back.
+void SaveAfter(const OutputManifest& manifest,
+               const base::FilePath& manifest_path,
+               const base::FilePath& output) {
+  do {
+    ASSERT_TRUE(manifest.Save(manifest_path, nullptr));
+  } while (GetLastModified(manifest_path) <= GetLastModified(output));
+}
+
+}  // namespace
+
+TEST(OutputManifest, RecordAndCheck) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath output = temp_dir.GetPath().AppendASCII("out.ninja");
+
+  StringOutputBuffer buffer;
+  buffer << "build foo: bar\n";
+  ASSERT_TRUE(buffer.WriteToFile(output, nullptr));
+
+  OutputManifest manifest;
+  EXPECT_FALSE(manifest.IsUnchanged(output, buffer.size(), 1234));
+
+  manifest.Record(output, buffer.size(), 1234);
+  EXPECT_TRUE(manifest.IsUnchanged(output, buffer.size(), 1234));
+  EXPECT_FALSE(manifest.IsUnchanged(output, buffer.size(), 1235));
+  EXPECT_FALSE(manifest.IsUnchanged(output, buffer.size() + 1, 1234));
+
+  base::DeleteFile(output, false);
+  EXPECT_FALSE(manifest.IsUnchanged(output, buffer.size(), 1234));
+}
+
+TEST(OutputManifest, SaveAndLoad) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath output = temp_dir.GetPath().AppendASCII("out.ninja");
+  base::FilePath other =
+      temp_dir.GetPath().AppendASCII("other dir").AppendASCII("b.txt");
+  base::FilePath manifest_path = temp_dir.GetPath().AppendASCII(".gn_outputs");
+
+  StringOutputBuffer buffer;
+  buffer << "build foo: bar\n";
+  uint64_t hash = buffer.ContentsHash();
+  ASSERT_TRUE(buffer.WriteToFile(output, nullptr));
+  ASSERT_TRUE(buffer.WriteToFile(other, nullptr));
+
+  {
+    OutputManifest manifest;
+    manifest.Record(output, buffer.size(), hash);
+    manifest.Record(other, buffer.size(), hash);
+    SaveAfter(manifest, manifest_path, other);
+  }
+
+  {
+    OutputManifest manifest;
+    manifest.Load(manifest_path);
+    EXPECT_TRUE(manifest.IsUnchanged(other, buffer.size(), hash));
+
+    // Only |other| is used by this run, so |output| isn't saved anymore.
+    SaveAfter(manifest, manifest_path, other);
+  }
+
+  {
+    OutputManifest manifest;
+    manifest.Load(manifest_path);
+    EXPECT_FALSE(manifest.IsUnchanged(output, buffer.size(), hash));
+    EXPECT_TRUE(manifest.IsUnchanged(other, buffer.size(), hash));
+
+    // Rewriting the file after the manifest was saved changes its
+    // modification time.
+    ASSERT_TRUE(buffer.WriteToFile(other, nullptr));
+    EXPECT_FALSE(manifest.IsUnchanged(other, buffer.size(), hash));
+  }
+
+  // A missing or invalid manifest is empty.
+  base::WriteFile(manifest_path, "garbage\n", 8);
+  OutputManifest manifest;
+  manifest.Load(manifest_path);
+  EXPECT_FALSE(manifest.IsUnchanged(other, buffer.size(), hash));
+}
+
+TEST(OutputManifest, WriteToFileIfChanged) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath output = temp_dir.GetPath().AppendASCII("out.ninja");
+
+  OutputManifest manifest;
+  g_output_manifest = &manifest;
+
+  StringOutputBuffer buffer;
+  buffer << "build foo: bar\n";
+  EXPECT_TRUE(buffer.WriteToFileIfChanged(output, nullptr));
+  EXPECT_TRUE(manifest.IsUnchanged(output, buffer.size(),
+                                   buffer.ContentsHash()));
+
+  // Different content is written even though the size is the same.
+  StringOutputBuffer changed;
+  changed << "build baz: bar\n";
+  EXPECT_TRUE(changed.WriteToFileIfChanged(output, nullptr));
+  EXPECT_TRUE(changed.ContentsEqual(output));
+  EXPECT_FALSE(manifest.IsUnchanged(output, buffer.size(),
+                                    buffer.ContentsHash()));
+
+  g_output_manifest = nullptr;
+}
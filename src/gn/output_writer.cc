@@ -0,0 +1,85 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/output_writer.h"
+
+#include <utility>
+
+#include "base/logging.h"
+#include "gn/string_output_buffer.h"
+#include "util/worker_pool.h"
+
+OutputWriter* g_output_writer = nullptr;
+
+namespace {
+
+// Number of files written by one task. Small files dominate, so a task per
+// file would mostly measure the cost of posting it.
+constexpr size_t kBatchSize = 16;
+
+}  // namespace
+
+OutputWriter::Request::Request(const base::FilePath& file_path,
+                               std::unique_ptr<StringOutputBuffer> contents)
+    : file_path(file_path), contents(std::move(contents)) {}
+
+OutputWriter::Request::Request(Request&&) = default;
+
+OutputWriter::Request::~Request() = default;
+
+OutputWriter::OutputWriter() = default;
+
+OutputWriter::~OutputWriter() {
+  DCHECK(pending_.empty());
+  DCHECK_EQ(0u, running_batches_);
+}
+
+void OutputWriter::WriteFileIfChanged(
+    const base::FilePath& file_path,
+    std::unique_ptr<StringOutputBuffer> contents) {
+  std::lock_guard<std::mutex> lock(lock_);
+  pending_.emplace_back(file_path, std::move(contents));
+  if (pending_.size() >= kBatchSize)
+    PostPendingLocked();
+}
+
+bool OutputWriter::Flush(Err* err) {
+  std::unique_lock<std::mutex> lock(lock_);
+  if (!pending_.empty())
+    PostPendingLocked();
+  done_.wait(lock, [this]() { return running_batches_ == 0; });
+
+  if (err_.has_error()) {
+    *err = err_;
+    return false;
+  }
+  return true;
+}
+
+void OutputWriter::PostPendingLocked() {
+  // std::function must be copyable, which the requests aren't.
+  auto batch = std::make_shared<std::vector<Request>>(std::move(pending_));
+  pending_.clear();
+  running_batches_++;
+  WorkerPool::Get()->PostBlockingTask(
+      [this, batch]() { RunBatch(batch.get()); });
+}
+
+void OutputWriter::RunBatch(std::vector<Request>* batch) {
+  Err first_err;
+  for (Request& request : *batch) {
+    Err err;
+    if (!request.contents->WriteToFileIfChanged(request.file_path, &err) &&
+        !first_err.has_error())
+      first_err = err;
+    // Release the memory as soon as possible.
+    request.contents.reset();
+  }
+
+  std::lock_guard<std::mutex> lock(lock_);
+  if (first_err.has_error() && !err_.has_error())
+    err_ = first_err;
+  if (--running_batches_ == 0)
+    done_.notify_all();
+}
@@ -0,0 +1,81 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TOOLS_GN_OUTPUT_WRITER_H_
+#define TOOLS_GN_OUTPUT_WRITER_H_
+
+#include <stddef.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "gn/err.h"
+
+class StringOutputBuffer;
+
+// Writes generated files in the background.
+//
+// Writing a file that may be unchanged takes several system calls (stat,
+// reading the old contents back, creating the directory, writing), which
+// mostly wait on the file system. Instead of doing them on the thread that
+// generated the contents, requests are queued and handed in batches to the
+// I/O lane of the worker pool, so that the CPU-bound threads can go on
+// generating other files.
+//
+// All functions are thread-safe.
+class OutputWriter {
+ public:
+  OutputWriter();
+  ~OutputWriter();
+
+  // Queues |contents| to be written to |file_path|, if it differs from the
+  // current contents of the file. See
+  // StringOutputBuffer::WriteToFileIfChanged().
+  void WriteFileIfChanged(const base::FilePath& file_path,
+                          std::unique_ptr<StringOutputBuffer> contents);
+
+  // Waits for all the files queued so far to be written. Returns false and
+  // sets |err| if any of them failed.
+  bool Flush(Err* err);
+
+ private:
+  struct Request {
+    Request(const base::FilePath& file_path,
+            std::unique_ptr<StringOutputBuffer> contents);
+    Request(Request&&);
+    ~Request();
+
+    base::FilePath file_path;
+    std::unique_ptr<StringOutputBuffer> contents;
+  };
+
+  // Posts the pending requests to the worker pool. The lock must be held.
+  void PostPendingLocked();
+
+  void RunBatch(std::vector<Request>* batch);
+
+  std::mutex lock_;
+  std::condition_variable done_;
+
+  // Requests not posted yet.
+  std::vector<Request> pending_;
+
+  // Number of posted batches that haven't completed.
+  size_t running_batches_ = 0;
+
+  // The first error, if any.
+  Err err_;
+
+  OutputWriter(const OutputWriter&) = delete;
+  OutputWriter& operator=(const OutputWriter&) = delete;
+};
+
+// The writer used for the target Ninja files, set by "gn gen". When null,
+// they are written synchronously.
+extern OutputWriter* g_output_writer;
+
+#endif  // TOOLS_GN_OUTPUT_WRITER_H_
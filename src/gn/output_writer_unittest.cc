@@ -0,0 +1,82 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/output_writer.h"
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "gn/string_output_buffer.h"
+#include "util/test/test.h"
+
+namespace {
+
+std::unique_ptr<StringOutputBuffer> MakeContents(const std::string& str) {
+  auto contents = std::make_unique<StringOutputBuffer>();
+  contents->Append(str);
+  return contents;
+}
+
+}  // namespace
+
+TEST(OutputWriter, WritesAllFiles) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+
+  // More files than a batch, some of them in the same directory.
+  constexpr int kFileCount = 50;
+  OutputWriter writer;
+  for (int i = 0; i < kFileCount; i++) {
+    std::string name = base::IntToString(i);
+    writer.WriteFileIfChanged(temp_dir.GetPath()
+                                  .AppendASCII(base::IntToString(i % 4))
+                                  .AppendASCII(name + ".ninja"),
+                              MakeContents("file " + name + "\n"));
+  }
+  Err err;
+  EXPECT_TRUE(writer.Flush(&err));
+  EXPECT_FALSE(err.has_error());
+
+  for (int i = 0; i < kFileCount; i++) {
+    std::string name = base::IntToString(i);
+    std::string contents;
+    ASSERT_TRUE(base::ReadFileToString(
+        temp_dir.GetPath()
+            .AppendASCII(base::IntToString(i % 4))
+            .AppendASCII(name + ".ninja"),
+        &contents));
+    EXPECT_EQ("file " + name + "\n", contents);
+  }
+
+  // The writer can be used again after flushing.
+  base::FilePath path =
+      temp_dir.GetPath().AppendASCII("0").AppendASCII("0.ninja");
+  writer.WriteFileIfChanged(path, MakeContents("changed\n"));
+  EXPECT_TRUE(writer.Flush(&err));
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(path, &contents));
+  EXPECT_EQ("changed\n", contents);
+}
+
+TEST(OutputWriter, ReportsErrors) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+
+  // A file can't be created under a regular file.
+  base::FilePath file = temp_dir.GetPath().AppendASCII("file");
+  ASSERT_EQ(1, base::WriteFile(file, "x", 1));
+
+  OutputWriter writer;
+  writer.WriteFileIfChanged(temp_dir.GetPath().AppendASCII("ok.ninja"),
+                            MakeContents("ok\n"));
+  writer.WriteFileIfChanged(file.AppendASCII("bad.ninja"),
+                            MakeContents("bad\n"));
+  Err err;
+  EXPECT_FALSE(writer.Flush(&err));
+  EXPECT_TRUE(err.has_error());
+  EXPECT_TRUE(base::PathExists(temp_dir.GetPath().AppendASCII("ok.ninja")));
+}
@@ -0,0 +1,61 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/parse_node_arena.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace {
+
+// Most files are small, so start with a small block and double the size of
+// each new one up to the maximum.
+constexpr size_t kFirstBlockSize = 4096;
+constexpr size_t kMaxBlockSize = 64 * 1024;
+
+constexpr size_t kAlignment = alignof(std::max_align_t);
+
+thread_local ParseNodeArena* current_arena = nullptr;
+
+}  // namespace
+
+ParseNodeArena::ParseNodeArena() = default;
+
+ParseNodeArena::~ParseNodeArena() = default;
+
+void* ParseNodeArena::Allocate(size_t size) {
+  size = (size + kAlignment - 1) & ~(kAlignment - 1);
+  if (size > remaining_) {
+    size_t block_size =
+        blocks_.empty() ? kFirstBlockSize
+                        : std::min(reserved_bytes_, kMaxBlockSize);
+    block_size = std::max(block_size, size);
+    // new[] of char only guarantees the default new alignment.
+    static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ >= kAlignment,
+                  "Blocks must be aligned for any type.");
+    blocks_.emplace_back(new char[block_size]);
+    cur_ = blocks_.back().get();
+    remaining_ = block_size;
+    reserved_bytes_ += block_size;
+  }
+
+  void* result = cur_;
+  cur_ += size;
+  remaining_ -= size;
+  return result;
+}
+
+ScopedParseNodeArena::ScopedParseNodeArena(ParseNodeArena* arena)
+    : previous_(current_arena) {
+  current_arena = arena;
+}
+
+ScopedParseNodeArena::~ScopedParseNodeArena() {
+  current_arena = previous_;
+}
+
+// static
+ParseNodeArena* ScopedParseNodeArena::Current() {
+  return current_arena;
+}
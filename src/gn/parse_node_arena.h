@@ -0,0 +1,60 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TOOLS_GN_PARSE_NODE_ARENA_H_
+#define TOOLS_GN_PARSE_NODE_ARENA_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+// Bump allocator for the parse tree of a file.
+//
+// A parse tree is made of many small nodes which are all created while parsing
+// the file and all destroyed together with the file. While a
+// ScopedParseNodeArena exists, ParseNode::operator new takes their memory from
+// the arena instead of the heap, and deleting them doesn't free anything: the
+// memory is released when the arena is destroyed, which must happen after the
+// tree is.
+class ParseNodeArena {
+ public:
+  ParseNodeArena();
+  ~ParseNodeArena();
+
+  // Returns |size| bytes aligned for any type.
+  void* Allocate(size_t size);
+
+  // Total size of the blocks allocated from the heap.
+  size_t reserved_bytes() const { return reserved_bytes_; }
+
+ private:
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char* cur_ = nullptr;
+  size_t remaining_ = 0;
+  size_t reserved_bytes_ = 0;
+
+  ParseNodeArena(const ParseNodeArena&) = delete;
+  ParseNodeArena& operator=(const ParseNodeArena&) = delete;
+};
+
+// Makes the parse nodes created on the current thread while it exists be
+// allocated from |arena|.
+class ScopedParseNodeArena {
+ public:
+  explicit ScopedParseNodeArena(ParseNodeArena* arena);
+  ~ScopedParseNodeArena();
+
+  // Returns the arena of the innermost ScopedParseNodeArena of this thread,
+  // or null.
+  static ParseNodeArena* Current();
+
+ private:
+  ParseNodeArena* previous_;
+
+  ScopedParseNodeArena(const ScopedParseNodeArena&) = delete;
+  ScopedParseNodeArena& operator=(const ScopedParseNodeArena&) = delete;
+};
+
+#endif  // TOOLS_GN_PARSE_NODE_ARENA_H_
@@ -0,0 +1,67 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/parse_node_arena.h"
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "gn/parse_tree.h"
+#include "gn/parser.h"
+#include "gn/test_with_scope.h"
+#include "gn/tokenizer.h"
+#include "util/test/test.h"
+
+TEST(ParseNodeArena, Allocate) {
+  ParseNodeArena arena;
+  EXPECT_EQ(0u, arena.reserved_bytes());
+
+  void* first = arena.Allocate(1);
+  void* second = arena.Allocate(24);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(first) % alignof(std::max_align_t));
+  EXPECT_EQ(0u,
+            reinterpret_cast<uintptr_t>(second) % alignof(std::max_align_t));
+  EXPECT_NE(first, second);
+  size_t reserved = arena.reserved_bytes();
+  EXPECT_GT(reserved, 0u);
+
+  // Large allocations get a block of their own.
+  arena.Allocate(1024 * 1024);
+  EXPECT_GE(arena.reserved_bytes(), reserved + 1024 * 1024);
+}
+
+TEST(ParseNodeArena, ParseTree) {
+  TestWithScope setup;
+  InputFile input_file(SourceFile("//test"));
+  input_file.SetContents("a = [ 1, 2 ]  # Comment.\nb = a[1] + 1\n");
+
+  Err err;
+  std::vector<Token> tokens = Tokenizer::Tokenize(&input_file, &err);
+  ASSERT_FALSE(err.has_error());
+
+  ParseNodeArena arena;
+  std::unique_ptr<ParseNode> root;
+  {
+    ScopedParseNodeArena scoped_arena(&arena);
+    EXPECT_EQ(&arena, ScopedParseNodeArena::Current());
+    root = Parser::Parse(tokens, &err);
+  }
+  EXPECT_EQ(nullptr, ScopedParseNodeArena::Current());
+  ASSERT_FALSE(err.has_error());
+  EXPECT_GT(arena.reserved_bytes(), 0u);
+
+  // Nodes created outside of the scope come from the heap, and both kinds
+  // can be destroyed.
+  std::unique_ptr<ParseNode> heap_root = Parser::Parse(tokens, &err);
+  ASSERT_FALSE(err.has_error());
+  heap_root.reset();
+
+  root->Execute(setup.scope(), &err);
+  ASSERT_FALSE(err.has_error());
+  EXPECT_EQ(3, setup.scope()->GetValue("b")->int_value());
+  root.reset();
+}
@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -16,6 +17,7 @@
 #include "base/strings/string_util.h"
 #include "gn/functions.h"
 #include "gn/operators.h"
+#include "gn/parse_node_arena.h"
 #include "gn/scope.h"
 #include "gn/string_utils.h"
 
@@ -38,6 +40,11 @@ const char kJsonEnd[] = "end";
 
 namespace {
 
+// Precedes every node in memory, see ParseNode::operator new.
+struct alignas(std::max_align_t) NodeHeader {
+  bool in_arena;
+};
+
 enum DepsCategory {
   DEPS_CATEGORY_LOCAL,
   DEPS_CATEGORY_RELATIVE,
@@ -171,6 +178,26 @@ ParseNode::ParseNode() = default;
 
 ParseNode::~ParseNode() = default;
 
+// static
+void* ParseNode::operator new(size_t size) {
+  size_t total_size = sizeof(NodeHeader) + size;
+  ParseNodeArena* arena = ScopedParseNodeArena::Current();
+  NodeHeader* header = static_cast<NodeHeader*>(
+      arena ? arena->Allocate(total_size) : ::operator new(total_size));
+  header->in_arena = arena != nullptr;
+  return header + 1;
+}
+
+// static
+void ParseNode::operator delete(void* ptr) {
+  if (!ptr)
+    return;
+  // Nodes allocated from an arena are freed with it.
+  NodeHeader* header = static_cast<NodeHeader*>(ptr) - 1;
+  if (!header->in_arena)
+    ::operator delete(header);
+}
+
 const AccessorNode* ParseNode::AsAccessor() const {
   return nullptr;
 }
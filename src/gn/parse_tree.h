@@ -80,6 +80,11 @@ class ParseNode {
   ParseNode();
   virtual ~ParseNode();
 
+  // Nodes are allocated from the ParseNodeArena of the current thread, if
+  // any, and from the heap otherwise.
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+
   virtual const AccessorNode* AsAccessor() const;
   virtual const BinaryOpNode* AsBinaryOp() const;
   virtual const BlockCommentNode* AsBlockComment() const;
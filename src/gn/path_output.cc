@@ -4,29 +4,73 @@
 
 #include "gn/path_output.h"
 
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
 #include "base/strings/string_util.h"
 #include "gn/filesystem_utils.h"
 #include "gn/output_file.h"
+#include "gn/string_output_buffer.h"
 #include "gn/string_utils.h"
 #include "util/build_config.h"
 
+namespace {
+
+// Identifies the rendering of a directory by a PathOutput. All the strings are
+// atoms so they are compared by address.
+struct RenderedDirKey {
+  const std::string* dir;
+  const std::string* current_dir;
+  const std::string* inverse_current_dir;
+  EscapingMode mode;
+  EscapingPlatform platform;
+
+  bool operator==(const RenderedDirKey& other) const {
+    return dir == other.dir && current_dir == other.current_dir &&
+           inverse_current_dir == other.inverse_current_dir &&
+           mode == other.mode && platform == other.platform;
+  }
+};
+
+struct RenderedDirKeyHash {
+  size_t operator()(const RenderedDirKey& key) const {
+    size_t hash = std::hash<const void*>()(key.dir);
+    hash = hash * 31 + std::hash<const void*>()(key.current_dir);
+    hash = hash * 31 + std::hash<const void*>()(key.inverse_current_dir);
+    return hash * 31 + key.mode * 8 + key.platform;
+  }
+};
+
+}  // namespace
+
 PathOutput::PathOutput(const SourceDir& current_dir,
                        std::string_view source_root,
                        EscapingMode escaping)
     : current_dir_(current_dir) {
-  inverse_current_dir_ = RebasePath("//", current_dir, source_root);
-  if (!EndsWithSlash(inverse_current_dir_))
-    inverse_current_dir_.push_back('/');
+  std::string inverse_current_dir = RebasePath("//", current_dir, source_root);
+  if (!EndsWithSlash(inverse_current_dir))
+    inverse_current_dir.push_back('/');
+  inverse_current_dir_ = StringAtom(inverse_current_dir);
   options_.mode = escaping;
 }
 
 PathOutput::~PathOutput() = default;
 
-void PathOutput::WriteFile(std::ostream& out, const SourceFile& file) const {
-  WritePathStr(out, file.value());
+void PathOutput::WriteFile(StringOutputBuffer& out,
+                           const SourceFile& file) const {
+  if (!CanReuseRenderedDirs()) {
+    WritePathStr(out, file.value());
+    return;
+  }
+  SourceDir dir = file.GetDir();
+  out << GetRenderedDir(dir);
+  EscapeStringToStream(
+      out, std::string_view(file.value()).substr(dir.value().size()),
+      options_);
 }
 
-void PathOutput::WriteDir(std::ostream& out,
+void PathOutput::WriteDir(StringOutputBuffer& out,
                           const SourceDir& dir,
                           DirSlashEnding slash_ending) const {
   if (dir.value() == "/") {
@@ -44,14 +88,14 @@ void PathOutput::WriteDir(std::ostream& out,
       if (inverse_current_dir_.empty()) {
         out << ".";
       } else {
-        out.write(inverse_current_dir_.c_str(),
-                  inverse_current_dir_.size() - 1);
+        out.Append(inverse_current_dir_.str().c_str(),
+                   inverse_current_dir_.str().size() - 1);
       }
     } else {
       if (inverse_current_dir_.empty())
         out << "./";
       else
-        out << inverse_current_dir_;
+        out << inverse_current_dir_.str();
     }
   } else if (dir == current_dir_) {
     // Writing the same directory. This needs special handling here since
@@ -60,6 +104,13 @@ void PathOutput::WriteDir(std::ostream& out,
       out << "./";
     else
       out << ".";
+  } else if (CanReuseRenderedDirs()) {
+    // The rendered directory ends with the slash, which is never escaped.
+    const std::string& rendered = GetRenderedDir(dir);
+    if (slash_ending == DIR_INCLUDE_LAST_SLASH)
+      out << rendered;
+    else
+      out.Append(rendered.data(), rendered.size() - 1);
   } else if (slash_ending == DIR_INCLUDE_LAST_SLASH) {
     WritePathStr(out, dir.value());
   } else {
@@ -69,12 +120,13 @@ void PathOutput::WriteDir(std::ostream& out,
   }
 }
 
-void PathOutput::WriteFile(std::ostream& out, const OutputFile& file) const {
+void PathOutput::WriteFile(StringOutputBuffer& out,
+                           const OutputFile& file) const {
   // Here we assume that the path is already preprocessed.
   EscapeStringToStream(out, file.value(), options_);
 }
 
-void PathOutput::WriteFiles(std::ostream& out,
+void PathOutput::WriteFiles(StringOutputBuffer& out,
                             const std::vector<SourceFile>& files) const {
   for (const auto& file : files) {
     out << " ";
@@ -82,7 +134,7 @@ void PathOutput::WriteFiles(std::ostream& out,
   }
 }
 
-void PathOutput::WriteFiles(std::ostream& out,
+void PathOutput::WriteFiles(StringOutputBuffer& out,
                             const std::vector<OutputFile>& files) const {
   for (const auto& file : files) {
     out << " ";
@@ -90,7 +142,7 @@ void PathOutput::WriteFiles(std::ostream& out,
   }
 }
 
-void PathOutput::WriteFiles(std::ostream& out,
+void PathOutput::WriteFiles(StringOutputBuffer& out,
                             const UniqueVector<OutputFile>& files) const {
   for (const auto& file : files) {
     out << " ";
@@ -98,7 +150,7 @@ void PathOutput::WriteFiles(std::ostream& out,
   }
 }
 
-void PathOutput::WriteDir(std::ostream& out,
+void PathOutput::WriteDir(StringOutputBuffer& out,
                           const OutputFile& file,
                           DirSlashEnding slash_ending) const {
   DCHECK(file.value().empty() || file.value()[file.value().size() - 1] == '/');
@@ -122,21 +174,20 @@ void PathOutput::WriteDir(std::ostream& out,
   }
 }
 
-void PathOutput::WriteFile(std::ostream& out,
+void PathOutput::WriteFile(StringOutputBuffer& out,
                            const base::FilePath& file) const {
   // Assume native file paths are always absolute.
   EscapeStringToStream(out, FilePathToUTF8(file), options_);
 }
 
-void PathOutput::WriteSourceRelativeString(std::ostream& out,
+void PathOutput::WriteSourceRelativeString(StringOutputBuffer& out,
                                            std::string_view str) const {
   if (options_.mode == ESCAPE_NINJA_COMMAND) {
     // Shell escaping needs an intermediate string since it may end up
     // quoting the whole thing.
     std::string intermediate;
-    intermediate.reserve(inverse_current_dir_.size() + str.size());
-    intermediate.assign(inverse_current_dir_.c_str(),
-                        inverse_current_dir_.size());
+    intermediate.reserve(inverse_current_dir_.str().size() + str.size());
+    intermediate.assign(inverse_current_dir_.str());
     intermediate.append(str.data(), str.size());
 
     EscapeStringToStream(
@@ -145,12 +196,68 @@ void PathOutput::WriteSourceRelativeString(std::ostream& out,
   } else {
     // Ninja (and none) escaping can avoid the intermediate string and
     // reprocessing of the inverse_current_dir_.
-    out << inverse_current_dir_;
+    out << inverse_current_dir_.str();
     EscapeStringToStream(out, str, options_);
   }
 }
 
-void PathOutput::WritePathStr(std::ostream& out, std::string_view str) const {
+bool PathOutput::CanReuseRenderedDirs() const {
+  switch (options_.mode) {
+    case ESCAPE_COMPILATION_DATABASE:
+      // Quotes the whole path if any part of it needs quoting.
+      return false;
+    case ESCAPE_NINJA_COMMAND:
+      // Same on Windows.
+      switch (options_.platform) {
+        case ESCAPE_PLATFORM_CURRENT:
+#if defined(OS_WIN)
+          return false;
+#else
+          return true;
+#endif
+        case ESCAPE_PLATFORM_POSIX:
+          return true;
+        default:
+          return false;
+      }
+    default:
+      return true;
+  }
+}
+
+const std::string& PathOutput::GetRenderedDir(const SourceDir& dir) const {
+  // Like SourceFile::GetInfo, each thread has its own memo so the global
+  // mutex is only taken on a miss. Rendered directories are never freed, and
+  // deques never move their elements.
+  using RenderedDirMap = std::unordered_map<RenderedDirKey,
+                                            const std::string*,
+                                            RenderedDirKeyHash>;
+  static std::mutex& mutex = *new std::mutex;
+  static RenderedDirMap& rendered_dirs = *new RenderedDirMap;
+  static std::deque<std::string>& storage = *new std::deque<std::string>;
+  thread_local RenderedDirMap local_rendered_dirs;
+
+  RenderedDirKey key{&dir.value(), &current_dir_.value(),
+                     &inverse_current_dir_.str(), options_.mode,
+                     options_.platform};
+  const std::string*& local_rendered = local_rendered_dirs[key];
+  if (local_rendered)
+    return *local_rendered;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  const std::string*& rendered = rendered_dirs[key];
+  if (!rendered) {
+    StringOutputBuffer buffer;
+    WritePathStr(buffer, dir.value());
+    storage.push_back(buffer.str());
+    rendered = &storage.back();
+  }
+  local_rendered = rendered;
+  return *rendered;
+}
+
+void PathOutput::WritePathStr(StringOutputBuffer& out,
+                              std::string_view str) const {
   DCHECK(str.size() > 0 && str[0] == '/');
 
   if (str.substr(0, current_dir_.value().size()) ==
@@ -173,3 +280,24 @@ void PathOutput::WritePathStr(std::ostream& out, std::string_view str) const {
 #endif
   }
 }
+
+void PathOutput::WriteFile(std::ostream& out, const SourceFile& file) const {
+  StringOutputBuffer buffer;
+  WriteFile(buffer, file);
+  buffer.WriteRange(out, 0, buffer.size());
+}
+
+void PathOutput::WriteFiles(std::ostream& out,
+                            const std::vector<OutputFile>& files) const {
+  StringOutputBuffer buffer;
+  WriteFiles(buffer, files);
+  buffer.WriteRange(out, 0, buffer.size());
+}
+
+void PathOutput::WriteDir(std::ostream& out,
+                          const SourceDir& dir,
+                          DirSlashEnding slash_ending) const {
+  StringOutputBuffer buffer;
+  WriteDir(buffer, dir, slash_ending);
+  buffer.WriteRange(out, 0, buffer.size());
+}
@@ -11,10 +11,12 @@
 
 #include "gn/escape.h"
 #include "gn/source_dir.h"
+#include "gn/string_atom.h"
 #include "gn/unique_vector.h"
 
 class OutputFile;
 class SourceFile;
+class StringOutputBuffer;
 
 namespace base {
 class FilePath;
@@ -22,6 +24,13 @@ class FilePath;
 
 // Writes file names to streams assuming a certain input directory and
 // escaping rules. This gives us a central place for managing this state.
+//
+// The same directories are written by many targets, so the rendered
+// SourceDirs are memoized process-wide, keyed on the directory and on
+// everything the rendering depends on: the current directory, the source root
+// and the escape options. Unless the escaping has to see the whole path, a
+// SourceFile is written as its rendered directory followed by its escaped
+// name.
 class PathOutput {
  public:
   // Controls whether writing directory names include the trailing slash.
@@ -48,40 +57,58 @@ class PathOutput {
   void set_inhibit_quoting(bool iq) { options_.inhibit_quoting = iq; }
   void set_escape_platform(EscapingPlatform p) { options_.platform = p; }
 
-  void WriteFile(std::ostream& out, const SourceFile& file) const;
-  void WriteFile(std::ostream& out, const OutputFile& file) const;
-  void WriteFile(std::ostream& out, const base::FilePath& file) const;
+  void WriteFile(StringOutputBuffer& out, const SourceFile& file) const;
+  void WriteFile(StringOutputBuffer& out, const OutputFile& file) const;
+  void WriteFile(StringOutputBuffer& out, const base::FilePath& file) const;
 
   // Writes the given SourceFiles/OutputFiles with spaces separating them. This
   // will also write an initial space before the first item.
-  void WriteFiles(std::ostream& out, const std::vector<SourceFile>& file) const;
-  void WriteFiles(std::ostream& out,
+  void WriteFiles(StringOutputBuffer& out,
+                  const std::vector<SourceFile>& file) const;
+  void WriteFiles(StringOutputBuffer& out,
                   const std::vector<OutputFile>& files) const;
-  void WriteFiles(std::ostream& out,
+  void WriteFiles(StringOutputBuffer& out,
                   const UniqueVector<OutputFile>& files) const;
 
   // This variant assumes the dir ends in a trailing slash or is empty.
-  void WriteDir(std::ostream& out,
+  void WriteDir(StringOutputBuffer& out,
                 const SourceDir& dir,
                 DirSlashEnding slash_ending) const;
 
-  void WriteDir(std::ostream& out,
+  void WriteDir(StringOutputBuffer& out,
                 const OutputFile& file,
                 DirSlashEnding slash_ending) const;
 
   // Backend for WriteFile and WriteDir. This appends the given file or
   // directory string to the file.
-  void WritePathStr(std::ostream& out, std::string_view str) const;
+  void WritePathStr(StringOutputBuffer& out, std::string_view str) const;
+
+  // Variants for the writers that don't generate Ninja files and use streams.
+  void WriteFile(std::ostream& out, const SourceFile& file) const;
+  void WriteFiles(std::ostream& out,
+                  const std::vector<OutputFile>& files) const;
+  void WriteDir(std::ostream& out,
+                const SourceDir& dir,
+                DirSlashEnding slash_ending) const;
 
  private:
   // Takes the given string and writes it out, appending to the inverse
   // current dir. This assumes leading slashes have been trimmed.
-  void WriteSourceRelativeString(std::ostream& out, std::string_view str) const;
+  void WriteSourceRelativeString(StringOutputBuffer& out,
+                                 std::string_view str) const;
+
+  // Returns true if escaping a path gives the same result as escaping its
+  // parts separately, so rendered directories can be reused.
+  bool CanReuseRenderedDirs() const;
+
+  // Returns the result of WritePathStr() for |dir|, from the memo.
+  const std::string& GetRenderedDir(const SourceDir& dir) const;
 
   SourceDir current_dir_;
 
-  // Uses system slashes if convert_slashes_to_system_.
-  std::string inverse_current_dir_;
+  // Uses system slashes if convert_slashes_to_system_. This is an atom so it
+  // can be part of the keys of the memo of rendered directories.
+  StringAtom inverse_current_dir_;
 
   // Since the inverse_current_dir_ depends on some of these, we don't expose
   // this directly to modification.
@@ -2,13 +2,12 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
-#include <sstream>
-
 #include "base/files/file_path.h"
 #include "gn/output_file.h"
 #include "gn/path_output.h"
 #include "gn/source_dir.h"
 #include "gn/source_file.h"
+#include "gn/string_output_buffer.h"
 #include "util/build_config.h"
 #include "util/test/test.h"
 
@@ -18,19 +17,19 @@ TEST(PathOutput, Basic) {
   PathOutput writer(build_dir, source_root, ESCAPE_NONE);
   {
     // Normal source-root path.
-    std::ostringstream out;
+    StringOutputBuffer out;
     writer.WriteFile(out, SourceFile("//foo/bar.cc"));
     EXPECT_EQ("../../foo/bar.cc", out.str());
   }
   {
     // File in the root dir.
-    std::ostringstream out;
+    StringOutputBuffer out;
     writer.WriteFile(out, SourceFile("//foo.cc"));
     EXPECT_EQ("../../foo.cc", out.str());
   }
   {
     // Files in the output dir.
-    std::ostringstream out;
+    StringOutputBuffer out;
     writer.WriteFile(out, SourceFile("//out/Debug/foo.cc"));
     out << " ";
     writer.WriteFile(out, SourceFile("//out/Debug/bar/baz.cc"));
@@ -39,14 +38,14 @@ TEST(PathOutput, Basic) {
 #if defined(OS_WIN)
   {
     // System-absolute path.
-    std::ostringstream out;
+    StringOutputBuffer out;
     writer.WriteFile(out, SourceFile("/C:/foo/bar.cc"));
     EXPECT_EQ("C:/foo/bar.cc", out.str());
   }
 #else
   {
     // System-absolute path.
-    std::ostringstream out;
+    StringOutputBuffer out;
     writer.WriteFile(out, SourceFile("/foo/bar.cc"));
     EXPECT_EQ("/foo/bar.cc", out.str());
   }
@@ -60,13 +59,13 @@ TEST(PathOutput, BasicInRoot) {
   PathOutput writer(build_dir, source_root, ESCAPE_NONE);
   {
     // Normal source-root path.
-    std::ostringstream out;
+    StringOutputBuffer out;
     writer.WriteFile(out, SourceFile("//foo/bar.cc"));
     EXPECT_EQ("foo/bar.cc", out.str());
   }
   {
     // File in the root dir.
-    std::ostringstream out;
+    StringOutputBuffer out;
     writer.WriteFile(out, SourceFile("//foo.cc"));
     EXPECT_EQ("foo.cc", out.str());
   }
@@ -78,13 +77,13 @@ TEST(PathOutput, NinjaEscaping) {
   PathOutput writer(build_dir, source_root, ESCAPE_NINJA);
   {
     // Spaces and $ in filenames.
-    std::ostringstream out;
+    StringOutputBuffer out;
     writer.WriteFile(out, SourceFile("//foo/foo bar$.cc"));
     EXPECT_EQ("../../foo/foo$ bar$$.cc", out.str());
   }
   {
     // Not other weird stuff
-    std::ostringstream out;
+    StringOutputBuffer out;
     writer.WriteFile(out, SourceFile("//foo/\"foo\".cc"));
     EXPECT_EQ("../../foo/\"foo\".cc", out.str());
   }
@@ -98,7 +97,7 @@ TEST(PathOutput, NinjaForkEscaping) {
   // Spaces in filenames should get quoted on Windows.
   writer.set_escape_platform(ESCAPE_PLATFORM_WIN);
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     writer.WriteFile(out, SourceFile("//foo/foo bar.cc"));
     EXPECT_EQ("\"../../foo/foo$ bar.cc\"", out.str());
   }
@@ -106,7 +105,7 @@ TEST(PathOutput, NinjaForkEscaping) {
   // Spaces in filenames should get escaped on Posix.
   writer.set_escape_platform(ESCAPE_PLATFORM_POSIX);
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     writer.WriteFile(out, SourceFile("//foo/foo bar.cc"));
     EXPECT_EQ("../../foo/foo\\$ bar.cc", out.str());
   }
@@ -114,7 +113,7 @@ TEST(PathOutput, NinjaForkEscaping) {
   // Quotes should get blackslash-escaped on Windows and Posix.
   writer.set_escape_platform(ESCAPE_PLATFORM_WIN);
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     writer.WriteFile(out, SourceFile("//foo/\"foobar\".cc"));
     // Our Windows code currently quotes the whole thing in this case for
     // code simplicity, even though it's strictly unnecessary. This might
@@ -123,7 +122,7 @@ TEST(PathOutput, NinjaForkEscaping) {
   }
   writer.set_escape_platform(ESCAPE_PLATFORM_POSIX);
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     writer.WriteFile(out, SourceFile("//foo/\"foobar\".cc"));
     EXPECT_EQ("../../foo/\\\"foobar\\\".cc", out.str());
   }
@@ -131,13 +130,13 @@ TEST(PathOutput, NinjaForkEscaping) {
   // Backslashes should get escaped on non-Windows and preserved on Windows.
   writer.set_escape_platform(ESCAPE_PLATFORM_WIN);
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     writer.WriteFile(out, OutputFile("foo\\bar.cc"));
     EXPECT_EQ("foo\\bar.cc", out.str());
   }
   writer.set_escape_platform(ESCAPE_PLATFORM_POSIX);
   {
-    std::ostringstream out;
+    StringOutputBuffer out;
     writer.WriteFile(out, OutputFile("foo\\bar.cc"));
     EXPECT_EQ("foo\\\\bar.cc", out.str());
   }
@@ -152,7 +151,7 @@ TEST(PathOutput, InhibitQuoting) {
   writer.set_escape_platform(ESCAPE_PLATFORM_WIN);
   {
     // We should get unescaped spaces in the output with no quotes.
-    std::ostringstream out;
+    StringOutputBuffer out;
     writer.WriteFile(out, SourceFile("//foo/foo bar.cc"));
     EXPECT_EQ("../../foo/foo$ bar.cc", out.str());
   }
@@ -160,7 +159,7 @@ TEST(PathOutput, InhibitQuoting) {
   writer.set_escape_platform(ESCAPE_PLATFORM_POSIX);
   {
     // Escapes the space.
-    std::ostringstream out;
+    StringOutputBuffer out;
     writer.WriteFile(out, SourceFile("//foo/foo bar.cc"));
     EXPECT_EQ("../../foo/foo\\$ bar.cc", out.str());
   }
@@ -172,13 +171,13 @@ TEST(PathOutput, WriteDir) {
     std::string_view source_root("/source/root");
     PathOutput writer(build_dir, source_root, ESCAPE_NINJA);
     {
-      std::ostringstream out;
+      StringOutputBuffer out;
       writer.WriteDir(out, SourceDir("//foo/bar/"),
                       PathOutput::DIR_INCLUDE_LAST_SLASH);
       EXPECT_EQ("../../foo/bar/", out.str());
     }
     {
-      std::ostringstream out;
+      StringOutputBuffer out;
       writer.WriteDir(out, SourceDir("//foo/bar/"),
                       PathOutput::DIR_NO_LAST_SLASH);
       EXPECT_EQ("../../foo/bar", out.str());
@@ -186,54 +185,54 @@ TEST(PathOutput, WriteDir) {
 
     // Output source root dir.
     {
-      std::ostringstream out;
+      StringOutputBuffer out;
       writer.WriteDir(out, SourceDir("//"), PathOutput::DIR_INCLUDE_LAST_SLASH);
       EXPECT_EQ("../../", out.str());
     }
     {
-      std::ostringstream out;
+      StringOutputBuffer out;
       writer.WriteDir(out, SourceDir("//"), PathOutput::DIR_NO_LAST_SLASH);
       EXPECT_EQ("../..", out.str());
     }
 
     // Output system root dir.
     {
-      std::ostringstream out;
+      StringOutputBuffer out;
       writer.WriteDir(out, SourceDir("/"), PathOutput::DIR_INCLUDE_LAST_SLASH);
       EXPECT_EQ("/", out.str());
     }
     {
-      std::ostringstream out;
+      StringOutputBuffer out;
       writer.WriteDir(out, SourceDir("/"), PathOutput::DIR_INCLUDE_LAST_SLASH);
       EXPECT_EQ("/", out.str());
     }
     {
-      std::ostringstream out;
+      StringOutputBuffer out;
       writer.WriteDir(out, SourceDir("/"), PathOutput::DIR_NO_LAST_SLASH);
       EXPECT_EQ("/.", out.str());
     }
 
     // Output inside current dir.
     {
-      std::ostringstream out;
+      StringOutputBuffer out;
       writer.WriteDir(out, SourceDir("//out/Debug/"),
                       PathOutput::DIR_INCLUDE_LAST_SLASH);
       EXPECT_EQ("./", out.str());
     }
     {
-      std::ostringstream out;
+      StringOutputBuffer out;
       writer.WriteDir(out, SourceDir("//out/Debug/"),
                       PathOutput::DIR_NO_LAST_SLASH);
       EXPECT_EQ(".", out.str());
     }
     {
-      std::ostringstream out;
+      StringOutputBuffer out;
       writer.WriteDir(out, SourceDir("//out/Debug/foo/"),
                       PathOutput::DIR_INCLUDE_LAST_SLASH);
       EXPECT_EQ("foo/", out.str());
     }
     {
-      std::ostringstream out;
+      StringOutputBuffer out;
       writer.WriteDir(out, SourceDir("//out/Debug/foo/"),
                       PathOutput::DIR_NO_LAST_SLASH);
       EXPECT_EQ("foo", out.str());
@@ -241,18 +240,18 @@ TEST(PathOutput, WriteDir) {
 
     // WriteDir using an OutputFile.
     {
-      std::ostringstream out;
+      StringOutputBuffer out;
       writer.WriteDir(out, OutputFile("foo/"),
                       PathOutput::DIR_INCLUDE_LAST_SLASH);
       EXPECT_EQ("foo/", out.str());
     }
     {
-      std::ostringstream out;
+      StringOutputBuffer out;
       writer.WriteDir(out, OutputFile("foo/"), PathOutput::DIR_NO_LAST_SLASH);
       EXPECT_EQ("foo", out.str());
     }
     {
-      std::ostringstream out;
+      StringOutputBuffer out;
       writer.WriteDir(out, OutputFile(), PathOutput::DIR_INCLUDE_LAST_SLASH);
       EXPECT_EQ("", out.str());
     }
@@ -262,15 +261,59 @@ TEST(PathOutput, WriteDir) {
     std::string_view source_root("/source/root");
     PathOutput root_writer(SourceDir("//"), source_root, ESCAPE_NINJA);
     {
-      std::ostringstream out;
+      StringOutputBuffer out;
       root_writer.WriteDir(out, SourceDir("//"),
                            PathOutput::DIR_INCLUDE_LAST_SLASH);
       EXPECT_EQ("./", out.str());
     }
     {
-      std::ostringstream out;
+      StringOutputBuffer out;
       root_writer.WriteDir(out, SourceDir("//"), PathOutput::DIR_NO_LAST_SLASH);
       EXPECT_EQ(".", out.str());
     }
   }
 }
+
+// Rendered directories are memoized, check that writers which only differ in
+// their directory, source root or options don't share results.
+TEST(PathOutput, Memoized) {
+  SourceFile file("//foo/foo bar.cc");
+  PathOutput debug(SourceDir("//out/Debug/"), "/source/root", ESCAPE_NINJA);
+  PathOutput release(SourceDir("//out/Release/x/"), "/source/root",
+                     ESCAPE_NINJA);
+  PathOutput outside(SourceDir("/build/"), "/source/root", ESCAPE_NINJA);
+  PathOutput other_root(SourceDir("/build/"), "/other", ESCAPE_NINJA);
+  PathOutput command(SourceDir("//out/Debug/"), "/source/root",
+                     ESCAPE_NINJA_COMMAND);
+  command.set_escape_platform(ESCAPE_PLATFORM_POSIX);
+
+  for (int i = 0; i < 2; i++) {
+    StringOutputBuffer out;
+    debug.WriteFile(out, file);
+    out << " ";
+    release.WriteFile(out, file);
+    out << " ";
+    outside.WriteFile(out, file);
+    out << " ";
+    other_root.WriteFile(out, file);
+    out << " ";
+    command.WriteFile(out, file);
+    out << " ";
+    command.WriteDir(out, file.GetDir(), PathOutput::DIR_INCLUDE_LAST_SLASH);
+    out << " ";
+    command.WriteDir(out, file.GetDir(), PathOutput::DIR_NO_LAST_SLASH);
+    EXPECT_EQ(
+        "../../foo/foo$ bar.cc ../../../foo/foo$ bar.cc "
+        "../source/root/foo/foo$ bar.cc ../other/foo/foo$ bar.cc "
+        "../../foo/foo\\$ bar.cc ../../foo/ ../../foo",
+        out.str());
+  }
+
+  command.set_escape_platform(ESCAPE_PLATFORM_WIN);
+  StringOutputBuffer out;
+  command.WriteFile(out, file);
+  out << " ";
+  command.set_inhibit_quoting(true);
+  command.WriteFile(out, file);
+  EXPECT_EQ("\"../../foo/foo$ bar.cc\" ../../foo/foo$ bar.cc", out.str());
+}
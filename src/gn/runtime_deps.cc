@@ -203,12 +203,14 @@ bool WriteRuntimeDepsFile(const OutputFile& output_file,
   base::FilePath data_deps_file =
       target->settings()->build_settings()->GetFullPath(output_as_source);
 
+  ScopedTrace trace(TraceItem::TRACE_RUNTIME_DEPS, output_as_source.value());
+  trace.SetToolchain(target->settings()->toolchain_label());
+
   StringOutputBuffer storage;
   std::ostream contents(&storage);
   for (const auto& pair : ComputeRuntimeDeps(target))
     contents << pair.first.value() << std::endl;
 
-  ScopedTrace trace(TraceItem::TRACE_FILE_WRITE, output_as_source.value());
   return storage.WriteToFileIfChanged(data_deps_file, err);
 }
 
@@ -15,7 +15,8 @@ Scheduler* g_scheduler = nullptr;
 
 Scheduler::Scheduler()
     : main_thread_run_loop_(MsgLoop::Current()),
-      input_file_manager_(new InputFileManager) {
+      input_file_manager_(new InputFileManager),
+      worker_pool_(WorkerPool::Get()) {
   g_scheduler = this;
 }
 
@@ -56,16 +57,11 @@ void Scheduler::FailWithError(const Err& err) {
 }
 
 void Scheduler::ScheduleWork(std::function<void()> work) {
-  IncrementWorkCount();
-  pool_work_count_.Increment();
-  worker_pool_.PostTask([this, work = std::move(work)]() {
-    work();
-    DecrementWorkCount();
-    if (!pool_work_count_.Decrement()) {
-      std::unique_lock<std::mutex> auto_lock(pool_work_count_lock_);
-      pool_work_count_cv_.notify_one();
-    }
-  });
+  worker_pool_->PostTask(WrapPoolTask(std::move(work)));
+}
+
+void Scheduler::ScheduleBlockingWork(std::function<void()> work) {
+  worker_pool_->PostBlockingTask(WrapPoolTask(std::move(work)));
 }
 
 void Scheduler::AddGenDependency(const base::FilePath& file) {
@@ -176,6 +172,19 @@ void Scheduler::OnComplete() {
   task_runner()->PostQuit();
 }
 
+std::function<void()> Scheduler::WrapPoolTask(std::function<void()> work) {
+  IncrementWorkCount();
+  pool_work_count_.Increment();
+  return [this, work = std::move(work)]() {
+    work();
+    DecrementWorkCount();
+    if (!pool_work_count_.Decrement()) {
+      std::unique_lock<std::mutex> auto_lock(pool_work_count_lock_);
+      pool_work_count_cv_.notify_one();
+    }
+  };
+}
+
 void Scheduler::WaitForPoolTasks() {
   std::unique_lock<std::mutex> lock(pool_work_count_lock_);
   while (!pool_work_count_.IsZero())
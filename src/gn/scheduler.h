@@ -21,7 +21,7 @@
 
 class Target;
 
-// Maintains the thread pool and error state.
+// Schedules work on the worker pool and maintains the error state.
 class Scheduler {
  public:
   Scheduler();
@@ -45,8 +45,14 @@ class Scheduler {
   void Log(const std::string& verb, const std::string& msg);
   void FailWithError(const Err& err);
 
+  // Runs CPU-bound work, such as parsing or executing a file, on the
+  // process-wide worker pool.
   void ScheduleWork(std::function<void()> work);
 
+  // Runs work that mostly waits on I/O, such as reading a file, on the I/O
+  // lane of the worker pool.
+  void ScheduleBlockingWork(std::function<void()> work);
+
   void Shutdown();
 
   // Declares that the given file was read and affected the build output.
@@ -107,7 +113,11 @@ class Scheduler {
 
   void OnComplete();
 
-  // Waits for tasks scheduled via ScheduleWork() to complete their execution.
+  // Wraps |work| so that it is accounted for by the work counts.
+  std::function<void()> WrapPoolTask(std::function<void()> work);
+
+  // Waits for tasks scheduled via ScheduleWork() and ScheduleBlockingWork() to
+  // complete their execution.
   void WaitForPoolTasks();
 
   MsgLoop* main_thread_run_loop_;
@@ -118,8 +128,8 @@ class Scheduler {
 
   base::AtomicRefCount work_count_;
 
-  // Number of tasks scheduled by ScheduleWork() that haven't completed their
-  // execution.
+  // Number of tasks scheduled by ScheduleWork() and ScheduleBlockingWork()
+  // that haven't completed their execution.
   base::AtomicRefCount pool_work_count_;
 
   // Lock for |pool_work_count_cv_|.
@@ -128,7 +138,7 @@ class Scheduler {
   // Condition variable signaled when |pool_work_count_| reaches zero.
   std::condition_variable pool_work_count_cv_;
 
-  WorkerPool worker_pool_;
+  WorkerPool* worker_pool_;
 
   mutable std::mutex lock_;
   bool is_failed_ = false;
@@ -25,8 +25,41 @@ bool IsPrivateVar(std::string_view name) {
   return name.empty() || name[0] == '_';
 }
 
+thread_local ImportProbe* current_import_probe = nullptr;
+thread_local BuildConfigProbe* current_build_config_probe = nullptr;
+
 }  // namespace
 
+ImportProbe::ImportProbe(const SourceFile& file)
+    : file_(file), previous_(current_import_probe) {
+  current_import_probe = this;
+}
+
+ImportProbe::~ImportProbe() {
+  DCHECK_EQ(current_import_probe, this);
+  current_import_probe = previous_;
+}
+
+// static
+ImportProbe* ImportProbe::Current() {
+  return current_import_probe;
+}
+
+BuildConfigProbe::BuildConfigProbe()
+    : previous_(current_build_config_probe) {
+  current_build_config_probe = this;
+}
+
+BuildConfigProbe::~BuildConfigProbe() {
+  DCHECK_EQ(current_build_config_probe, this);
+  current_build_config_probe = previous_;
+}
+
+// static
+BuildConfigProbe* BuildConfigProbe::Current() {
+  return current_build_config_probe;
+}
+
 // Defaults to all false, which are the things least likely to cause errors.
 Scope::MergeOptions::MergeOptions()
     : clobber_existing(false),
@@ -106,6 +139,8 @@ const Value* Scope::GetValueWithScope(std::string_view ident,
     return mutable_containing_->GetValueWithScope(ident, counts_as_used,
                                                   found_in_scope);
   }
+  if (ImportProbe* probe = ImportProbe::Current())
+    probe->missing_values().emplace(ident);
   return nullptr;
 }
 
@@ -153,6 +188,8 @@ const Value* Scope::GetValueWithScope(std::string_view ident,
   }
   if (containing())
     return containing()->GetValueWithScope(ident, found_in_scope);
+  if (ImportProbe* probe = ImportProbe::Current())
+    probe->missing_values().emplace(ident);
   return nullptr;
 }
 
@@ -199,9 +236,18 @@ const Template* Scope::GetTemplate(const std::string& name) const {
     return found->second.get();
   if (containing())
     return containing()->GetTemplate(name);
+  if (ImportProbe* probe = ImportProbe::Current())
+    probe->missing_templates().insert(name);
   return nullptr;
 }
 
+void Scope::ReplaceTemplates(
+    const std::function<scoped_refptr<const Template>(const Template*)>&
+        replace) {
+  for (auto& pair : templates_)
+    pair.second = replace(pair.second.get());
+}
+
 void Scope::MarkUsed(std::string_view ident) {
   RecordMap::iterator found = values_.find(ident);
   if (found == values_.end()) {
@@ -5,9 +5,11 @@
 #ifndef TOOLS_GN_SCOPE_H_
 #define TOOLS_GN_SCOPE_H_
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
 #include <string_view>
 #include <unordered_map>
 #include <utility>
@@ -25,6 +27,69 @@ class ParseNode;
 class Settings;
 class Template;
 
+// While it exists, records on the current thread what the execution of an
+// imported file looks at that could differ between toolchains. ImportManager
+// executes imports outside of any toolchain with a probe to find out whether
+// their result can be shared by all the toolchains.
+class ImportProbe {
+ public:
+  explicit ImportProbe(const SourceFile& file);
+  ~ImportProbe();
+
+  // Returns the probe of the innermost import being probed on this thread, or
+  // null.
+  static ImportProbe* Current();
+
+  const SourceFile& file() const { return file_; }
+  const ImportProbe* previous() const { return previous_; }
+
+  // Set when the file did something that depends on the toolchain or has side
+  // effects, such as calling most functions or creating a scope.
+  bool depends_on_toolchain() const { return depends_on_toolchain_; }
+  void set_depends_on_toolchain() { depends_on_toolchain_ = true; }
+
+  // Names of the values and templates that were looked up and not found. The
+  // result of the import only holds for a toolchain whose build config
+  // defines none of them.
+  std::set<std::string>& missing_values() { return missing_values_; }
+  std::set<std::string>& missing_templates() { return missing_templates_; }
+
+ private:
+  SourceFile file_;
+  ImportProbe* previous_;
+  bool depends_on_toolchain_ = false;
+  std::set<std::string> missing_values_;
+  std::set<std::string> missing_templates_;
+
+  ImportProbe(const ImportProbe&) = delete;
+  ImportProbe& operator=(const ImportProbe&) = delete;
+};
+
+// While it exists, records on the current thread whether the execution of a
+// build config, including the files it imports, looks at something that
+// differs between toolchains with the same arguments, such as the toolchain
+// label or the output directories. If it doesn't, the loader reuses the
+// resulting scope for the other toolchains with the same arguments.
+class BuildConfigProbe {
+ public:
+  BuildConfigProbe();
+  ~BuildConfigProbe();
+
+  // Returns the probe of the build config being executed on this thread, or
+  // null.
+  static BuildConfigProbe* Current();
+
+  bool depends_on_toolchain() const { return depends_on_toolchain_; }
+  void set_depends_on_toolchain() { depends_on_toolchain_ = true; }
+
+ private:
+  BuildConfigProbe* previous_;
+  bool depends_on_toolchain_ = false;
+
+  BuildConfigProbe(const BuildConfigProbe&) = delete;
+  BuildConfigProbe& operator=(const BuildConfigProbe&) = delete;
+};
+
 // Scope for the script execution.
 //
 // Scopes are nested. Writing goes into the toplevel scope, reading checks
@@ -196,6 +261,12 @@ class Scope {
   bool AddTemplate(const std::string& name, const Template* templ);
   const Template* GetTemplate(const std::string& name) const;
 
+  // Replaces every template of this scope (not the containing ones) with the
+  // result of |replace| for it.
+  void ReplaceTemplates(
+      const std::function<scoped_refptr<const Template>(const Template*)>&
+          replace);
+
   // Marks the given identifier as (un)used in the current scope.
   void MarkUsed(std::string_view ident);
   void MarkAllUsed();
@@ -14,6 +14,18 @@
 
 #include "last_commit_position.h"
 
+namespace {
+
+// Returns |value|, reporting to the probe of the build config being executed,
+// if any, that it looked at a value that differs between toolchains.
+const Value* ToolchainDependent(const Value* value) {
+  if (BuildConfigProbe* probe = BuildConfigProbe::Current())
+    probe->set_depends_on_toolchain();
+  return value;
+}
+
+}  // namespace
+
 ScopePerFileProvider::ScopePerFileProvider(Scope* scope, bool allow_target_vars)
     : ProgrammaticProvider(scope), allow_target_vars_(allow_target_vars) {}
 
@@ -22,7 +34,7 @@ ScopePerFileProvider::~ScopePerFileProvider() = default;
 const Value* ScopePerFileProvider::GetProgrammaticValue(
     std::string_view ident) {
   if (ident == variables::kCurrentToolchain)
-    return GetCurrentToolchain();
+    return ToolchainDependent(GetCurrentToolchain());
   if (ident == variables::kDefaultToolchain)
     return GetDefaultToolchain();
   if (ident == variables::kGnVersion)
@@ -33,15 +45,15 @@ const Value* ScopePerFileProvider::GetProgrammaticValue(
   if (ident == variables::kRootBuildDir)
     return GetRootBuildDir();
   if (ident == variables::kRootGenDir)
-    return GetRootGenDir();
+    return ToolchainDependent(GetRootGenDir());
   if (ident == variables::kRootOutDir)
-    return GetRootOutDir();
+    return ToolchainDependent(GetRootOutDir());
 
   if (allow_target_vars_) {
     if (ident == variables::kTargetGenDir)
-      return GetTargetGenDir();
+      return ToolchainDependent(GetTargetGenDir());
     if (ident == variables::kTargetOutDir)
-      return GetTargetOutDir();
+      return ToolchainDependent(GetTargetOutDir());
   }
   return nullptr;
 }
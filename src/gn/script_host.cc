@@ -0,0 +1,378 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/script_host.h"
+
+#include <utility>
+
+#include "base/files/file_path.h"
+#include "util/build_config.h"
+
+#if !defined(OS_WIN)
+#include <errno.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_file.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/strings/string_number_conversions.h"
+#include "gn/exec_process.h"
+#include "util/worker_pool.h"
+#endif
+
+namespace {
+
+#if !defined(OS_WIN)
+// The program run by the hosts, passed to the interpreter with -c.
+//
+// The host talks to GN over the socket it gets as its standard input and
+// output, which are then replaced by /dev/null. Every number is followed by a
+// newline, and every field is its size followed by its contents.
+//
+// On start, the host writes kHostGreeting. Each request is the number of
+// fields followed by the fields: the startup directory, the script and its
+// arguments. The host answers with the exit code of the script, then its
+// standard output and standard error as two fields. The output of the script
+// and of the processes it runs is captured by pointing the descriptors 1 and 2
+// to temporary files.
+const char kHostProgram[] = R"py(
+import os
+import runpy
+import site
+import sys
+import tempfile
+import traceback
+
+# Modules loaded from the Python installation are kept between scripts.
+SHARED_PREFIXES = tuple(
+    os.path.join(p, '')
+    for p in {sys.prefix, sys.base_prefix, sys.exec_prefix,
+              sys.base_exec_prefix, site.getusersitepackages()})
+
+
+def read_number(conn):
+    line = conn.readline()
+    if not line.endswith(b'\n'):
+        raise EOFError()
+    return int(line)
+
+
+def read_field(conn):
+    size = read_number(conn)
+    data = conn.read(size)
+    if len(data) != size:
+        raise EOFError()
+    return os.fsdecode(data)
+
+
+def write_field(conn, data):
+    conn.write(b'%d\n' % len(data))
+    conn.write(data)
+
+
+def exit_code(code):
+    if code is None:
+        return 0
+    if isinstance(code, int):
+        return code & 0xff
+    print(code, file=sys.stderr)
+    return 1
+
+
+def run(startup_dir, script, args):
+    saved_path = sys.path[:]
+    saved_environ = dict(os.environ)
+    saved_modules = set(sys.modules)
+    sys.argv = [script] + args
+    sys.path[0] = os.path.dirname(os.path.realpath(script))
+    sys.stdout = open(1, 'w', closefd=False)
+    sys.stderr = open(2, 'w', closefd=False)
+    try:
+        os.chdir(startup_dir)
+        runpy.run_path(script, run_name='__main__')
+        code = 0
+    except SystemExit as e:
+        code = exit_code(e.code)
+    except BaseException as e:
+        # Hide the frames of the host, like Python would.
+        tb = e.__traceback__
+        while tb and tb.tb_frame.f_code.co_filename != script:
+            tb = tb.tb_next
+        traceback.print_exception(type(e), e, tb or e.__traceback__)
+        code = 1
+    for stream in (sys.stdout, sys.stderr):
+        try:
+            stream.flush()
+        except Exception:
+            pass
+
+    sys.path[:] = saved_path
+    os.environ.clear()
+    os.environ.update(saved_environ)
+    for name in set(sys.modules) - saved_modules:
+        path = getattr(sys.modules[name], '__file__', None)
+        if path and not path.startswith(SHARED_PREFIXES):
+            del sys.modules[name]
+    return code
+
+
+def main():
+    conn_fd = os.dup(0)
+    null_fd = os.open(os.devnull, os.O_RDWR)
+    stderr_fd = os.dup(2)
+    os.dup2(null_fd, 0)
+    os.dup2(null_fd, 1)
+    reader = os.fdopen(conn_fd, 'rb')
+    writer = os.fdopen(os.dup(conn_fd), 'wb')
+
+    writer.write(b'gn-script-host 1\n')
+    writer.flush()
+    while True:
+        try:
+            count = read_number(reader)
+            fields = [read_field(reader) for _ in range(count)]
+        except (EOFError, ValueError):
+            return
+
+        with tempfile.TemporaryFile() as out, tempfile.TemporaryFile() as err:
+            os.dup2(out.fileno(), 1)
+            os.dup2(err.fileno(), 2)
+            code = run(fields[0], fields[1], fields[2:])
+            os.dup2(null_fd, 1)
+            os.dup2(stderr_fd, 2)
+
+            writer.write(b'%d\n' % code)
+            for f in (out, err):
+                f.seek(0)
+                write_field(writer, f.read())
+        writer.flush()
+
+
+main()
+)py";
+
+const char kHostGreeting[] = "gn-script-host 1";
+
+#if defined(MSG_NOSIGNAL)
+const int kSendFlags = MSG_NOSIGNAL;
+#else
+const int kSendFlags = 0;
+#endif
+
+void AppendField(std::string* request, const std::string& field) {
+  request->append(base::NumberToString(field.size()));
+  request->push_back('\n');
+  request->append(field);
+}
+#endif  // !OS_WIN
+
+}  // namespace
+
+#if defined(OS_WIN)
+class ScriptHostPool::Host {};
+#else
+class ScriptHostPool::Host {
+ public:
+  ~Host();
+
+  // Starts a host and waits for it to be ready. Returns null on failure.
+  static std::unique_ptr<Host> Start(const base::FilePath& interpreter,
+                                     const base::FilePath& startup_dir);
+
+  // Returns false if the host didn't answer, in which case it can't be used
+  // anymore.
+  bool Run(const base::FilePath& script,
+           const std::vector<std::string>& args,
+           const base::FilePath& startup_dir,
+           std::string* std_out,
+           std::string* std_err,
+           int* exit_code);
+
+ private:
+  Host(int pid, base::ScopedFD fd);
+
+  bool Write(const std::string& data);
+
+  // Reads more of the answer into |buffer_|.
+  bool Fill();
+
+  bool ReadLine(std::string* line);
+  bool ReadNumber(int64_t* number);
+  bool ReadField(std::string* field);
+
+  int pid_;
+  base::ScopedFD fd_;
+
+  // What was read from |fd_| and not consumed yet.
+  std::string buffer_;
+};
+
+ScriptHostPool::Host::Host(int pid, base::ScopedFD fd)
+    : pid_(pid), fd_(std::move(fd)) {}
+
+ScriptHostPool::Host::~Host() {
+  // The host exits when the socket is closed.
+  fd_.reset();
+  int exit_code;
+  internal::WaitForExit(pid_, &exit_code);
+}
+
+// static
+std::unique_ptr<ScriptHostPool::Host> ScriptHostPool::Host::Start(
+    const base::FilePath& interpreter,
+    const base::FilePath& startup_dir) {
+  int fds[2];
+#if defined(OS_LINUX) || defined(OS_BSD)
+  if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) < 0)
+    return nullptr;
+  base::ScopedFD gn_fd(fds[0]), host_fd(fds[1]);
+#else
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0)
+    return nullptr;
+  base::ScopedFD gn_fd(fds[0]), host_fd(fds[1]);
+  if (!base::SetCloseOnExec(gn_fd.get()) ||
+      !base::SetCloseOnExec(host_fd.get()))
+    return nullptr;
+#endif
+#if defined(SO_NOSIGPIPE)
+  int no_sigpipe = 1;
+  setsockopt(gn_fd.get(), SOL_SOCKET, SO_NOSIGPIPE, &no_sigpipe,
+             sizeof(no_sigpipe));
+#endif
+
+  std::vector<std::string> argv = {interpreter.value(), "-c", kHostProgram};
+  int pid = internal::SpawnProcess(argv, startup_dir, host_fd.get(),
+                                   host_fd.get(), STDERR_FILENO);
+  if (pid < 0)
+    return nullptr;
+  host_fd.reset();
+
+  std::unique_ptr<Host> host(new Host(pid, std::move(gn_fd)));
+  std::string greeting;
+  if (!host->ReadLine(&greeting) || greeting != kHostGreeting)
+    return nullptr;
+  return host;
+}
+
+bool ScriptHostPool::Host::Run(const base::FilePath& script,
+                               const std::vector<std::string>& args,
+                               const base::FilePath& startup_dir,
+                               std::string* std_out,
+                               std::string* std_err,
+                               int* exit_code) {
+  std::string request = base::NumberToString(args.size() + 2);
+  request.push_back('\n');
+  AppendField(&request, startup_dir.value());
+  AppendField(&request, script.value());
+  for (const std::string& arg : args)
+    AppendField(&request, arg);
+
+  int64_t code;
+  if (!Write(request) || !ReadNumber(&code) || !ReadField(std_out) ||
+      !ReadField(std_err))
+    return false;
+  *exit_code = static_cast<int>(code);
+  return true;
+}
+
+bool ScriptHostPool::Host::Write(const std::string& data) {
+  size_t written = 0;
+  while (written < data.size()) {
+    ssize_t result = HANDLE_EINTR(send(fd_.get(), data.data() + written,
+                                       data.size() - written, kSendFlags));
+    if (result < 0)
+      return false;
+    written += result;
+  }
+  return true;
+}
+
+bool ScriptHostPool::Host::Fill() {
+  char buffer[65536];
+  ssize_t result = HANDLE_EINTR(read(fd_.get(), buffer, sizeof(buffer)));
+  if (result <= 0)
+    return false;
+  buffer_.append(buffer, result);
+  return true;
+}
+
+bool ScriptHostPool::Host::ReadLine(std::string* line) {
+  size_t end;
+  while ((end = buffer_.find('\n')) == std::string::npos) {
+    if (!Fill())
+      return false;
+  }
+  line->assign(buffer_, 0, end);
+  buffer_.erase(0, end + 1);
+  return true;
+}
+
+bool ScriptHostPool::Host::ReadNumber(int64_t* number) {
+  std::string line;
+  return ReadLine(&line) && base::StringToInt64(line, number);
+}
+
+bool ScriptHostPool::Host::ReadField(std::string* field) {
+  int64_t size;
+  if (!ReadNumber(&size) || size < 0)
+    return false;
+  while (buffer_.size() < static_cast<size_t>(size)) {
+    if (!Fill())
+      return false;
+  }
+  field->assign(buffer_, 0, size);
+  buffer_.erase(0, size);
+  return true;
+}
+#endif  // OS_WIN
+
+ScriptHostPool::ScriptHostPool() = default;
+
+ScriptHostPool::~ScriptHostPool() = default;
+
+bool ScriptHostPool::Run(const base::FilePath& interpreter,
+                         const base::FilePath& script,
+                         const std::vector<std::string>& args,
+                         const base::FilePath& startup_dir,
+                         std::string* std_out,
+                         std::string* std_err,
+                         int* exit_code) {
+#if defined(OS_WIN)
+  return false;
+#else
+  std::unique_ptr<Host> host;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    if (disabled_)
+      return false;
+    if (!idle_hosts_.empty()) {
+      host = std::move(idle_hosts_.back());
+      idle_hosts_.pop_back();
+    }
+  }
+
+  // Let the worker pool run other work while this thread waits on the host.
+  ScopedBlockingCall blocking_call;
+
+  if (!host) {
+    host = Host::Start(interpreter, startup_dir);
+    if (!host) {
+      std::lock_guard<std::mutex> lock(lock_);
+      disabled_ = true;
+      return false;
+    }
+  }
+
+  if (!host->Run(script, args, startup_dir, std_out, std_err, exit_code)) {
+    std_out->clear();
+    std_err->clear();
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(lock_);
+  idle_hosts_.push_back(std::move(host));
+  return true;
+#endif
+}
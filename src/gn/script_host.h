@@ -0,0 +1,62 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TOOLS_GN_SCRIPT_HOST_H_
+#define TOOLS_GN_SCRIPT_HOST_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace base {
+class FilePath;
+}  // namespace base
+
+// Runs the Python scripts of exec_script() in long-lived interpreter
+// processes, so that each call doesn't pay again for starting the interpreter
+// and importing the standard modules. See "exec_script_persistent" in
+// "gn help dotfile".
+//
+// Each host runs one script at a time. The pool starts a new host whenever
+// all the others are busy, and keeps them until it is destroyed. Between two
+// scripts, a host restores the environment, the search path and the modules
+// that aren't part of the Python installation.
+//
+// All functions are thread-safe.
+class ScriptHostPool {
+ public:
+  ScriptHostPool();
+  ~ScriptHostPool();
+
+  // Runs |script| with |args| in |startup_dir| using a host running the
+  // Python |interpreter|, with the same results as running it in a separate
+  // process. Returns false if no host could run the script, for example if it
+  // ended the interpreter, in which case it should be run in its own process.
+  bool Run(const base::FilePath& interpreter,
+           const base::FilePath& script,
+           const std::vector<std::string>& args,
+           const base::FilePath& startup_dir,
+           std::string* std_out,
+           std::string* std_err,
+           int* exit_code);
+
+ private:
+  class Host;
+
+  std::mutex lock_;
+
+  // Hosts that aren't running a script.
+  std::vector<std::unique_ptr<Host>> idle_hosts_;
+
+  // Set when a new host failed to start, after which the interpreter probably
+  // can't run hosts at all. A host that stops answering while running a script
+  // is only dropped, since that is usually caused by the script.
+  bool disabled_ = false;
+
+  ScriptHostPool(const ScriptHostPool&) = delete;
+  ScriptHostPool& operator=(const ScriptHostPool&) = delete;
+};
+
+#endif  // TOOLS_GN_SCRIPT_HOST_H_
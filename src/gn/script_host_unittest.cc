@@ -0,0 +1,115 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/script_host.h"
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "util/build_config.h"
+#include "util/test/test.h"
+
+// 'python3' isn't runnable on Windows, where the hosts aren't supported
+// anyway.
+#if !defined(OS_WIN)
+namespace {
+
+class ScriptHostTest : public testing::Test {
+ protected:
+  ScriptHostTest() {
+    CHECK(temp_dir_.CreateUniqueTempDir());
+    dir_ = base::MakeAbsoluteFilePath(temp_dir_.GetPath());
+  }
+
+  base::FilePath WriteScript(const std::string& name,
+                             const std::string& contents) {
+    base::FilePath path = dir_.AppendASCII(name);
+    EXPECT_EQ(static_cast<int>(contents.size()),
+              base::WriteFile(path, contents.data(), contents.size()));
+    return path;
+  }
+
+  bool RunScript(const base::FilePath& script,
+                 const std::vector<std::string>& args,
+                 std::string* std_out,
+                 std::string* std_err,
+                 int* exit_code) {
+    std_out->clear();
+    std_err->clear();
+    return pool_.Run(base::FilePath("python3"), script, args, dir_, std_out,
+                     std_err, exit_code);
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath dir_;
+  ScriptHostPool pool_;
+};
+
+}  // namespace
+
+TEST_F(ScriptHostTest, Run) {
+  base::FilePath script = WriteScript(
+      "script.py",
+      "import os, subprocess, sys\n"
+      "print(os.getpid(), os.getcwd(), sys.argv[1:])\n"
+      "sys.stdout.flush()\n"
+      "subprocess.call(['echo', 'child'])\n"
+      "print('error', file=sys.stderr)\n"
+      "sys.exit(int(sys.argv[1]))\n");
+
+  std::string std_out, std_err;
+  int exit_code = -1;
+  ASSERT_TRUE(
+      RunScript(script, {"0", "a b"}, &std_out, &std_err, &exit_code));
+  EXPECT_EQ(0, exit_code);
+  EXPECT_EQ("error\n", std_err);
+  std::string pid = std_out.substr(0, std_out.find(' '));
+  EXPECT_EQ(pid + " " + dir_.value() + " ['0', 'a b']\nchild\n", std_out);
+
+  // The same host runs the next script.
+  ASSERT_TRUE(RunScript(script, {"253"}, &std_out, &std_err, &exit_code));
+  EXPECT_EQ(253, exit_code);
+  EXPECT_EQ(pid + " " + dir_.value() + " ['253']\nchild\n", std_out);
+}
+
+TEST_F(ScriptHostTest, RestoresState) {
+  WriteScript("helper.py", "print('imported helper')\n");
+  base::FilePath script = WriteScript(
+      "script.py",
+      "import os, helper\n"
+      "print(os.environ.get('GN_SCRIPT_HOST_TEST'))\n"
+      "os.environ['GN_SCRIPT_HOST_TEST'] = '1'\n");
+
+  std::string std_out, std_err;
+  int exit_code = -1;
+  for (int i = 0; i < 2; i++) {
+    ASSERT_TRUE(RunScript(script, {}, &std_out, &std_err, &exit_code));
+    EXPECT_EQ(0, exit_code);
+    EXPECT_EQ("imported helper\nNone\n", std_out);
+  }
+}
+
+TEST_F(ScriptHostTest, Errors) {
+  std::string std_out, std_err;
+  int exit_code = -1;
+
+  base::FilePath raise = WriteScript("raise.py", "raise ValueError('bad')\n");
+  ASSERT_TRUE(RunScript(raise, {}, &std_out, &std_err, &exit_code));
+  EXPECT_EQ(1, exit_code);
+  EXPECT_EQ(0u, std_err.find("Traceback (most recent call last):\n  File \"" +
+                             raise.value() + "\", line 1"));
+  EXPECT_NE(std::string::npos, std_err.find("ValueError: bad\n"));
+
+  base::FilePath message = WriteScript("message.py", "exit('failed')\n");
+  ASSERT_TRUE(RunScript(message, {}, &std_out, &std_err, &exit_code));
+  EXPECT_EQ(1, exit_code);
+  EXPECT_EQ("failed\n", std_err);
+
+  // Ending the host fails the run, and another host takes over.
+  base::FilePath end = WriteScript("end.py", "import os\nos._exit(0)\n");
+  EXPECT_FALSE(RunScript(end, {}, &std_out, &std_err, &exit_code));
+  ASSERT_TRUE(RunScript(message, {}, &std_out, &std_err, &exit_code));
+  EXPECT_EQ(1, exit_code);
+}
+#endif  // !OS_WIN
@@ -25,6 +25,7 @@
 #include "gn/input_file.h"
 #include "gn/parse_tree.h"
 #include "gn/parser.h"
+#include "gn/script_host.h"
 #include "gn/source_dir.h"
 #include "gn/source_file.h"
 #include "gn/standard_out.h"
@@ -97,6 +98,20 @@ Variables
       default. They can be checked explicitly by running
       "gn check --check-system" or "gn gen --check=system"
 
+  exec_script_persistent [optional]
+      Boolean to run the scripts of exec_script calls in long-lived Python
+      processes instead of starting a new one for each call. This saves the
+      time it takes to start the interpreter and import modules, which
+      dominates for short scripts. It requires script_executable to be a
+      Python 3 interpreter, and is ignored on Windows.
+
+      The processes are reused by all the calls of a GN run. Between two
+      scripts, they restore the environment variables and the module search
+      path, and forget the modules that aren't part of the Python
+      installation. Scripts must not rely on atexit handlers or on the
+      process ending after they return. A script that ends the process, for
+      example by calling os._exit(), is run again in its own process.
+
   exec_script_whitelist [optional]
       A list of .gn/.gni files (not labels) that have permission to call the
       exec_script function. If this list is defined, calls to exec_script will
@@ -981,6 +996,16 @@ bool Setup::FillOtherConfig(const base::CommandLine& cmdline, Err* err) {
     check_system_includes_ = check_system_includes_value->boolean_value();
   }
 
+  const Value* exec_script_persistent_value =
+      dotfile_scope_.GetValue("exec_script_persistent", true);
+  if (exec_script_persistent_value) {
+    if (!exec_script_persistent_value->VerifyTypeIs(Value::BOOLEAN, err)) {
+      return false;
+    }
+    if (exec_script_persistent_value->boolean_value())
+      build_settings_.set_script_host_pool(std::make_unique<ScriptHostPool>());
+  }
+
   // Fill exec_script_whitelist.
   const Value* exec_script_whitelist_value =
       dotfile_scope_.GetValue("exec_script_whitelist", true);
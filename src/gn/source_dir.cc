@@ -88,17 +88,15 @@ std::string SourceDir::ResolveRelativeAs(bool as_file,
 SourceFile SourceDir::ResolveRelativeFile(const Value& p,
                                           Err* err,
                                           std::string_view source_root) const {
-  SourceFile ret;
-
   if (!p.VerifyTypeIs(Value::STRING, err))
-    return ret;
+    return SourceFile();
 
   const std::string& input_string = p.string_value();
   if (!ValidateResolveInput(true, p, input_string, err))
-    return ret;
+    return SourceFile();
 
-  ret.SetValue(ResolveRelative(input_string, value_.str(), true, source_root));
-  return ret;
+  return SourceFile(StringAtom(
+      ResolveRelative(input_string, value_.str(), true, source_root)));
 }
 
 SourceDir SourceDir::ResolveRelativeDir(const Value& blame_input_value,
@@ -6,6 +6,10 @@
 
 #include "gn/source_file.h"
 
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
 #include "base/logging.h"
 #include "gn/filesystem_utils.h"
 #include "gn/source_dir.h"
@@ -128,63 +132,64 @@ SourceFile::SourceFile(const std::string& value)
 SourceFile::SourceFile(std::string&& value)
     : SourceFile(StringAtom(Normalized(std::move(value)))) {}
 
-SourceFile::SourceFile(StringAtom value) : value_(value) {}
+const SourceFile::Info SourceFile::kEmptyInfo;
 
-SourceFile::Type SourceFile::GetType() const {
-  return GetSourceFileType(value_.str());
-}
+SourceFile::SourceFile(StringAtom value) : info_(GetInfo(value)) {}
 
-bool SourceFile::IsDefType() const {
-  std::string_view v = value_.str();
-  return EndsWithExtension(v, "def");
-}
-
-bool SourceFile::IsObjectType() const {
-  std::string_view v = value_.str();
-  return EndsWithExtension(v, "o") || EndsWithExtension(v, "obj");
-}
-
-bool SourceFile::IsModuleMapType() const {
-  std::string_view v = value_.str();
-  return EndsWithExtension(v, "modulemap");
-}
-
-bool SourceFile::IsSwiftType() const {
-  std::string_view v = value_.str();
-  return EndsWithExtension(v, "swift");
-}
-
-bool SourceFile::IsSwiftModuleType() const {
-  std::string_view v = value_.str();
-  return EndsWithExtension(v, "swiftmodule");
-}
-
-std::string SourceFile::GetName() const {
-  if (is_null())
-    return std::string();
-
-  const std::string& value = value_.str();
-  DCHECK(value.find('/') != std::string::npos);
-  size_t last_slash = value.rfind('/');
-  return std::string(&value[last_slash + 1], value.size() - last_slash - 1);
+std::string_view SourceFile::GetNameNoExtension() const {
+  const std::string& path = value();
+  size_t name_len;
+  if (info_->extension_offset == std::string::npos)
+    name_len = path.size() - info_->name_offset;
+  else
+    name_len = info_->extension_offset - info_->name_offset - 1;
+  return std::string_view(path.data() + info_->name_offset, name_len);
 }
 
 SourceDir SourceFile::GetDir() const {
-  if (is_null())
-    return SourceDir();
-
-  const std::string& value = value_.str();
-  DCHECK(value.find('/') != std::string::npos);
-  size_t last_slash = value.rfind('/');
-  return SourceDir(value.substr(0, last_slash + 1));
+  SourceDir dir;
+  dir.value_ = info_->dir;
+  return dir;
 }
 
 base::FilePath SourceFile::Resolve(const base::FilePath& source_root) const {
-  return ResolvePath(value_.str(), true, source_root);
-}
-
-void SourceFile::SetValue(const std::string& value) {
-  value_ = StringAtom(value);
+  return ResolvePath(value(), true, source_root);
+}
+
+// static
+const SourceFile::Info* SourceFile::GetInfo(StringAtom value) {
+  if (value.empty())
+    return &kEmptyInfo;
+
+  // Like for StringAtoms, each thread has its own cache so the global mutex is
+  // only taken on a miss. Infos are never freed, and deques never move their
+  // elements.
+  using InfoMap = std::unordered_map<const std::string*, const Info*>;
+  static std::mutex& mutex = *new std::mutex;
+  static InfoMap& infos = *new InfoMap;
+  static std::deque<Info>& storage = *new std::deque<Info>;
+  thread_local InfoMap local_infos;
+
+  const Info*& local_info = local_infos[&value.str()];
+  if (local_info)
+    return local_info;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  const Info*& info = infos[&value.str()];
+  if (!info) {
+    const std::string& path = value.str();
+    storage.emplace_back();
+    Info& new_info = storage.back();
+    new_info.value = value;
+    new_info.dir =
+        StringAtom(std::string_view(path).substr(0, path.rfind('/') + 1));
+    new_info.type = GetSourceFileType(path);
+    new_info.name_offset = FindFilenameOffset(path);
+    new_info.extension_offset = FindExtensionOffset(path);
+    info = &new_info;
+  }
+  local_info = info;
+  return info;
 }
 
 SourceFileTypeSet::SourceFileTypeSet() : empty_(true) {
@@ -48,7 +48,7 @@ class SourceFile {
     SOURCE_NUMTYPES,
   };
 
-  SourceFile() = default;
+  SourceFile() : info_(&kEmptyInfo) {}
 
   // Takes a known absolute source file. Always begins in a slash.
   explicit SourceFile(const std::string& value);
@@ -57,19 +57,25 @@ class SourceFile {
 
   ~SourceFile() = default;
 
-  bool is_null() const { return value_.empty(); }
-  const std::string& value() const { return value_.str(); }
-  Type GetType() const;
+  bool is_null() const { return info_->value.empty(); }
+  const std::string& value() const { return info_->value.str(); }
+  Type GetType() const { return info_->type; }
 
-  // Optimized implementation of GetType() == SOURCE_XXX
-  bool IsDefType() const;          // SOURCE_DEF
-  bool IsModuleMapType() const;    // SOURCE_MODULEMAP
-  bool IsObjectType() const;       // SOURCE_O
-  bool IsSwiftType() const;        // SOURCE_SWIFT
-  bool IsSwiftModuleType() const;  // SOURCE_SWIFTMODULE
+  // Shorthands for GetType() == SOURCE_XXX
+  bool IsDefType() const { return GetType() == SOURCE_DEF; }
+  bool IsModuleMapType() const { return GetType() == SOURCE_MODULEMAP; }
+  bool IsObjectType() const { return GetType() == SOURCE_O; }
+  bool IsSwiftType() const { return GetType() == SOURCE_SWIFT; }
+  bool IsSwiftModuleType() const { return GetType() == SOURCE_SWIFTMODULE; }
 
   // Returns everything after the last slash.
-  std::string GetName() const;
+  std::string GetName() const {
+    return value().substr(info_->dir.str().size());
+  }
+
+  // Returns the name without the extension nor its dot.
+  std::string_view GetNameNoExtension() const;
+
   SourceDir GetDir() const;
 
   // Resolves this source file relative to some given source root. Returns
@@ -97,37 +103,52 @@ class SourceFile {
     return std::string_view(&value()[1], value().size() - 1);
   }
 
+  // There is one Info per path, so comparing them is like comparing the
+  // StringAtoms.
   bool operator==(const SourceFile& other) const {
-    return value_.SameAs(other.value_);
+    return info_ == other.info_;
   }
   bool operator!=(const SourceFile& other) const { return !operator==(other); }
   bool operator<(const SourceFile& other) const {
-    return value_ < other.value_;
+    return info_->value < other.info_->value;
   }
 
   struct PtrCompare {
     bool operator()(const SourceFile& a, const SourceFile& b) const noexcept {
-      return StringAtom::PtrCompare()(a.value_, b.value_);
+      return StringAtom::PtrCompare()(a.info_->value, b.info_->value);
     }
   };
   struct PtrHash {
     size_t operator()(const SourceFile& s) const noexcept {
-      return StringAtom::PtrHash()(s.value_);
+      return StringAtom::PtrHash()(s.info_->value);
     }
   };
 
   struct PtrEqual {
     bool operator()(const SourceFile& a, const SourceFile& b) const noexcept {
-      return StringAtom::PtrEqual()(a.value_, b.value_);
+      return a.info_ == b.info_;
     }
   };
 
  private:
-  friend class SourceDir;
+  // The properties of a path, computed once when the first SourceFile for it
+  // is created so the accessors don't need to scan the string. Lives until
+  // the process exits, like StringAtoms.
+  struct Info {
+    StringAtom value;
+    StringAtom dir;  // The value of GetDir(), up to the last '/'.
+    Type type = SOURCE_UNKNOWN;
+    size_t name_offset = 0;  // See FindFilenameOffset().
+    size_t extension_offset = std::string::npos;  // See FindExtensionOffset().
+  };
+
+  static const Info kEmptyInfo;
 
-  void SetValue(const std::string& value);
+  // Returns the Info for |value|, creating it on first use.
+  static const Info* GetInfo(StringAtom value);
 
-  StringAtom value_;
+  // Never null.
+  const Info* info_;
 };
 
 namespace std {
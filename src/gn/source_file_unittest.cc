@@ -4,6 +4,7 @@
 
 #include "gn/source_file.h"
 
+#include "gn/source_dir.h"
 #include "util/test/test.h"
 
 // The SourceFile object should normalize the input passed to the constructor.
@@ -60,3 +61,27 @@ TEST(SourceFile, GetType) {
     EXPECT_EQ(data.type, SourceFile(data.path).GetType());
   }
 }
+
+TEST(SourceFile, NameAndDir) {
+  SourceFile a("//foo/bar/baz.pb.cc");
+  EXPECT_EQ("baz.pb.cc", a.GetName());
+  EXPECT_EQ("baz.pb", a.GetNameNoExtension());
+  EXPECT_EQ("//foo/bar/", a.GetDir().value());
+  EXPECT_EQ(SourceFile::SOURCE_CPP, a.GetType());
+
+  SourceFile b("/abs/Makefile");
+  EXPECT_EQ("Makefile", b.GetName());
+  EXPECT_EQ("Makefile", b.GetNameNoExtension());
+  EXPECT_EQ("/abs/", b.GetDir().value());
+  EXPECT_EQ(SourceFile::SOURCE_UNKNOWN, b.GetType());
+
+  // Files with the same path share their properties.
+  SourceFile c(std::string("//foo/bar/baz.pb.cc"));
+  EXPECT_EQ(a, c);
+  EXPECT_EQ(a.GetDir(), c.GetDir());
+
+  SourceFile null;
+  EXPECT_TRUE(null.is_null());
+  EXPECT_EQ("", null.GetName());
+  EXPECT_TRUE(null.GetDir().is_null());
+}
@@ -4,11 +4,16 @@
 
 #include "gn/string_output_buffer.h"
 
+#include <algorithm>
+#include <charconv>
+
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/logging.h"
 #include "gn/err.h"
 #include "gn/file_writer.h"
 #include "gn/filesystem_utils.h"
+#include "gn/output_manifest.h"
 
 #include <fstream>
 
@@ -18,37 +23,132 @@ std::string StringOutputBuffer::str() const {
   result.reserve(data_size);
   for (size_t nn = 0; nn < pages_.size(); ++nn) {
     size_t wanted_size = std::min(kPageSize, data_size - nn * kPageSize);
-    result.append(pages_[nn]->data(), wanted_size);
+    result.append(pages_[nn].get(), wanted_size);
   }
   return result;
 }
 
-void StringOutputBuffer::Append(const char* str, size_t len) {
-  Append(std::string_view(str, len));
-}
-
-void StringOutputBuffer::Append(std::string_view str) {
+void StringOutputBuffer::AppendToNewPages(std::string_view str) {
   while (str.size() > 0) {
     if (page_free_size() == 0) {
-      // Allocate a new page.
-      pages_.push_back(std::make_unique<Page>());
-      pos_ = 0;
+      // Pages are left uninitialized.
+      if (pages_.size() == 1 && page_size_ < kPageSize) {
+        // Grow the first page.
+        size_t new_size =
+            std::min(kPageSize, std::max(page_size_ * 2, pos_ + str.size()));
+        std::unique_ptr<char[]> page(new char[new_size]);
+        memcpy(page.get(), page_, pos_);
+        pages_[0] = std::move(page);
+        page_size_ = new_size;
+      } else {
+        page_size_ = pages_.empty()
+                         ? std::min(kPageSize,
+                                    std::max(kFirstPageSize, str.size()))
+                         : kPageSize;
+        pages_.push_back(std::unique_ptr<char[]>(new char[page_size_]));
+        pos_ = 0;
+      }
+      page_ = pages_.back().get();
     }
     size_t size = std::min(page_free_size(), str.size());
-    memcpy(pages_.back()->data() + pos_, str.data(), size);
+    memcpy(page_ + pos_, str.data(), size);
     pos_ += size;
     str.remove_prefix(size);
   }
 }
 
-void StringOutputBuffer::Append(char c) {
-  if (page_free_size() == 0) {
-    // Allocate a new page.
-    pages_.push_back(std::make_unique<Page>());
-    pos_ = 0;
+void StringOutputBuffer::AppendNumber(int64_t value) {
+  char buffer[24];
+  char* end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+  Append(std::string_view(buffer, end - buffer));
+}
+
+void StringOutputBuffer::AppendNumber(uint64_t value) {
+  char buffer[24];
+  char* end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+  Append(std::string_view(buffer, end - buffer));
+}
+
+void StringOutputBuffer::WriteRange(std::ostream& out,
+                                    size_t begin,
+                                    size_t end) const {
+  DCHECK_LE(begin, end);
+  DCHECK_LE(end, size());
+  while (begin < end) {
+    size_t offset = begin % kPageSize;
+    size_t wanted_size = std::min(kPageSize - offset, end - begin);
+    out.write(pages_[begin / kPageSize].get() + offset, wanted_size);
+    begin += wanted_size;
+  }
+}
+
+void StringOutputBuffer::WriteRange(StringOutputBuffer* out,
+                                    size_t begin,
+                                    size_t end) const {
+  DCHECK_NE(out, this);
+  DCHECK_LE(begin, end);
+  DCHECK_LE(end, size());
+  while (begin < end) {
+    size_t offset = begin % kPageSize;
+    size_t wanted_size = std::min(kPageSize - offset, end - begin);
+    out->Append(pages_[begin / kPageSize].get() + offset, wanted_size);
+    begin += wanted_size;
+  }
+}
+
+bool StringOutputBuffer::WriteRange(FileWriter* out,
+                                    size_t begin,
+                                    size_t end) const {
+  DCHECK_LE(begin, end);
+  DCHECK_LE(end, size());
+  while (begin < end) {
+    size_t offset = begin % kPageSize;
+    size_t wanted_size = std::min(kPageSize - offset, end - begin);
+    if (!out->Write(
+            std::string_view(pages_[begin / kPageSize].get() + offset,
+                             wanted_size)))
+      return false;
+    begin += wanted_size;
+  }
+  return true;
+}
+
+uint64_t StringOutputBuffer::ContentsHash() const {
+  // MurmurHash64A, reading the pages as one contiguous string. Every page but
+  // the last one is full, and kPageSize is a multiple of the word size.
+  constexpr uint64_t kMul = 0xc6a4a7935bd1e995ULL;
+  constexpr int kShift = 47;
+  static_assert(kPageSize % sizeof(uint64_t) == 0);
+
+  size_t data_size = size();
+  uint64_t hash = data_size * kMul;
+  for (size_t nn = 0; nn < pages_.size(); ++nn) {
+    const char* data = pages_[nn].get();
+    size_t page_size = std::min(data_size - nn * kPageSize, kPageSize);
+    size_t words = page_size / sizeof(uint64_t);
+    for (size_t i = 0; i < words; i++) {
+      uint64_t word;
+      memcpy(&word, data + i * sizeof(uint64_t), sizeof(word));
+      word *= kMul;
+      word ^= word >> kShift;
+      word *= kMul;
+      hash ^= word;
+      hash *= kMul;
+    }
+
+    size_t tail_size = page_size % sizeof(uint64_t);
+    if (tail_size) {
+      uint64_t tail = 0;
+      memcpy(&tail, data + words * sizeof(uint64_t), tail_size);
+      hash ^= tail;
+      hash *= kMul;
+    }
   }
-  pages_.back()->data()[pos_] = c;
-  pos_ += 1;
+
+  hash ^= hash >> kShift;
+  hash *= kMul;
+  hash ^= hash >> kShift;
+  return hash;
 }
 
 bool StringOutputBuffer::ContentsEqual(const base::FilePath& file_path) const {
@@ -74,7 +174,7 @@ bool StringOutputBuffer::ContentsEqual(const base::FilePath& file_path) const {
     if (!file.good())
       return false;
 
-    if (memcmp(file_page.data(), pages_[nn]->data(), wanted_size) != 0)
+    if (memcmp(file_page.data(), pages_[nn].get(), wanted_size) != 0)
       return false;
   }
   return true;
@@ -84,7 +184,7 @@ bool StringOutputBuffer::ContentsEqual(const base::FilePath& file_path) const {
 bool StringOutputBuffer::WriteToFile(const base::FilePath& file_path,
                                      Err* err) const {
   // Create the directory if necessary.
-  if (!base::CreateDirectory(file_path.DirName())) {
+  if (!CreateDirectoryCached(file_path.DirName())) {
     if (err) {
       *err =
           Err(Location(), "Unable to create directory.",
@@ -101,7 +201,7 @@ bool StringOutputBuffer::WriteToFile(const base::FilePath& file_path,
   if (success) {
     for (size_t nn = 0; nn < page_count; ++nn) {
       size_t wanted_size = std::min(data_size - nn * kPageSize, kPageSize);
-      success = writer.Write(std::string_view(pages_[nn]->data(), wanted_size));
+      success = writer.Write(std::string_view(pages_[nn].get(), wanted_size));
       if (!success)
         break;
     }
@@ -118,8 +218,17 @@ bool StringOutputBuffer::WriteToFile(const base::FilePath& file_path,
 
 bool StringOutputBuffer::WriteToFileIfChanged(const base::FilePath& file_path,
                                               Err* err) const {
-  if (ContentsEqual(file_path))
-    return true;
+  if (!g_output_manifest) {
+    if (ContentsEqual(file_path))
+      return true;
+    return WriteToFile(file_path, err);
+  }
 
-  return WriteToFile(file_path, err);
+  uint64_t hash = ContentsHash();
+  if (g_output_manifest->IsUnchanged(file_path, size(), hash))
+    return true;
+  if (!ContentsEqual(file_path) && !WriteToFile(file_path, err))
+    return false;
+  g_output_manifest->Record(file_path, size(), hash);
+  return true;
 }
@@ -5,11 +5,16 @@
 #ifndef TOOLS_GN_STRING_OUTPUT_BUFFER_H_
 #define TOOLS_GN_STRING_OUTPUT_BUFFER_H_
 
+#include <stdint.h>
+#include <string.h>
+
 #include <array>
 #include <memory>
+#include <ostream>
 #include <streambuf>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace base {
@@ -17,6 +22,7 @@ class FilePath;
 }  // namespace base
 
 class Err;
+class FileWriter;
 
 // An append-only very large storage area for string data. Useful for the parts
 // of GN that need to generate huge output files (e.g. --ide=json will create
@@ -26,7 +32,10 @@ class Err;
 //
 //   1) Create instance.
 //
-//   2) Use operator<<, or Append() to append data to the instance.
+//   2) Use operator<<, or Append() to append data to the instance. Strings,
+//      characters and integers can be appended directly. This is what the
+//      Ninja writers use since appending is inline and doesn't go through
+//      the virtual calls and locale handling of std::ostream.
 //
 //   3) Alternatively, create an std::ostream that takes its address as
 //      argument, then use the output stream as usual to append data to it.
@@ -48,17 +57,65 @@ class StringOutputBuffer : public std::streambuf {
   std::string str() const;
 
   // Return the number of characters stored in this instance.
-  size_t size() const { return (pages_.size() - 1u) * kPageSize + pos_; }
+  size_t size() const {
+    return pages_.empty() ? 0 : (pages_.size() - 1u) * kPageSize + pos_;
+  }
 
   // Append string to this instance.
-  void Append(const char* str, size_t len);
-  void Append(std::string_view str);
-  void Append(char c);
+  void Append(const char* str, size_t len) {
+    Append(std::string_view(str, len));
+  }
+  void Append(std::string_view str) {
+    if (str.size() < page_free_size()) {
+      memcpy(page_ + pos_, str.data(), str.size());
+      pos_ += str.size();
+    } else {
+      AppendToNewPages(str);
+    }
+  }
+  void Append(char c) {
+    if (pos_ < page_size_)
+      page_[pos_++] = c;
+    else
+      AppendToNewPages(std::string_view(&c, 1));
+  }
+
+  // Append the decimal representation of an integer.
+  void AppendNumber(int64_t value);
+  void AppendNumber(uint64_t value);
 
   StringOutputBuffer& operator<<(std::string_view str) {
     Append(str);
     return *this;
   }
+  StringOutputBuffer& operator<<(char c) {
+    Append(c);
+    return *this;
+  }
+  template <typename T,
+            typename = std::enable_if_t<std::is_integral_v<T> &&
+                                        !std::is_same_v<T, bool> &&
+                                        !std::is_same_v<T, char>>>
+  StringOutputBuffer& operator<<(T value) {
+    if constexpr (std::is_signed_v<T>)
+      AppendNumber(static_cast<int64_t>(value));
+    else
+      AppendNumber(static_cast<uint64_t>(value));
+    return *this;
+  }
+
+  // Write the characters in the [begin, end) range of this instance to |out|.
+  // Useful to copy out parts of a buffer shared by several writers, given
+  // the values of size() before and after each of them appended its data.
+  void WriteRange(std::ostream& out, size_t begin, size_t end) const;
+  void WriteRange(StringOutputBuffer* out, size_t begin, size_t end) const;
+
+  // Same, returning false if writing to |out| failed.
+  bool WriteRange(FileWriter* out, size_t begin, size_t end) const;
+
+  // Returns a fast non-cryptographic hash of the content, used to recognize
+  // outputs identical to the ones written by a previous run.
+  uint64_t ContentsHash() const;
 
   // Compare the content of this instance with that of the file at |file_path|.
   bool ContentsEqual(const base::FilePath& file_path) const;
@@ -67,7 +124,8 @@ class StringOutputBuffer : public std::streambuf {
   bool WriteToFile(const base::FilePath& file_path, Err* err) const;
 
   // Write the contents of this instance to a file at |file_path| unless the
-  // file already exists and the contents are equal.
+  // file already exists and the contents are equal. When generating, the
+  // OutputManifest is used to know that without reading the file back.
   bool WriteToFileIfChanged(const base::FilePath& file_path, Err* err) const;
 
   static size_t GetPageSizeForTesting() { return kPageSize; }
@@ -87,13 +145,25 @@ class StringOutputBuffer : public std::streambuf {
 
  private:
   // Return the number of free bytes in the current page.
-  size_t page_free_size() const { return kPageSize - pos_; }
+  size_t page_free_size() const { return page_size_ - pos_; }
+
+  // Append |str|, which doesn't fit in the current page.
+  void AppendToNewPages(std::string_view str);
 
   static constexpr size_t kPageSize = 65536;
   using Page = std::array<char, kPageSize>;
 
-  size_t pos_ = kPageSize;
-  std::vector<std::unique_ptr<Page>> pages_;
+  // The first page starts this small and grows up to kPageSize, so that
+  // buffers used for short strings don't cost a full page. All the other
+  // pages are kPageSize bytes.
+  static constexpr size_t kFirstPageSize = 256;
+
+  std::vector<std::unique_ptr<char[]>> pages_;
+
+  // The last page, its size and the number of bytes used in it.
+  char* page_ = nullptr;
+  size_t page_size_ = 0;
+  size_t pos_ = 0;
 };
 
 #endif  // TOOLS_GN_STRING_OUTPUT_BUFFER_H_
@@ -4,6 +4,8 @@
 
 #include "gn/string_output_buffer.h"
 
+#include <sstream>
+
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
@@ -61,6 +63,35 @@ TEST(StringOutputBuffer, AppendWithPageSizeMultiples) {
   ASSERT_STREQ(data.c_str(), buffer.str().c_str());
 }
 
+TEST(StringOutputBuffer, AppendValues) {
+  StringOutputBuffer buffer;
+  buffer << "abc" << 'd' << std::string("ef") << 0 << ' ' << -42 << ' '
+         << static_cast<size_t>(18446744073709551615u) << ' '
+         << static_cast<int64_t>(-9223372036854775807 - 1);
+  EXPECT_EQ("abcdef0 -42 18446744073709551615 -9223372036854775808",
+            buffer.str());
+}
+
+// The first page grows from a small size, make sure the data is kept when
+// the appended strings cross its successive sizes and the page boundaries.
+TEST(StringOutputBuffer, AppendGrowing) {
+  const size_t page_size = StringOutputBuffer::GetPageSizeForTesting();
+  std::string data = CreateTestString(page_size * 2 + 100);
+
+  for (size_t step : {1u, 7u, 300u, 5000u}) {
+    StringOutputBuffer buffer;
+    for (size_t offset = 0; offset < data.size(); offset += step) {
+      std::string_view piece = std::string_view(data).substr(offset, step);
+      if (step == 1)
+        buffer.Append(piece[0]);
+      else
+        buffer.Append(piece);
+    }
+    EXPECT_EQ(data.size(), buffer.size());
+    EXPECT_TRUE(data == buffer.str()) << step;
+  }
+}
+
 TEST(StringOutput, WrappedByStdOstream) {
   const size_t data_size = 100000;
   std::string data = CreateTestString(data_size);
@@ -81,6 +112,30 @@ TEST(StringOutput, WrappedByStdOstream) {
   ASSERT_STREQ(data.c_str(), buffer.str().c_str());
 }
 
+TEST(StringOutputBuffer, WriteRange) {
+  const size_t page_size = StringOutputBuffer::GetPageSizeForTesting();
+  const size_t data_size = page_size * 3 + 17;
+  std::string data = CreateTestString(data_size);
+
+  StringOutputBuffer buffer;
+  buffer.Append(data);
+
+  const std::pair<size_t, size_t> ranges[] = {
+      {0, 0},
+      {0, 10},
+      {5, page_size},
+      {page_size - 3, page_size + 3},
+      {page_size, 2 * page_size},
+      {1, data_size},
+      {data_size - 1, data_size},
+  };
+  for (const auto& range : ranges) {
+    std::ostringstream out;
+    buffer.WriteRange(out, range.first, range.second);
+    EXPECT_EQ(data.substr(range.first, range.second - range.first), out.str());
+  }
+}
+
 TEST(StringOutputBuffer, ContentsEqual) {
   base::ScopedTempDir temp_dir;
   ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
@@ -2,11 +2,10 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
-#include <sstream>
-
 #include "gn/c_substitution_type.h"
 #include "gn/err.h"
 #include "gn/escape.h"
+#include "gn/string_output_buffer.h"
 #include "gn/substitution_list.h"
 #include "gn/substitution_pattern.h"
 #include "gn/substitution_writer.h"
@@ -71,7 +70,7 @@ TEST(SubstitutionWriter, WriteNinjaVariablesForSource) {
   EscapeOptions options;
   options.mode = ESCAPE_NONE;
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   SubstitutionWriter::WriteNinjaVariablesForSource(
       nullptr, setup.settings(), SourceFile("//foo/bar/baz.txt"), types,
       options, out);
@@ -94,7 +93,7 @@ TEST(SubstitutionWriter, WriteWithNinjaVariables) {
   EscapeOptions options;
   options.mode = ESCAPE_NONE;
 
-  std::ostringstream out;
+  StringOutputBuffer out;
   SubstitutionWriter::WriteWithNinjaVariables(pattern, options, out);
 
   EXPECT_EQ("-i ${in} --out=bar\"${source_name_part}\".o", out.str());
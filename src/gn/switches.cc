@@ -259,8 +259,12 @@ const char kThreads_Help[] =
   challenging. Or you may want to experiment with different values to see how
   it affects performance.
 
-  The parameter is the number of worker threads. This does not count the main
-  thread (so there are always at least two).
+  The parameter is the number of worker threads for CPU-bound work. This does
+  not count the main thread (so there are always at least two), nor the
+  threads that wait on file reads and scripts.
+
+  By default, the number of threads is based on the processors available to
+  GN, taking into account its CPU affinity and cgroup CPU quota.
 
 Examples
 
@@ -286,11 +290,14 @@ const char kTracelog_HelpShort[] =
 const char kTracelog_Help[] =
     R"(--tracelog: Writes a Chrome-compatible trace log to the given file.
 
-  The trace log will show file loads, executions, scripts, and writes. This
-  allows performance analysis of the generation step.
+  The trace log will show file loads, executions, scripts, target resolution
+  and writes, along with counter tracks for the worker pool queue depths, the
+  number of pending loads and the resident memory of the process. This allows
+  performance analysis of the generation step.
 
   To view the trace, open Chrome and navigate to "chrome://tracing/", then
-  press "Load" and specify the file you passed to this parameter.
+  press "Load" and specify the file you passed to this parameter. The file
+  can also be opened in the Perfetto UI (https://ui.perfetto.dev).
 
 Examples
 
@@ -6,6 +6,11 @@
 
 #include <stddef.h>
 
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 #include "base/stl_util.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
@@ -14,6 +19,7 @@
 #include "gn/deps_iterator.h"
 #include "gn/filesystem_utils.h"
 #include "gn/functions.h"
+#include "gn/label_pattern_set.h"
 #include "gn/scheduler.h"
 #include "gn/substitution_writer.h"
 #include "gn/tool.h"
@@ -141,58 +147,28 @@ bool EnsureFileIsGeneratedByDependency(const Target* target,
   return false;
 }
 
-// check_this indicates if the given target should be matched against the
-// patterns. It should be set to false for the first call since assert_no_deps
-// shouldn't match the target itself.
-//
-// visited should point to an empty set, this will be used to prevent
-// multiple visits.
-//
-// *failure_path_str will be filled with a string describing the path of the
-// dependency failure, and failure_pattern will indicate the pattern in
-// assert_no that matched the target.
-//
-// Returns true if everything is OK. failure_path_str and failure_pattern_index
-// will be unchanged in this case.
-bool RecursiveCheckAssertNoDeps(const Target* target,
-                                bool check_this,
-                                const std::vector<LabelPattern>& assert_no,
-                                TargetSet* visited,
-                                std::string* failure_path_str,
-                                const LabelPattern** failure_pattern) {
-  static const char kIndentPath[] = "  ";
-
-  if (!visited->add(target))
-    return true;  // Already checked this target.
-
-  if (check_this) {
-    // Check this target against the given list of patterns.
-    for (const LabelPattern& pattern : assert_no) {
-      if (pattern.Matches(target->label())) {
-        // Found a match.
-        *failure_pattern = &pattern;
-        *failure_path_str =
-            kIndentPath + target->label().GetUserVisibleName(false);
-        return false;
-      }
-    }
+// Returns the compiled set for the given list of assert_no_deps patterns.
+// Lists with the same contents share the same set, so that targets sharing
+// their assert_no_deps also share the memoized results of checking their
+// dependencies. Sets are never destroyed.
+const LabelPatternSet* GetAssertNoDepsPatternSet(
+    const std::vector<LabelPattern>& patterns) {
+  static std::mutex lock;
+  static std::unordered_map<std::string, std::unique_ptr<LabelPatternSet>>*
+      pattern_sets = new std::unordered_map<
+          std::string, std::unique_ptr<LabelPatternSet>>();
+
+  std::string key;
+  for (const LabelPattern& pattern : patterns) {
+    key.append(pattern.Describe());
+    key.push_back('\n');
   }
 
-  // Recursively check dependencies.
-  for (const auto& pair : target->GetDeps(Target::DEPS_ALL)) {
-    if (pair.ptr->output_type() == Target::EXECUTABLE)
-      continue;
-    if (!RecursiveCheckAssertNoDeps(pair.ptr, true, assert_no, visited,
-                                    failure_path_str, failure_pattern)) {
-      // To reconstruct the path, prepend the current target to the error.
-      std::string prepend_path =
-          kIndentPath + target->label().GetUserVisibleName(false) + " ->\n";
-      failure_path_str->insert(0, prepend_path);
-      return false;
-    }
-  }
-
-  return true;
+  std::lock_guard<std::mutex> guard(lock);
+  std::unique_ptr<LabelPatternSet>& pattern_set = (*pattern_sets)[key];
+  if (!pattern_set)
+    pattern_set = std::make_unique<LabelPatternSet>(patterns);
+  return pattern_set.get();
 }
 
 }  // namespace
@@ -288,8 +264,7 @@ Dependencies
 Target::Target(const Settings* settings,
                const Label& label,
                const SourceFileSet& build_dependency_files)
-    : Item(settings, label, build_dependency_files),
-      jumbo_file_merge_limit_(kDefaultJumboFileMergeLimit) {}
+    : Item(settings, label, build_dependency_files) {}
 
 Target::~Target() = default;
 
@@ -331,6 +306,12 @@ BundleData& Target::bundle_data() {
   return *bundle_data_;
 }
 
+static const TargetSet kEmptyTargetSet;
+
+const TargetSet& Target::recursive_hard_deps() const {
+  return recursive_hard_deps_ ? *recursive_hard_deps_ : kEmptyTargetSet;
+}
+
 static ConfigValues kEmptyConfigValues;
 
 const ConfigValues& Target::config_values() const {
@@ -391,6 +372,55 @@ Metadata& Target::metadata() {
   return *metadata_;
 }
 
+const Target::LinkedTargets Target::kEmptyLinkedTargets;
+
+const Target::LinkedTargets& Target::linked_targets() const {
+  return linked_targets_ ? *linked_targets_ : kEmptyLinkedTargets;
+}
+
+Target::LinkedTargets& Target::linked_targets() {
+  if (!linked_targets_)
+    linked_targets_ = std::make_unique<Target::LinkedTargets>();
+  return *linked_targets_;
+}
+
+const Target::LinkSettings Target::kEmptyLinkSettings;
+
+const Target::LinkSettings& Target::link_settings() const {
+  return link_settings_ ? *link_settings_ : kEmptyLinkSettings;
+}
+
+Target::LinkSettings& Target::link_settings() {
+  if (!link_settings_)
+    link_settings_ = std::make_unique<Target::LinkSettings>();
+  return *link_settings_;
+}
+
+const Target::DepRules Target::kEmptyDepRules;
+
+const Target::DepRules& Target::dep_rules() const {
+  return dep_rules_ ? *dep_rules_ : kEmptyDepRules;
+}
+
+Target::DepRules& Target::dep_rules() {
+  if (!dep_rules_)
+    dep_rules_ = std::make_unique<Target::DepRules>();
+  return *dep_rules_;
+}
+
+const Target::JumboValues Target::kEmptyJumboValues = {
+    std::nullopt, {}, kDefaultJumboFileMergeLimit, {}};
+
+const Target::JumboValues& Target::jumbo_values() const {
+  return jumbo_values_ ? *jumbo_values_ : kEmptyJumboValues;
+}
+
+Target::JumboValues& Target::jumbo_values() {
+  if (!jumbo_values_)
+    jumbo_values_ = std::make_unique<Target::JumboValues>(kEmptyJumboValues);
+  return *jumbo_values_;
+}
+
 static const Target::GeneratedFile kEmptyGeneratedFile;
 
 const Target::GeneratedFile& Target::generated_file() const {
@@ -492,14 +522,20 @@ bool Target::OnResolved(Err* err) {
   // order (local ones first, then the dependency's).
   for (ConfigValuesIterator iter(this); !iter.done(); iter.Next()) {
     const ConfigValues& cur = iter.cur();
-    all_lib_dirs_.Append(cur.lib_dirs().begin(), cur.lib_dirs().end());
-    all_libs_.Append(cur.libs().begin(), cur.libs().end());
-
-    all_framework_dirs_.Append(cur.framework_dirs().begin(),
-                               cur.framework_dirs().end());
-    all_frameworks_.Append(cur.frameworks().begin(), cur.frameworks().end());
-    all_weak_frameworks_.Append(cur.weak_frameworks().begin(),
-                                cur.weak_frameworks().end());
+    if (cur.lib_dirs().empty() && cur.libs().empty() &&
+        cur.framework_dirs().empty() && cur.frameworks().empty() &&
+        cur.weak_frameworks().empty())
+      continue;
+    LinkSettings& link = link_settings();
+    link.all_lib_dirs_.Append(cur.lib_dirs().begin(), cur.lib_dirs().end());
+    link.all_libs_.Append(cur.libs().begin(), cur.libs().end());
+
+    link.all_framework_dirs_.Append(cur.framework_dirs().begin(),
+                                    cur.framework_dirs().end());
+    link.all_frameworks_.Append(cur.frameworks().begin(),
+                                cur.frameworks().end());
+    link.all_weak_frameworks_.Append(cur.weak_frameworks().begin(),
+                                     cur.weak_frameworks().end());
   }
 
   PullRecursiveBundleData();
@@ -767,19 +803,20 @@ void Target::PullDependentTargetLibsFrom(const Target* dep, bool is_public) {
       dep->output_type() == SOURCE_SET ||
       (dep->output_type() == CREATE_BUNDLE &&
        dep->bundle_data().is_framework())) {
-    inherited_libraries_.Append(dep, is_public);
+    linked_targets().inherited_libraries_.Append(dep, is_public);
   }
 
   if (dep->output_type() == STATIC_LIBRARY ||
       dep->output_type() == SHARED_LIBRARY ||
       dep->output_type() == RUST_LIBRARY) {
-    rust_transitive_libs_.Append(dep, is_public);
+    InheritedLibraries& rust_libs = linked_targets().rust_transitive_libs_;
+    rust_libs.Append(dep, is_public);
 
     // Propagate public dependent libraries.
     for (const auto& transitive :
-         dep->rust_transitive_libs_.GetOrderedAndPublicFlag()) {
+         dep->rust_transitive_libs().GetOrderedAndPublicFlag()) {
       if (transitive.second) {
-        rust_transitive_libs_.Append(transitive.first, is_public);
+        rust_libs.Append(transitive.first, is_public);
       }
     }
   }
@@ -788,22 +825,23 @@ void Target::PullDependentTargetLibsFrom(const Target* dep, bool is_public) {
   // handled the same way, whether static or dynamic.
   if (dep->output_type() == RUST_LIBRARY ||
       RustValues::InferredCrateType(dep) == RustValues::CRATE_DYLIB) {
-    rust_transitive_libs_.AppendInherited(dep->rust_transitive_libs_,
-                                          is_public);
+    LinkedTargets& link = linked_targets();
+    link.rust_transitive_libs_.AppendInherited(dep->rust_transitive_libs(),
+                                               is_public);
 
     // If there is a transitive dependency that is not a rust library, place it
     // in the normal location
     for (const auto& inherited :
-         rust_transitive_libs_.GetOrderedAndPublicFlag()) {
+         link.rust_transitive_libs_.GetOrderedAndPublicFlag()) {
       if (!RustValues::IsRustLibrary(inherited.first)) {
-        inherited_libraries_.Append(inherited.first, inherited.second);
+        link.inherited_libraries_.Append(inherited.first, inherited.second);
       }
     }
   } else if (dep->output_type() == RUST_PROC_MACRO) {
     // We will need to specify the path to find a procedural macro,
     // but have no need to specify the paths to find its dependencies
     // as the procedural macro is now a complete .so.
-    rust_transitive_libs_.Append(dep, is_public);
+    linked_targets().rust_transitive_libs_.Append(dep, is_public);
   } else if (dep->output_type() == SHARED_LIBRARY) {
     // Shared library dependendencies are inherited across public shared
     // library boundaries.
@@ -825,14 +863,18 @@ void Target::PullDependentTargetLibsFrom(const Target* dep, bool is_public) {
     // library boundaries because they will be linked into the shared
     // library. Rust dylib deps are handled above and transitive deps are
     // resolved by the compiler.
-    inherited_libraries_.AppendPublicSharedLibraries(dep->inherited_libraries(),
-                                                     is_public);
+    linked_targets().inherited_libraries_.AppendPublicSharedLibraries(
+        dep->inherited_libraries(), is_public);
   } else if (!dep->IsFinal()) {
     // The current target isn't linked, so propagate linked deps and
     // libraries up the dependency tree.
-    inherited_libraries_.AppendInherited(dep->inherited_libraries(), is_public);
-    rust_transitive_libs_.AppendInherited(dep->rust_transitive_libs_,
-                                          is_public);
+    if (dep->linked_targets_) {
+      LinkedTargets& link = linked_targets();
+      link.inherited_libraries_.AppendInherited(dep->inherited_libraries(),
+                                                is_public);
+      link.rust_transitive_libs_.AppendInherited(dep->rust_transitive_libs(),
+                                                 is_public);
+    }
   } else if (dep->complete_static_lib()) {
     // Inherit only final targets through _complete_ static libraries.
     //
@@ -843,20 +885,22 @@ void Target::PullDependentTargetLibsFrom(const Target* dep, bool is_public) {
     for (const auto& inherited :
          dep->inherited_libraries().GetOrderedAndPublicFlag()) {
       if (inherited.first->IsFinal()) {
-        inherited_libraries_.Append(inherited.first,
-                                    is_public && inherited.second);
+        linked_targets().inherited_libraries_.Append(
+            inherited.first, is_public && inherited.second);
       }
     }
   }
 
   // Library settings are always inherited across static library boundaries.
-  if (!dep->IsFinal() || dep->output_type() == STATIC_LIBRARY) {
-    all_lib_dirs_.Append(dep->all_lib_dirs());
-    all_libs_.Append(dep->all_libs());
-
-    all_framework_dirs_.Append(dep->all_framework_dirs());
-    all_frameworks_.Append(dep->all_frameworks());
-    all_weak_frameworks_.Append(dep->all_weak_frameworks());
+  if (dep->link_settings_ &&
+      (!dep->IsFinal() || dep->output_type() == STATIC_LIBRARY)) {
+    LinkSettings& link = link_settings();
+    link.all_lib_dirs_.Append(dep->all_lib_dirs());
+    link.all_libs_.Append(dep->all_libs());
+
+    link.all_framework_dirs_.Append(dep->all_framework_dirs());
+    link.all_frameworks_.Append(dep->all_frameworks());
+    link.all_weak_frameworks_.Append(dep->all_weak_frameworks());
   }
 }
 
@@ -868,10 +912,34 @@ void Target::PullDependentTargetLibs() {
 }
 
 void Target::PullRecursiveHardDeps() {
+  // In chains of targets, most add nothing to the hard deps of one of their
+  // dependencies. The set of that dependency is then shared rather than
+  // copied, and a new set is only made for the targets that add to it.
+  std::shared_ptr<const TargetSet> result;
+  TargetSet* owned = nullptr;
+  auto make_owned = [&result, &owned]() {
+    if (owned)
+      return;
+    auto set = result ? std::make_shared<TargetSet>(*result)
+                      : std::make_shared<TargetSet>();
+    owned = set.get();
+    result = std::move(set);
+  };
+  auto contains_all = [](const TargetSet& set, const TargetSet& items) {
+    for (const Target* item : items) {
+      if (!set.contains(item))
+        return false;
+    }
+    return true;
+  };
+
   for (const auto& pair : GetDeps(DEPS_LINKED)) {
     // Direct hard dependencies.
     if (hard_dep() || pair.ptr->hard_dep()) {
-      recursive_hard_deps_.insert(pair.ptr);
+      if (!result || !result->contains(pair.ptr)) {
+        make_owned();
+        owned->insert(pair.ptr);
+      }
       continue;
     }
 
@@ -887,9 +955,20 @@ void Target::PullRecursiveHardDeps() {
     }
 
     // Recursive hard dependencies of all dependencies.
-    recursive_hard_deps_.insert(pair.ptr->recursive_hard_deps().begin(),
-                                pair.ptr->recursive_hard_deps().end());
+    const std::shared_ptr<const TargetSet>& dep_set =
+        pair.ptr->recursive_hard_deps_;
+    if (!dep_set || dep_set == result)
+      continue;
+    if (owned) {
+      owned->insert(*dep_set);
+    } else if (!result || contains_all(*dep_set, *result)) {
+      result = dep_set;
+    } else if (!contains_all(*result, *dep_set)) {
+      make_owned();
+      owned->insert(*dep_set);
+    }
   }
+  recursive_hard_deps_ = std::move(result);
 }
 
 void Target::PullRecursiveBundleData() {
@@ -1158,24 +1237,72 @@ bool Target::CheckTestonly(Err* err) const {
   return true;
 }
 
+Target::AssertNoDepsMatch Target::MatchAssertNoDeps(
+    const LabelPatternSet* pattern_set) const {
+  for (const AssertNoDepsMatch& match : assert_no_deps_matches_) {
+    if (match.pattern_set == pattern_set)
+      return match;
+  }
+
+  AssertNoDepsMatch match;
+  match.pattern_set = pattern_set;
+  match.pattern = pattern_set->FirstMatch(label());
+  if (match.pattern < 0)
+    match = MatchAssertNoDepsOfDeps(pattern_set);
+
+  assert_no_deps_matches_.push_back(match);
+  return match;
+}
+
+Target::AssertNoDepsMatch Target::MatchAssertNoDepsOfDeps(
+    const LabelPatternSet* pattern_set) const {
+  AssertNoDepsMatch match;
+  match.pattern_set = pattern_set;
+  for (const auto& pair : GetDeps(DEPS_ALL)) {
+    // Executables are not considered, nor anything they depend on.
+    if (pair.ptr->output_type() == EXECUTABLE)
+      continue;
+    AssertNoDepsMatch dep_match = pair.ptr->MatchAssertNoDeps(pattern_set);
+    if (dep_match.pattern >= 0) {
+      match.pattern = dep_match.pattern;
+      match.next = pair.ptr;
+      break;
+    }
+  }
+  return match;
+}
+
 bool Target::CheckAssertNoDeps(Err* err) const {
-  if (assert_no_deps_.empty())
+  if (assert_no_deps().empty())
     return true;
 
-  TargetSet visited;
-  std::string failure_path_str;
-  const LabelPattern* failure_pattern = nullptr;
-
-  if (!RecursiveCheckAssertNoDeps(this, false, assert_no_deps_, &visited,
-                                  &failure_path_str, &failure_pattern)) {
-    *err = Err(
-        defined_from(), "assert_no_deps failed.",
-        label().GetUserVisibleName(false) +
-            " has an assert_no_deps entry:\n  " + failure_pattern->Describe() +
-            "\nwhich fails for the dependency path:\n" + failure_path_str);
-    return false;
+  // Dependencies are resolved before their dependents, so their summaries are
+  // computed at most once per pattern set and then reused by every target
+  // checking the same patterns.
+  const LabelPatternSet* pattern_set =
+      GetAssertNoDepsPatternSet(assert_no_deps());
+  AssertNoDepsMatch match = MatchAssertNoDepsOfDeps(pattern_set);
+  if (match.pattern < 0)
+    return true;
+
+  // Follow the memoized summaries to reconstruct the path to the target that
+  // matched.
+  static const char kIndentPath[] = "  ";
+  std::string failure_path_str =
+      kIndentPath + label().GetUserVisibleName(false);
+  for (const Target* cur = match.next; cur;
+       cur = cur->MatchAssertNoDeps(pattern_set).next) {
+    failure_path_str +=
+        " ->\n" + (kIndentPath + cur->label().GetUserVisibleName(false));
   }
-  return true;
+
+  *err = Err(defined_from(), "assert_no_deps failed.",
+             label().GetUserVisibleName(false) +
+                 " has an assert_no_deps entry:\n  " +
+                 assert_no_deps()[match.pattern].Describe() +
+                 "\nwhich fails for the dependency path:\n" +
+                 failure_path_str);
+  return false;
 }
 
 void Target::CheckSourcesGenerated() const {
@@ -1191,7 +1318,7 @@ void Target::CheckSourcesGenerated() const {
     for (const SourceFile& file : iter.cur().inputs())
       CheckSourceGenerated(file);
   }
-  // TODO(agrieve): Check all_libs_ here as well (those that are source files).
+  // TODO(agrieve): Check all_libs() here as well (those that are source files).
   // http://crbug.com/571731
 }
 
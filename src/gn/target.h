@@ -5,6 +5,7 @@
 #ifndef TOOLS_GN_TARGET_H_
 #define TOOLS_GN_TARGET_H_
 
+#include <memory>
 #include <optional>
 #include <set>
 #include <string>
@@ -31,6 +32,7 @@
 #include "gn/unique_vector.h"
 
 class DepsIteratorRange;
+class LabelPatternSet;
 class Settings;
 class Target;
 class Toolchain;
@@ -292,14 +294,14 @@ class Target : public Item {
 
   // Dependencies that can include files from this target.
   const std::set<Label>& allow_circular_includes_from() const {
-    return allow_circular_includes_from_;
+    return dep_rules().allow_circular_includes_from_;
   }
   std::set<Label>& allow_circular_includes_from() {
-    return allow_circular_includes_from_;
+    return dep_rules().allow_circular_includes_from_;
   }
 
   const InheritedLibraries& inherited_libraries() const {
-    return inherited_libraries_;
+    return linked_targets().inherited_libraries_;
   }
 
   // This config represents the configuration set directly on this target.
@@ -320,54 +322,76 @@ class Target : public Item {
   bool has_rust_values() const { return rust_values_.get(); }
 
   // Transitive closure of libraries that are depended on by this target
-  InheritedLibraries& rust_transitive_libs() { return rust_transitive_libs_; }
+  InheritedLibraries& rust_transitive_libs() {
+    return linked_targets().rust_transitive_libs_;
+  }
   const InheritedLibraries& rust_transitive_libs() const {
-    return rust_transitive_libs_;
+    return linked_targets().rust_transitive_libs_;
   }
 
-  const UniqueVector<SourceDir>& all_lib_dirs() const { return all_lib_dirs_; }
-  const UniqueVector<LibFile>& all_libs() const { return all_libs_; }
+  const UniqueVector<SourceDir>& all_lib_dirs() const {
+    return link_settings().all_lib_dirs_;
+  }
+  const UniqueVector<LibFile>& all_libs() const {
+    return link_settings().all_libs_;
+  }
 
   const UniqueVector<SourceDir>& all_framework_dirs() const {
-    return all_framework_dirs_;
+    return link_settings().all_framework_dirs_;
   }
   const UniqueVector<std::string>& all_frameworks() const {
-    return all_frameworks_;
+    return link_settings().all_frameworks_;
   }
   const UniqueVector<std::string>& all_weak_frameworks() const {
-    return all_weak_frameworks_;
+    return link_settings().all_weak_frameworks_;
   }
 
-  const TargetSet& recursive_hard_deps() const { return recursive_hard_deps_; }
+  const TargetSet& recursive_hard_deps() const;
 
-  std::vector<LabelPattern>& friends() { return friends_; }
-  const std::vector<LabelPattern>& friends() const { return friends_; }
+  std::vector<LabelPattern>& friends() { return dep_rules().friends_; }
+  const std::vector<LabelPattern>& friends() const {
+    return dep_rules().friends_;
+  }
 
-  std::vector<LabelPattern>& assert_no_deps() { return assert_no_deps_; }
+  std::vector<LabelPattern>& assert_no_deps() {
+    return dep_rules().assert_no_deps_;
+  }
   const std::vector<LabelPattern>& assert_no_deps() const {
-    return assert_no_deps_;
+    return dep_rules().assert_no_deps_;
   }
 
   // Set to true if jumbo compilation is allowed for this target.
-  bool is_jumbo_allowed() const { return jumbo_allowed_.value_or(false); }
-  void set_jumbo_allowed(bool jumbo_allowed) { jumbo_allowed_ = jumbo_allowed; }
-  bool is_jumbo_configured() const { return jumbo_allowed_.has_value(); }
+  bool is_jumbo_allowed() const {
+    return jumbo_values().jumbo_allowed_.value_or(false);
+  }
+  void set_jumbo_allowed(bool jumbo_allowed) {
+    jumbo_values().jumbo_allowed_ = jumbo_allowed;
+  }
+  bool is_jumbo_configured() const {
+    return jumbo_values().jumbo_allowed_.has_value();
+  }
 
   // List of source files not merged in jumbo mode.
   const FileList& jumbo_excluded_sources() const {
-    return jumbo_excluded_sources_;
+    return jumbo_values().jumbo_excluded_sources_;
+  }
+  FileList& jumbo_excluded_sources() {
+    return jumbo_values().jumbo_excluded_sources_;
   }
-  FileList& jumbo_excluded_sources() { return jumbo_excluded_sources_; }
 
   // Maximum number of source files to group in jumbo mode.
-  int jumbo_file_merge_limit() const { return jumbo_file_merge_limit_; }
+  int jumbo_file_merge_limit() const {
+    return jumbo_values().jumbo_file_merge_limit_;
+  }
   void set_jumbo_file_merge_limit(int limit) {
-    jumbo_file_merge_limit_ = limit;
+    jumbo_values().jumbo_file_merge_limit_ = limit;
   }
 
   // List of jumbo source files with original merged source files.
-  const JumboFileList& jumbo_files() const { return jumbo_files_; }
-  JumboFileList& jumbo_files() { return jumbo_files_; }
+  const JumboFileList& jumbo_files() const {
+    return jumbo_values().jumbo_files_;
+  }
+  JumboFileList& jumbo_files() { return jumbo_values().jumbo_files_; }
 
   // The toolchain is only known once this target is resolved (all if its
   // dependencies are known). They will be null until then. Generally, this can
@@ -458,6 +482,7 @@ class Target : public Item {
 
  private:
   FRIEND_TEST_ALL_PREFIXES(TargetTest, ResolvePrecompiledHeaders);
+  FRIEND_TEST_ALL_PREFIXES(TargetTest, InheritLibsThroughGroups);
 
   // Pulls necessary information from dependencies to this one when all
   // dependencies have been resolved.
@@ -467,6 +492,27 @@ class Target : public Item {
   void PullRecursiveHardDeps();
   void PullRecursiveBundleData();
 
+  // Summary of matching a target and its transitive dependencies against a
+  // list of assert_no_deps patterns. See CheckAssertNoDeps().
+  struct AssertNoDepsMatch {
+    // The interned patterns, see GetAssertNoDepsPatternSet().
+    const LabelPatternSet* pattern_set = nullptr;
+
+    // Index of the first matching pattern, or -1 if nothing matches.
+    int pattern = -1;
+
+    // The dependency leading to the matching target, or null if this target
+    // is the one that matches.
+    const Target* next = nullptr;
+  };
+
+  // Returns the summary for this target and its dependencies, computing and
+  // memoizing it if needed. MatchAssertNoDepsOfDeps() only considers the
+  // dependencies, since assert_no_deps doesn't apply to the target itself.
+  AssertNoDepsMatch MatchAssertNoDeps(const LabelPatternSet* pattern_set) const;
+  AssertNoDepsMatch MatchAssertNoDepsOfDeps(
+      const LabelPatternSet* pattern_set) const;
+
   // Fills the link and dependency output files when a target is resolved.
   bool FillOutputFiles(Err* err);
 
@@ -483,56 +529,109 @@ class Target : public Item {
   void CheckSourceGenerated(const SourceFile& source) const;
   bool CheckSourceSetLanguages(Err* err) const;
 
+  // The members below are split between a core used by most targets, and
+  // blocks for the data only some targets have, allocated the first time they
+  // are written to. Until then, the const accessors return empty blocks.
+
+  // Libraries inherited from the dependencies. Nothing is inherited by the
+  // targets at the bottom of the graph, nor through actions and copies.
+  struct LinkedTargets {
+    // Static libraries, shared libraries, and source sets from transitive
+    // deps that need to be linked.
+    InheritedLibraries inherited_libraries_;
+
+    // Used by all targets, only useful to generate Rust targets though.
+    InheritedLibraries rust_transitive_libs_;
+  };
+  static const LinkedTargets kEmptyLinkedTargets;
+  const LinkedTargets& linked_targets() const;
+  LinkedTargets& linked_targets();
+
+  // Only allocated when there are libs or frameworks to link.
+  struct LinkSettings {
+    // These libs and dirs are inherited from statically linked deps and all
+    // configs applying to this target.
+    UniqueVector<SourceDir> all_lib_dirs_;
+    UniqueVector<LibFile> all_libs_;
+
+    // These frameworks and dirs are inherited from statically linked deps and
+    // all configs applying to this target.
+    UniqueVector<SourceDir> all_framework_dirs_;
+    UniqueVector<std::string> all_frameworks_;
+    UniqueVector<std::string> all_weak_frameworks_;
+  };
+  static const LinkSettings kEmptyLinkSettings;
+  const LinkSettings& link_settings() const;
+  LinkSettings& link_settings();
+
+  // The friend, assert_no_deps and allow_circular_includes_from values.
+  struct DepRules {
+    std::vector<LabelPattern> friends_;
+    std::vector<LabelPattern> assert_no_deps_;
+    std::set<Label> allow_circular_includes_from_;
+  };
+  static const DepRules kEmptyDepRules;
+  const DepRules& dep_rules() const;
+  DepRules& dep_rules();
+
+  // Jumbo mode configuration.
+  struct JumboValues {
+    std::optional<bool> jumbo_allowed_;
+    FileList jumbo_excluded_sources_;
+    int jumbo_file_merge_limit_;
+    JumboFileList jumbo_files_;
+  };
+  static const JumboValues kEmptyJumboValues;
+  const JumboValues& jumbo_values() const;
+  JumboValues& jumbo_values();
+
+  // The core, starting with what the graph walks and the writers use.
   OutputType output_type_ = UNKNOWN;
-  std::string output_name_;
-  bool output_prefix_override_ = false;
-  SourceDir output_dir_;
-  std::string output_extension_;
-  bool output_extension_set_ = false;
 
-  FileList sources_;
-  SourceFileTypeSet source_types_used_;
-  bool all_headers_public_ = true;
-  FileList public_headers_;
-  bool check_includes_ = true;
-  bool complete_static_lib_ = false;
-  std::vector<std::string> data_;
-  std::unique_ptr<BundleData> bundle_data_;
-  OutputFile write_runtime_deps_output_;
+  // Toolchain used by this target. Null until target is resolved.
+  const Toolchain* toolchain_ = nullptr;
 
   LabelTargetVector private_deps_;
   LabelTargetVector public_deps_;
   LabelTargetVector data_deps_;
   LabelTargetVector gen_deps_;
 
+  // All hard deps from this target and all dependencies. Filled in when this
+  // target is marked resolved. This will not include the current target.
+  // Targets that don't add to the set of a dependency share it, and null
+  // means empty.
+  std::shared_ptr<const TargetSet> recursive_hard_deps_;
+
+  // Output files. Empty until the target is resolved.
+  std::vector<OutputFile> computed_outputs_;
+  OutputFile link_output_file_;
+  OutputFile dependency_output_file_;
+  std::vector<OutputFile> runtime_outputs_;
+
+  FileList sources_;
+  SourceFileTypeSet source_types_used_;
+  bool all_headers_public_ = true;
+  bool check_includes_ = true;
+  bool complete_static_lib_ = false;
+  bool output_prefix_override_ = false;
+  bool output_extension_set_ = false;
+  FileList public_headers_;
+
   // See getters for more info.
   UniqueVector<LabelConfigPair> configs_;
   UniqueVector<LabelConfigPair> all_dependent_configs_;
   UniqueVector<LabelConfigPair> public_configs_;
 
-  std::set<Label> allow_circular_includes_from_;
-
-  // Static libraries, shared libraries, and source sets from transitive deps
-  // that need to be linked.
-  InheritedLibraries inherited_libraries_;
-
-  // These libs and dirs are inherited from statically linked deps and all
-  // configs applying to this target.
-  UniqueVector<SourceDir> all_lib_dirs_;
-  UniqueVector<LibFile> all_libs_;
-
-  // These frameworks and dirs are inherited from statically linked deps and
-  // all configs applying to this target.
-  UniqueVector<SourceDir> all_framework_dirs_;
-  UniqueVector<std::string> all_frameworks_;
-  UniqueVector<std::string> all_weak_frameworks_;
-
-  // All hard deps from this target and all dependencies. Filled in when this
-  // target is marked resolved. This will not include the current target.
-  TargetSet recursive_hard_deps_;
+  std::string output_name_;
+  SourceDir output_dir_;
+  std::string output_extension_;
+  std::vector<std::string> data_;
+  OutputFile write_runtime_deps_output_;
 
-  std::vector<LabelPattern> friends_;
-  std::vector<LabelPattern> assert_no_deps_;
+  // Memoized MatchAssertNoDeps() results for each pattern set checked by a
+  // dependent of this target. Only used during resolution, which happens on
+  // the main thread.
+  mutable std::vector<AssertNoDepsMatch> assert_no_deps_matches_;
 
   // Used for all binary targets, and for inputs in regular targets. The
   // precompiled header values in this struct will be resolved to the ones to
@@ -545,26 +644,14 @@ class Target : public Item {
   // Used for Rust targets.
   std::unique_ptr<RustValues> rust_values_;
 
-  // Used by all targets, only useful to generate Rust targets though.
-  InheritedLibraries rust_transitive_libs_;
-
   // User for Swift targets.
   std::unique_ptr<SwiftValues> swift_values_;
 
-  // Toolchain used by this target. Null until target is resolved.
-  const Toolchain* toolchain_ = nullptr;
-
-  // Jumbo mode configuration.
-  std::optional<bool> jumbo_allowed_;
-  FileList jumbo_excluded_sources_;
-  int jumbo_file_merge_limit_;
-  JumboFileList jumbo_files_;
-
-  // Output files. Empty until the target is resolved.
-  std::vector<OutputFile> computed_outputs_;
-  OutputFile link_output_file_;
-  OutputFile dependency_output_file_;
-  std::vector<OutputFile> runtime_outputs_;
+  std::unique_ptr<BundleData> bundle_data_;
+  std::unique_ptr<LinkedTargets> linked_targets_;
+  std::unique_ptr<LinkSettings> link_settings_;
+  std::unique_ptr<DepRules> dep_rules_;
+  std::unique_ptr<JumboValues> jumbo_values_;
 
   std::unique_ptr<Metadata> metadata_;
 
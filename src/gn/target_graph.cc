@@ -0,0 +1,56 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/target_graph.h"
+
+#include "gn/target.h"
+
+TargetGraph::TargetGraph(const std::vector<const Target*>& targets)
+    : targets_(targets) {
+  ids_.reserve(targets_.size());
+  for (size_t i = 0; i < targets_.size(); i++)
+    ids_.emplace(targets_[i], static_cast<Id>(i));
+
+  forward_offsets_.reserve(targets_.size() + 1);
+  forward_offsets_.push_back(0);
+  std::vector<uint32_t> reverse_counts(targets_.size(), 0);
+  auto add_deps = [this, &reverse_counts](const LabelTargetVector& deps,
+                                          EdgeKind kind) {
+    for (const auto& pair : deps) {
+      Id id = GetId(pair.ptr);
+      if (id == kInvalidId)
+        continue;
+      forward_edges_.push_back({id, kind});
+      reverse_counts[id]++;
+    }
+  };
+  for (const Target* target : targets_) {
+    add_deps(target->public_deps(), EdgeKind::kPublic);
+    add_deps(target->private_deps(), EdgeKind::kPrivate);
+    add_deps(target->data_deps(), EdgeKind::kData);
+    add_deps(target->gen_deps(), EdgeKind::kGen);
+    forward_offsets_.push_back(static_cast<uint32_t>(forward_edges_.size()));
+  }
+
+  // Counting sort of the forward edges by their dependency. Visiting the
+  // dependent targets in order keeps each row sorted by ID.
+  reverse_offsets_.resize(targets_.size() + 1);
+  reverse_offsets_[0] = 0;
+  for (size_t i = 0; i < targets_.size(); i++)
+    reverse_offsets_[i + 1] = reverse_offsets_[i] + reverse_counts[i];
+  reverse_edges_.resize(forward_edges_.size());
+  std::vector<uint32_t> next(reverse_offsets_.begin(),
+                             reverse_offsets_.end() - 1);
+  for (Id from = 0; from < targets_.size(); from++) {
+    for (const Edge& edge : deps(from))
+      reverse_edges_[next[edge.id]++] = {from, edge.kind};
+  }
+}
+
+TargetGraph::~TargetGraph() = default;
+
+TargetGraph::Id TargetGraph::GetId(const Target* target) const {
+  auto found = ids_.find(target);
+  return found == ids_.end() ? kInvalidId : found->second;
+}
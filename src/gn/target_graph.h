@@ -0,0 +1,90 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TOOLS_GN_TARGET_GRAPH_H_
+#define TOOLS_GN_TARGET_GRAPH_H_
+
+#include <stdint.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include "base/containers/span.h"
+
+class Target;
+
+// An immutable snapshot of the dependencies between a set of resolved
+// targets, for the commands that walk the whole graph (refs, path).
+//
+// Each target gets a dense ID, its index in the vector the graph was built
+// from, so that walks can keep their state in vectors indexed by ID rather
+// than in sets and maps of pointers. The dependencies and the reverse
+// dependencies of all targets are each stored in one array, with an offset
+// per target (compressed sparse rows).
+class TargetGraph {
+ public:
+  using Id = uint32_t;
+
+  static constexpr Id kInvalidId = static_cast<Id>(-1);
+
+  // Which list of the dependent target names the dependency.
+  enum class EdgeKind : uint8_t {
+    kPublic,
+    kPrivate,
+    kData,
+    kGen,
+  };
+
+  struct Edge {
+    // The other end of the edge: the dependency for forward edges, and the
+    // dependent target for reverse ones.
+    Id id;
+    EdgeKind kind;
+  };
+
+  // Dependencies on targets missing from |targets| are ignored.
+  explicit TargetGraph(const std::vector<const Target*>& targets);
+  ~TargetGraph();
+
+  size_t size() const { return targets_.size(); }
+
+  const Target* target(Id id) const { return targets_[id]; }
+
+  // Returns kInvalidId if the target isn't part of the graph.
+  Id GetId(const Target* target) const;
+
+  // Returns the dependencies of a target, in the order public, private, data
+  // and gen, each in the order of the target's list.
+  base::span<const Edge> deps(Id id) const {
+    return Row(forward_offsets_, forward_edges_, id);
+  }
+
+  // Returns the targets depending on a target. They are ordered by ID and,
+  // for a given dependent target, in the same order as deps().
+  base::span<const Edge> reverse_deps(Id id) const {
+    return Row(reverse_offsets_, reverse_edges_, id);
+  }
+
+ private:
+  static base::span<const Edge> Row(const std::vector<uint32_t>& offsets,
+                                    const std::vector<Edge>& edges,
+                                    Id id) {
+    return base::span<const Edge>(edges.data() + offsets[id],
+                                  offsets[id + 1] - offsets[id]);
+  }
+
+  std::vector<const Target*> targets_;
+  std::unordered_map<const Target*, Id> ids_;
+
+  // The edges of target i are at [offsets[i], offsets[i + 1]).
+  std::vector<uint32_t> forward_offsets_;
+  std::vector<Edge> forward_edges_;
+  std::vector<uint32_t> reverse_offsets_;
+  std::vector<Edge> reverse_edges_;
+
+  TargetGraph(const TargetGraph&) = delete;
+  TargetGraph& operator=(const TargetGraph&) = delete;
+};
+
+#endif  // TOOLS_GN_TARGET_GRAPH_H_
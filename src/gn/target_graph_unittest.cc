@@ -0,0 +1,75 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/target_graph.h"
+
+#include "gn/test_with_scope.h"
+#include "util/test/test.h"
+
+namespace {
+
+using EdgeKind = TargetGraph::EdgeKind;
+
+std::string Describe(const TargetGraph& graph,
+                     base::span<const TargetGraph::Edge> edges) {
+  std::string result;
+  for (const TargetGraph::Edge& edge : edges) {
+    if (!result.empty())
+      result.push_back(' ');
+    result += graph.target(edge.id)->label().name();
+    switch (edge.kind) {
+      case EdgeKind::kPublic:
+        result += "(public)";
+        break;
+      case EdgeKind::kPrivate:
+        result += "(private)";
+        break;
+      case EdgeKind::kData:
+        result += "(data)";
+        break;
+      case EdgeKind::kGen:
+        result += "(gen)";
+        break;
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(TargetGraph, Edges) {
+  TestWithScope setup;
+  TestTarget a(setup, "//foo:a", Target::EXECUTABLE);
+  TestTarget b(setup, "//foo:b", Target::SOURCE_SET);
+  TestTarget c(setup, "//foo:c", Target::SOURCE_SET);
+  TestTarget d(setup, "//foo:d", Target::ACTION);
+  TestTarget outside(setup, "//foo:outside", Target::SOURCE_SET);
+
+  a.private_deps().push_back(LabelTargetPair(&c));
+  a.public_deps().push_back(LabelTargetPair(&b));
+  a.data_deps().push_back(LabelTargetPair(&d));
+  a.gen_deps().push_back(LabelTargetPair(&outside));
+  b.public_deps().push_back(LabelTargetPair(&c));
+  c.private_deps().push_back(LabelTargetPair(&d));
+  c.data_deps().push_back(LabelTargetPair(&d));
+
+  TargetGraph graph({&a, &b, &c, &d});
+  ASSERT_EQ(4u, graph.size());
+  EXPECT_EQ(0u, graph.GetId(&a));
+  EXPECT_EQ(3u, graph.GetId(&d));
+  EXPECT_EQ(&c, graph.target(2));
+  EXPECT_EQ(TargetGraph::kInvalidId, graph.GetId(&outside));
+
+  // Deps on targets outside of the graph are dropped.
+  EXPECT_EQ("b(public) c(private) d(data)", Describe(graph, graph.deps(0)));
+  EXPECT_EQ("c(public)", Describe(graph, graph.deps(1)));
+  EXPECT_EQ("d(private) d(data)", Describe(graph, graph.deps(2)));
+  EXPECT_EQ("", Describe(graph, graph.deps(3)));
+
+  EXPECT_EQ("", Describe(graph, graph.reverse_deps(0)));
+  EXPECT_EQ("a(public)", Describe(graph, graph.reverse_deps(1)));
+  EXPECT_EQ("a(private) b(public)", Describe(graph, graph.reverse_deps(2)));
+  EXPECT_EQ("a(data) c(private) c(data)",
+            Describe(graph, graph.reverse_deps(3)));
+}
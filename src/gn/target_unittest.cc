@@ -457,6 +457,112 @@ TEST_F(TargetTest, NoActionDepPropgation) {
   }
 }
 
+// Libraries are inherited through groups, while the link, jumbo and
+// dependency rule values are only allocated by the targets that have some.
+TEST_F(TargetTest, InheritLibsThroughGroups) {
+  TestWithScope setup;
+  Err err;
+
+  const LibFile lib("foo");
+
+  // Create a dependency chain:
+  //   A (exe) -> B (group) -> C (group) -> D (source_set with a lib)
+  //   A (exe) -> E (group)
+  TestTarget a(setup, "//foo:a", Target::EXECUTABLE);
+  TestTarget b(setup, "//foo:b", Target::GROUP);
+  TestTarget c(setup, "//foo:c", Target::GROUP);
+  TestTarget d(setup, "//foo:d", Target::SOURCE_SET);
+  TestTarget e(setup, "//foo:e", Target::GROUP);
+  d.config_values().libs().push_back(lib);
+  a.private_deps().push_back(LabelTargetPair(&b));
+  a.private_deps().push_back(LabelTargetPair(&e));
+  b.private_deps().push_back(LabelTargetPair(&c));
+  c.private_deps().push_back(LabelTargetPair(&d));
+
+  ASSERT_TRUE(d.OnResolved(&err));
+  ASSERT_TRUE(c.OnResolved(&err));
+  ASSERT_TRUE(b.OnResolved(&err));
+  ASSERT_TRUE(e.OnResolved(&err));
+  ASSERT_TRUE(a.OnResolved(&err));
+
+  // E has no dependencies and no values of its own. D only has libs.
+  EXPECT_FALSE(e.linked_targets_);
+  EXPECT_FALSE(e.link_settings_);
+  EXPECT_FALSE(e.dep_rules_);
+  EXPECT_FALSE(e.jumbo_values_);
+  EXPECT_FALSE(d.linked_targets_);
+  EXPECT_TRUE(d.link_settings_);
+  EXPECT_TRUE(a.linked_targets_);
+  EXPECT_TRUE(a.link_settings_);
+  EXPECT_FALSE(a.dep_rules_);
+  EXPECT_FALSE(a.jumbo_values_);
+
+  EXPECT_TRUE(e.inherited_libraries().GetOrdered().empty());
+  EXPECT_TRUE(e.all_libs().empty());
+
+  std::vector<const Target*> libs = a.inherited_libraries().GetOrdered();
+  ASSERT_EQ(1u, libs.size());
+  EXPECT_EQ(&d, libs[0]);
+  ASSERT_EQ(1u, a.all_libs().size());
+  EXPECT_EQ(lib, a.all_libs()[0]);
+
+  // Defaults of the values that weren't set.
+  EXPECT_FALSE(a.is_jumbo_configured());
+  EXPECT_FALSE(a.is_jumbo_allowed());
+  EXPECT_EQ(50, a.jumbo_file_merge_limit());
+  EXPECT_TRUE(a.friends().empty());
+  EXPECT_TRUE(a.assert_no_deps().empty());
+  EXPECT_TRUE(a.allow_circular_includes_from().empty());
+
+  a.set_jumbo_allowed(true);
+  EXPECT_TRUE(a.is_jumbo_configured());
+  EXPECT_EQ(50, a.jumbo_file_merge_limit());
+}
+
+TEST_F(TargetTest, RecursiveHardDeps) {
+  TestWithScope setup;
+  Err err;
+
+  // Create a dependency graph:
+  //   A (source_set) -> B (group) -> C (source_set) -> D (action)
+  //   A (source_set) -> E (action)
+  //   A (source_set) -> F (group) -> C (source_set)
+  TestTarget a(setup, "//foo:a", Target::SOURCE_SET);
+  TestTarget b(setup, "//foo:b", Target::GROUP);
+  TestTarget c(setup, "//foo:c", Target::SOURCE_SET);
+  TestTarget d(setup, "//foo:d", Target::ACTION);
+  TestTarget e(setup, "//foo:e", Target::ACTION);
+  TestTarget f(setup, "//foo:f", Target::GROUP);
+  a.private_deps().push_back(LabelTargetPair(&b));
+  a.private_deps().push_back(LabelTargetPair(&e));
+  a.private_deps().push_back(LabelTargetPair(&f));
+  b.private_deps().push_back(LabelTargetPair(&c));
+  c.private_deps().push_back(LabelTargetPair(&d));
+  f.private_deps().push_back(LabelTargetPair(&c));
+
+  ASSERT_TRUE(d.OnResolved(&err));
+  ASSERT_TRUE(e.OnResolved(&err));
+  ASSERT_TRUE(c.OnResolved(&err));
+  ASSERT_TRUE(b.OnResolved(&err));
+  ASSERT_TRUE(f.OnResolved(&err));
+  ASSERT_TRUE(a.OnResolved(&err));
+
+  EXPECT_TRUE(d.recursive_hard_deps().empty());
+
+  ASSERT_EQ(1u, c.recursive_hard_deps().size());
+  EXPECT_TRUE(c.recursive_hard_deps().contains(&d));
+
+  // B and F add nothing to the hard deps of C, so they share its set.
+  EXPECT_EQ(&c.recursive_hard_deps(), &b.recursive_hard_deps());
+  EXPECT_EQ(&c.recursive_hard_deps(), &f.recursive_hard_deps());
+
+  // A adds E, which must not change the set of C.
+  EXPECT_EQ(2u, a.recursive_hard_deps().size());
+  EXPECT_TRUE(a.recursive_hard_deps().contains(&d));
+  EXPECT_TRUE(a.recursive_hard_deps().contains(&e));
+  EXPECT_EQ(1u, c.recursive_hard_deps().size());
+}
+
 TEST_F(TargetTest, GetComputedOutputName) {
   TestWithScope setup;
   Err err;
@@ -1327,6 +1433,63 @@ TEST_F(TargetTest, AssertNoDeps) {
   ASSERT_TRUE(a2.OnResolved(&err));
 }
 
+// Targets with the same assert_no_deps share the results of checking their
+// common dependencies, which must still produce the right paths.
+TEST_F(TargetTest, AssertNoDepsSharedPatterns) {
+  TestWithScope setup;
+  Err err;
+
+  LabelPattern disallow_bad(LabelPattern::RECURSIVE_DIRECTORY,
+                            SourceDir("//bad/"), std::string(), Label());
+
+  // Diamond: top -> {ok, mid} -> bad, with ok not depending on anything bad.
+  TestTarget bad(setup, "//bad", Target::STATIC_LIBRARY);
+  ASSERT_TRUE(bad.OnResolved(&err));
+  TestTarget ok(setup, "//ok", Target::STATIC_LIBRARY);
+  ASSERT_TRUE(ok.OnResolved(&err));
+  TestTarget mid(setup, "//mid", Target::STATIC_LIBRARY);
+  mid.private_deps().push_back(LabelTargetPair(&bad));
+  ASSERT_TRUE(mid.OnResolved(&err));
+
+  TestTarget top1(setup, "//top1", Target::EXECUTABLE);
+  top1.private_deps().push_back(LabelTargetPair(&ok));
+  top1.private_deps().push_back(LabelTargetPair(&mid));
+  top1.assert_no_deps().push_back(disallow_bad);
+  ASSERT_FALSE(top1.OnResolved(&err));
+  EXPECT_EQ(
+      "//top1:top1 has an assert_no_deps entry:\n"
+      "  //bad/*\n"
+      "which fails for the dependency path:\n"
+      "  //top1:top1 ->\n"
+      "  //mid:mid ->\n"
+      "  //bad:bad",
+      err.help_text());
+  err = Err();
+
+  // A second target with the same patterns reuses the results for |mid|.
+  TestTarget top2(setup, "//top2", Target::EXECUTABLE);
+  top2.private_deps().push_back(LabelTargetPair(&mid));
+  top2.assert_no_deps().push_back(disallow_bad);
+  ASSERT_FALSE(top2.OnResolved(&err));
+  EXPECT_EQ(
+      "//top2:top2 has an assert_no_deps entry:\n"
+      "  //bad/*\n"
+      "which fails for the dependency path:\n"
+      "  //top2:top2 ->\n"
+      "  //mid:mid ->\n"
+      "  //bad:bad",
+      err.help_text());
+  err = Err();
+
+  // Different patterns are checked independently.
+  TestTarget top3(setup, "//top3", Target::EXECUTABLE);
+  top3.private_deps().push_back(LabelTargetPair(&mid));
+  top3.assert_no_deps().push_back(
+      LabelPattern(LabelPattern::RECURSIVE_DIRECTORY, SourceDir("//other/"),
+                   std::string(), Label()));
+  EXPECT_TRUE(top3.OnResolved(&err));
+}
+
 TEST_F(TargetTest, PullRecursiveBundleData) {
   TestWithScope setup;
   Err err;
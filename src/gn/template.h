@@ -46,6 +46,9 @@ class Template : public base::RefCountedThreadSafe<Template> {
   // Returns the location range where this template was defined.
   LocationRange GetDefinitionRange() const;
 
+  const Scope* closure() const { return closure_.get(); }
+  const FunctionCallNode* definition() const { return definition_; }
+
  private:
   friend class base::RefCountedThreadSafe<Template>;
 
@@ -4,12 +4,70 @@
 
 #include "gn/tokenizer.h"
 
+#include <string.h>
+
 #include "base/logging.h"
 #include "base/strings/string_util.h"
 #include "gn/input_file.h"
+#include "util/sse2.h"
 
 namespace {
 
+// Returns the offset of the first occurrence of |a| or |b| in |input| at or
+// after |begin|, or input.size() if there is none.
+size_t FindEither(std::string_view input, size_t begin, char a, char b) {
+  const char* data = input.data();
+  size_t i = begin;
+#if defined(HAS_SSE2)
+  for (; i + 16 <= input.size(); i += 16) {
+    __m128i chunk = Load16(&data[i]);
+    unsigned mask = _mm_movemask_epi8(
+        _mm_or_si128(BytesEqual(chunk, a), BytesEqual(chunk, b)));
+    if (mask)
+      return i + LowestSetBit(mask);
+  }
+#endif
+  for (; i < input.size(); i++) {
+    if (data[i] == a || data[i] == b)
+      return i;
+  }
+  return input.size();
+}
+
+// Returns the offset of the first newline in |input| at or after |begin|, or
+// input.size() if there is none.
+size_t FindNewline(std::string_view input, size_t begin) {
+  const void* found =
+      memchr(input.data() + begin, '\n', input.size() - begin);
+  if (!found)
+    return input.size();
+  return static_cast<const char*>(found) - input.data();
+}
+
+// Returns the offset of the first character of |input| at or after |begin|
+// that isn't a space, \n or \r, or input.size() if there is none.
+size_t FindNonWhitespace(std::string_view input, size_t begin) {
+  const char* data = input.data();
+  size_t i = begin;
+#if defined(HAS_SSE2)
+  for (; i + 16 <= input.size(); i += 16) {
+    __m128i chunk = Load16(&data[i]);
+    __m128i whitespace = _mm_or_si128(
+        _mm_or_si128(BytesEqual(chunk, ' '), BytesEqual(chunk, '\n')),
+        BytesEqual(chunk, '\r'));
+    unsigned mask = _mm_movemask_epi8(whitespace) ^ 0xFFFF;
+    if (mask)
+      return i + LowestSetBit(mask);
+  }
+#endif
+  for (; i < input.size(); i++) {
+    char c = data[i];
+    if (c != ' ' && c != '\n' && c != '\r')
+      return i;
+  }
+  return input.size();
+}
+
 bool CouldBeTwoCharOperatorBegin(char c) {
   return c == '<' || c == '>' || c == '!' || c == '=' || c == '-' || c == '+' ||
          c == '|' || c == '&';
@@ -194,6 +252,10 @@ bool Tokenizer::IsIdentifierContinuingChar(char c) {
 }
 
 void Tokenizer::AdvanceToNextToken() {
+  if (whitespace_transform_ == WhitespaceTransform::kMaintainOriginalInput) {
+    AdvanceTo(FindNonWhitespace(input_, cur_));
+    return;
+  }
   while (!at_end() && IsCurrentWhitespace())
     Advance();
 }
@@ -278,6 +340,9 @@ void Tokenizer::AdvanceToEndOfToken(const Location& location,
       char initial = cur_char();
       Advance();  // Advance past initial "
       for (;;) {
+        // Skip the characters that can't end the string or make it invalid
+        // in bulk. Escaped quotes are handled below.
+        AdvanceWithinLine(FindEither(input_, cur_, initial, '\n'));
         if (at_end()) {
           *err_ = Err(LocationRange(location, GetCurrentLocation()),
                       "Unterminated string literal.",
@@ -305,10 +370,13 @@ void Tokenizer::AdvanceToEndOfToken(const Location& location,
       Advance();
       break;
 
-    case Token::IDENTIFIER:
-      while (!at_end() && IsIdentifierContinuingChar(cur_char()))
-        Advance();
+    case Token::IDENTIFIER: {
+      size_t end = cur_;
+      while (end < input_.size() && IsIdentifierContinuingChar(input_[end]))
+        end++;
+      AdvanceWithinLine(end);
       break;
+    }
 
     case Token::LEFT_BRACKET:
     case Token::RIGHT_BRACKET:
@@ -323,8 +391,7 @@ void Tokenizer::AdvanceToEndOfToken(const Location& location,
 
     case Token::UNCLASSIFIED_COMMENT:
       // Eat to EOL.
-      while (!at_end() && !IsCurrentNewline())
-        Advance();
+      AdvanceWithinLine(FindNewline(input_, cur_));
       break;
 
     case Token::INVALID:
@@ -388,6 +455,27 @@ void Tokenizer::Advance() {
   cur_++;
 }
 
+void Tokenizer::AdvanceWithinLine(size_t end) {
+  DCHECK(end <= input_.size());
+  DCHECK(FindNewline(input_, cur_) >= end);
+  column_number_ += static_cast<int>(end - cur_);
+  cur_ = end;
+}
+
+void Tokenizer::AdvanceTo(size_t end) {
+  DCHECK(end <= input_.size());
+  size_t line_begin = cur_;
+  for (size_t i = cur_; i < end; i++) {
+    if (IsNewline(input_, i)) {
+      line_number_++;
+      column_number_ = 1;
+      line_begin = i + 1;
+    }
+  }
+  column_number_ += static_cast<int>(end - line_begin);
+  cur_ = end;
+}
+
 Location Tokenizer::GetCurrentLocation() const {
   return Location(input_file_, line_number_, column_number_);
 }
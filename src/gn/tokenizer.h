@@ -78,6 +78,11 @@ class Tokenizer {
   // Increments the current location by one.
   void Advance();
 
+  // Moves the current location to the byte offset |end|. AdvanceWithinLine()
+  // requires that there be no newline before |end|.
+  void AdvanceWithinLine(size_t end);
+  void AdvanceTo(size_t end);
+
   // Returns the current character in the file as a location.
   Location GetCurrentLocation() const;
 
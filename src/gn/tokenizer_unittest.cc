@@ -4,6 +4,8 @@
 
 #include <stddef.h>
 
+#include <string>
+
 #include "gn/input_file.h"
 #include "gn/token.h"
 #include "gn/tokenizer.h"
@@ -133,6 +135,47 @@ TEST(Tokenizer, Locations) {
   ASSERT_TRUE(results[3].location() == Location(&input, 2, 3));
 }
 
+// Whitespace, comments and string bodies are scanned several bytes at a time,
+// so use runs longer than that with interesting characters at all offsets.
+TEST(Tokenizer, LongRuns) {
+  for (size_t padding = 0; padding < 40; padding++) {
+    std::string pad(padding, 'a');
+    std::string spaces(padding, ' ');
+    std::string escaped = "\"" + pad + "\\\"" + pad + "\\\\\"";
+    std::string contents = spaces + "\n" + spaces + escaped + " # " + pad +
+                           "\n\r\n" + spaces + "x" + spaces + "\n";
+
+    InputFile input(SourceFile("/test"));
+    input.SetContents(contents);
+    Err err;
+    std::vector<Token> results = Tokenizer::Tokenize(&input, &err);
+    EXPECT_FALSE(err.has_error());
+
+    ASSERT_EQ(3u, results.size());
+    EXPECT_EQ(Token::STRING, results[0].type());
+    EXPECT_EQ(escaped, results[0].value());
+    EXPECT_TRUE(results[0].location() ==
+                Location(&input, 2, static_cast<int>(padding) + 1));
+    EXPECT_EQ(Token::SUFFIX_COMMENT, results[1].type());
+    EXPECT_EQ("# " + pad, results[1].value());
+    EXPECT_TRUE(results[1].location() ==
+                Location(&input, 2,
+                         static_cast<int>(padding + escaped.size()) + 2));
+    EXPECT_EQ(Token::IDENTIFIER, results[2].type());
+    EXPECT_TRUE(results[2].location() ==
+                Location(&input, 4, static_cast<int>(padding) + 1));
+  }
+
+  // Newlines in long strings are still reported.
+  InputFile input(SourceFile("/test"));
+  input.SetContents("\"" + std::string(20, 'a') + "\n" +
+                    std::string(20, 'b') + "\"");
+  Err err;
+  Tokenizer::Tokenize(&input, &err);
+  ASSERT_TRUE(err.has_error());
+  EXPECT_EQ("Newline in string constant.", err.message());
+}
+
 TEST(Tokenizer, ByteOffsetOfNthLine) {
   EXPECT_EQ(0u, Tokenizer::ByteOffsetOfNthLine("foo", 1));
 
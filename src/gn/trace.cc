@@ -7,6 +7,7 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <sstream>
@@ -20,34 +21,208 @@
 #include "base/strings/stringprintf.h"
 #include "gn/filesystem_utils.h"
 #include "gn/label.h"
+#include "util/sys_info.h"
 
 namespace {
 
 constexpr uint64_t kNanosecondsToMicroseconds = 1'000;
 
+// Minimum interval between two samples of the resident memory counter.
+constexpr uint64_t kMemorySampleIntervalNs = 5'000'000;
+
+// Append-only list of fixed-size chunks. Only the owning thread appends, and
+// readers may walk it concurrently: every chunk publishes the number of valid
+// entries it holds, and new chunks are linked in only once initialized.
+template <typename T>
+class TraceChunkList {
+ public:
+  TraceChunkList() : head_(new Chunk), tail_(head_) {}
+  // Chunks are leaked intentionally, like the log that owns them.
+
+  void Append(const T& item) {
+    size_t count = tail_->count.load(std::memory_order_relaxed);
+    if (count == Chunk::kCapacity) {
+      Chunk* chunk = new Chunk;
+      tail_->next.store(chunk, std::memory_order_release);
+      tail_ = chunk;
+      count = 0;
+    }
+    tail_->items[count] = item;
+    tail_->count.store(count + 1, std::memory_order_release);
+  }
+
+  void CopyTo(std::vector<T>* out) const {
+    for (const Chunk* chunk = head_; chunk;
+         chunk = chunk->next.load(std::memory_order_acquire)) {
+      size_t count = chunk->count.load(std::memory_order_acquire);
+      out->insert(out->end(), chunk->items, chunk->items + count);
+    }
+  }
+
+ private:
+  struct Chunk {
+    static constexpr size_t kCapacity = 1024;
+
+    T items[kCapacity];
+    std::atomic<size_t> count{0};
+    std::atomic<Chunk*> next{nullptr};
+  };
+
+  Chunk* head_;
+  Chunk* tail_;  // Only accessed by the owning thread.
+
+  TraceChunkList(const TraceChunkList&) = delete;
+  TraceChunkList& operator=(const TraceChunkList&) = delete;
+};
+
+// Events recorded by one thread.
+struct ThreadTraceBuffer {
+  explicit ThreadTraceBuffer(int i) : index(i) {}
+
+  const int index;
+  TraceChunkList<TraceItem> items;
+  TraceChunkList<TraceCounterSample> counters;
+};
+
 class TraceLog {
  public:
-  TraceLog() { events_.reserve(16384); }
-  // Trace items leaked intentionally.
+  TraceLog() = default;
+  // Thread buffers leaked intentionally.
+
+  // Returns the buffer of the calling thread, creating it on first use. Only
+  // the first call on every thread takes the lock.
+  ThreadTraceBuffer* GetThreadBuffer() {
+    thread_local ThreadTraceBuffer* buffer = nullptr;
+    if (!buffer) {
+      std::lock_guard<std::mutex> lock(lock_);
+      buffer = new ThreadTraceBuffer(static_cast<int>(buffers_.size()));
+      buffers_.push_back(buffer);
+    }
+    return buffer;
+  }
 
-  void Add(TraceItem* item) {
-    std::lock_guard<std::mutex> lock(lock_);
-    events_.push_back(item);
+  void Add(TraceItem item) {
+    ThreadTraceBuffer* buffer = GetThreadBuffer();
+    item.set_thread_index(buffer->index);
+    buffer->items.Append(item);
+    MaybeSampleMemory(item.end());
+  }
+
+  void AddCounter(TraceCounter counter, int64_t value) {
+    TraceCounterSample sample;
+    sample.counter = counter;
+    sample.value = value;
+    sample.time = TicksNow();
+    GetThreadBuffer()->counters.Append(sample);
+    if (counter != TraceCounter::kResidentMemory)
+      MaybeSampleMemory(sample.time);
+  }
+
+  // Returns copies for threadsafety.
+  std::vector<TraceItem> events() const {
+    std::vector<TraceItem> result;
+    for (const ThreadTraceBuffer* buffer : buffers())
+      buffer->items.CopyTo(&result);
+    return result;
+  }
+  std::vector<TraceCounterSample> counters() const {
+    std::vector<TraceCounterSample> result;
+    for (const ThreadTraceBuffer* buffer : buffers())
+      buffer->counters.CopyTo(&result);
+    return result;
   }
 
-  // Returns a copy for threadsafety.
-  std::vector<TraceItem*> events() const { return events_; }
+  int thread_count() const { return static_cast<int>(buffers().size()); }
 
  private:
-  std::mutex lock_;
+  std::vector<ThreadTraceBuffer*> buffers() const {
+    std::lock_guard<std::mutex> lock(lock_);
+    return buffers_;
+  }
 
-  std::vector<TraceItem*> events_;
+  // Records the resident memory of the process, at most once per sample
+  // interval across all threads.
+  void MaybeSampleMemory(Ticks now) {
+    Ticks next = next_memory_sample_.load(std::memory_order_relaxed);
+    if (now < next || !next_memory_sample_.compare_exchange_strong(
+                          next, now + kMemorySampleIntervalNs)) {
+      return;
+    }
+    uint64_t resident = ResidentMemoryBytes();
+    if (resident)
+      AddCounter(TraceCounter::kResidentMemory,
+                 static_cast<int64_t>(resident));
+  }
+
+  mutable std::mutex lock_;
+  std::vector<ThreadTraceBuffer*> buffers_;
+
+  std::atomic<Ticks> next_memory_sample_{0};
 
   TraceLog(const TraceLog&) = delete;
   TraceLog& operator=(const TraceLog&) = delete;
 };
 
+// The log in use while tracing is enabled. The log is kept when tracing is
+// disabled since the thread buffers can't be reused with another one.
 TraceLog* trace_log = nullptr;
+TraceLog* kept_trace_log = nullptr;
+
+const char* GetCategoryName(TraceItem::Type type) {
+  switch (type) {
+    case TraceItem::TRACE_SETUP:
+      return "setup";
+    case TraceItem::TRACE_FILE_LOAD:
+      return "load";
+    case TraceItem::TRACE_FILE_PARSE:
+      return "parse";
+    case TraceItem::TRACE_FILE_EXECUTE:
+      return "file_exec";
+    case TraceItem::TRACE_FILE_WRITE:
+      return "file_write";
+    case TraceItem::TRACE_IMPORT_LOAD:
+      return "import_load";
+    case TraceItem::TRACE_IMPORT_BLOCK:
+      return "import_block";
+    case TraceItem::TRACE_SCRIPT_EXECUTE:
+      return "script_exec";
+    case TraceItem::TRACE_DEFINE_TARGET:
+      return "define";
+    case TraceItem::TRACE_ON_RESOLVED:
+      return "onresolved";
+    case TraceItem::TRACE_CHECK_HEADER:
+      return "hdr";
+    case TraceItem::TRACE_CHECK_HEADERS:
+      return "header_check";
+    case TraceItem::TRACE_RESOLVE:
+      return "resolve";
+    case TraceItem::TRACE_TARGET_WRITE:
+      return "target_write";
+    case TraceItem::TRACE_JUMBO_WRITE:
+      return "jumbo_write";
+    case TraceItem::TRACE_RUNTIME_DEPS:
+      return "runtime_deps";
+    case TraceItem::TRACE_IDE_WRITE:
+      return "ide_write";
+  }
+  NOTREACHED();
+  return "";
+}
+
+const char* GetCounterName(TraceCounter counter) {
+  switch (counter) {
+    case TraceCounter::kWorkerPoolQueueDepth:
+      return "Worker pool queue depth";
+    case TraceCounter::kWorkerPoolIoQueueDepth:
+      return "Worker pool I/O queue depth";
+    case TraceCounter::kPendingLoads:
+      return "Pending loads";
+    case TraceCounter::kResidentMemory:
+      return "Resident memory";
+  }
+  NOTREACHED();
+  return "";
+}
 
 struct Coalesced {
   Coalesced() : name_ptr(nullptr), total_duration(0.0), count(0) {}
@@ -112,27 +287,23 @@ void SummarizeScriptExecs(std::vector<const TraceItem*>& execs,
 
 }  // namespace
 
-TraceItem::TraceItem(Type type,
-                     const std::string& name,
-                     std::thread::id thread_id)
-    : type_(type), name_(name), thread_id_(thread_id) {}
-
-TraceItem::~TraceItem() = default;
+TraceItem::TraceItem(Type type, StringAtom name) : type_(type), name_(name) {}
 
 ScopedTrace::ScopedTrace(TraceItem::Type t, const std::string& name)
-    : item_(nullptr), done_(false) {
+    : active_(false), done_(false) {
   if (trace_log) {
-    item_ = new TraceItem(t, name, std::this_thread::get_id());
-    item_->set_begin(TicksNow());
+    active_ = true;
+    item_ = TraceItem(t, StringAtom(name));
+    item_.set_begin(TicksNow());
   }
 }
 
 ScopedTrace::ScopedTrace(TraceItem::Type t, const Label& label)
-    : item_(nullptr), done_(false) {
+    : active_(false), done_(false) {
   if (trace_log) {
-    item_ = new TraceItem(t, label.GetUserVisibleName(false),
-                          std::this_thread::get_id());
-    item_->set_begin(TicksNow());
+    active_ = true;
+    item_ = TraceItem(t, StringAtom(label.GetUserVisibleName(false)));
+    item_.set_begin(TicksNow());
   }
 }
 
@@ -141,43 +312,73 @@ ScopedTrace::~ScopedTrace() {
 }
 
 void ScopedTrace::SetToolchain(const Label& label) {
-  if (item_)
-    item_->set_toolchain(label.GetUserVisibleName(false));
+  if (active_)
+    item_.set_toolchain(StringAtom(label.GetUserVisibleName(false)));
 }
 
 void ScopedTrace::SetCommandLine(const base::CommandLine& cmdline) {
-  if (item_)
-    item_->set_cmdline(FilePathToUTF8(cmdline.GetArgumentsString()));
+  if (active_)
+    item_.set_cmdline(
+        StringAtom(FilePathToUTF8(cmdline.GetArgumentsString())));
 }
 
 void ScopedTrace::Done() {
   if (!done_) {
     done_ = true;
-    if (trace_log) {
-      item_->set_end(TicksNow());
+    if (active_) {
+      item_.set_end(TicksNow());
       AddTrace(item_);
     }
   }
 }
 
 void EnableTracing() {
-  if (!trace_log)
-    trace_log = new TraceLog;
+  if (!kept_trace_log)
+    kept_trace_log = new TraceLog;
+  trace_log = kept_trace_log;
+}
+
+void DisableTracing() {
+  trace_log = nullptr;
 }
 
 bool TracingEnabled() {
   return !!trace_log;
 }
 
-void AddTrace(TraceItem* item) {
-  trace_log->Add(item);
+void AddTrace(const TraceItem& item) {
+  // A ScopedTrace created while tracing was on may complete after it was
+  // disabled.
+  if (trace_log)
+    trace_log->Add(item);
+}
+
+void AddTraceCounter(TraceCounter counter, int64_t value) {
+  if (trace_log)
+    trace_log->AddCounter(counter, value);
+}
+
+std::vector<TraceItem> GetAllTraces() {
+  if (!trace_log)
+    return std::vector<TraceItem>();
+  return trace_log->events();
+}
+
+std::vector<TraceCounterSample> GetAllTraceCounters() {
+  if (!trace_log)
+    return std::vector<TraceCounterSample>();
+  std::vector<TraceCounterSample> samples = trace_log->counters();
+  std::stable_sort(samples.begin(), samples.end(),
+                   [](const TraceCounterSample& a,
+                      const TraceCounterSample& b) { return a.time < b.time; });
+  return samples;
 }
 
 std::string SummarizeTraces() {
   if (!trace_log)
     return std::string();
 
-  std::vector<TraceItem*> events = trace_log->events();
+  std::vector<TraceItem> events = trace_log->events();
 
   // Classify all events.
   std::vector<const TraceItem*> parses;
@@ -185,19 +386,19 @@ std::string SummarizeTraces() {
   std::vector<const TraceItem*> script_execs;
   std::vector<const TraceItem*> check_headers;
   int headers_checked = 0;
-  for (auto* event : events) {
-    switch (event->type()) {
+  for (const auto& event : events) {
+    switch (event.type()) {
       case TraceItem::TRACE_FILE_PARSE:
-        parses.push_back(event);
+        parses.push_back(&event);
         break;
       case TraceItem::TRACE_FILE_EXECUTE:
-        file_execs.push_back(event);
+        file_execs.push_back(&event);
         break;
       case TraceItem::TRACE_SCRIPT_EXECUTE:
-        script_execs.push_back(event);
+        script_execs.push_back(&event);
         break;
       case TraceItem::TRACE_CHECK_HEADERS:
-        check_headers.push_back(event);
+        check_headers.push_back(&event);
         break;
       case TraceItem::TRACE_CHECK_HEADER:
         headers_checked++;
@@ -209,6 +410,11 @@ std::string SummarizeTraces() {
       case TraceItem::TRACE_FILE_WRITE:
       case TraceItem::TRACE_DEFINE_TARGET:
       case TraceItem::TRACE_ON_RESOLVED:
+      case TraceItem::TRACE_RESOLVE:
+      case TraceItem::TRACE_TARGET_WRITE:
+      case TraceItem::TRACE_JUMBO_WRITE:
+      case TraceItem::TRACE_RUNTIME_DEPS:
+      case TraceItem::TRACE_IDE_WRITE:
         break;  // Ignore these for the summary.
     }
   }
@@ -237,26 +443,33 @@ std::string SummarizeTraces() {
   return out.str();
 }
 
-void SaveTraces(const base::FilePath& file_name) {
+std::string TracesToJSON() {
   std::ostringstream out;
 
-  out << "{\"traceEvents\":[";
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
 
   std::string quote_buffer;  // Allocate outside loop to prevent reallocationg.
 
-  // Write main thread metadata (assume this is being written on the main
-  // thread).
-  out << "{\"pid\":0,\"tid\":\"" << std::this_thread::get_id() << "\"";
-  out << ",\"ts\":0,\"ph\":\"M\",";
-  out << "\"name\":\"thread_name\",\"args\":{\"name\":\"Main thread\"}},";
-
-  std::vector<TraceItem*> events = trace_log->events();
-  for (size_t i = 0; i < events.size(); i++) {
-    const TraceItem& item = *events[i];
-
+  // Thread ids are the 1-based index of the trace buffer of each thread.
+  // Write thread metadata, assuming this is being written on the main thread.
+  int main_thread = trace_log->GetThreadBuffer()->index;
+  int thread_count = trace_log->thread_count();
+  for (int i = 0; i < thread_count; i++) {
     if (i != 0)
       out << ",";
-    out << "{\"pid\":0,\"tid\":\"" << item.thread_id() << "\"";
+    out << "{\"pid\":0,\"tid\":" << i + 1;
+    out << ",\"ts\":0,\"ph\":\"M\",";
+    out << "\"name\":\"thread_name\",\"args\":{\"name\":\"";
+    if (i == main_thread)
+      out << "Main thread";
+    else
+      out << "Worker " << i;
+    out << "\"}}";
+  }
+
+  std::vector<TraceItem> events = trace_log->events();
+  for (const TraceItem& item : events) {
+    out << ",{\"pid\":0,\"tid\":" << item.thread_index() + 1;
     out << ",\"ts\":" << item.begin() / kNanosecondsToMicroseconds;
     out << ",\"ph\":\"X\"";  // "X" = complete event with begin & duration.
     out << ",\"dur\":" << item.delta().InMicroseconds();
@@ -265,45 +478,7 @@ void SaveTraces(const base::FilePath& file_name) {
     base::EscapeJSONString(item.name(), true, &quote_buffer);
     out << ",\"name\":" << quote_buffer;
 
-    out << ",\"cat\":";
-    switch (item.type()) {
-      case TraceItem::TRACE_SETUP:
-        out << "\"setup\"";
-        break;
-      case TraceItem::TRACE_FILE_LOAD:
-        out << "\"load\"";
-        break;
-      case TraceItem::TRACE_FILE_PARSE:
-        out << "\"parse\"";
-        break;
-      case TraceItem::TRACE_FILE_EXECUTE:
-        out << "\"file_exec\"";
-        break;
-      case TraceItem::TRACE_FILE_WRITE:
-        out << "\"file_write\"";
-        break;
-      case TraceItem::TRACE_IMPORT_LOAD:
-        out << "\"import_load\"";
-        break;
-      case TraceItem::TRACE_IMPORT_BLOCK:
-        out << "\"import_block\"";
-        break;
-      case TraceItem::TRACE_SCRIPT_EXECUTE:
-        out << "\"script_exec\"";
-        break;
-      case TraceItem::TRACE_DEFINE_TARGET:
-        out << "\"define\"";
-        break;
-      case TraceItem::TRACE_ON_RESOLVED:
-        out << "\"onresolved\"";
-        break;
-      case TraceItem::TRACE_CHECK_HEADER:
-        out << "\"hdr\"";
-        break;
-      case TraceItem::TRACE_CHECK_HEADERS:
-        out << "\"header_check\"";
-        break;
-    }
+    out << ",\"cat\":\"" << GetCategoryName(item.type()) << "\"";
 
     if (!item.toolchain().empty() || !item.cmdline().empty()) {
       out << ",\"args\":{";
@@ -327,8 +502,20 @@ void SaveTraces(const base::FilePath& file_name) {
     out << "}";
   }
 
+  // Counters are process-wide tracks ("C" events), keyed by name.
+  for (const TraceCounterSample& sample : GetAllTraceCounters()) {
+    out << ",{\"pid\":0";
+    out << ",\"ts\":" << sample.time / kNanosecondsToMicroseconds;
+    out << ",\"ph\":\"C\"";
+    out << ",\"name\":\"" << GetCounterName(sample.counter) << "\"";
+    out << ",\"args\":{\"value\":" << sample.value << "}}";
+  }
+
   out << "]}";
+  return out.str();
+}
 
-  std::string out_str = out.str();
+void SaveTraces(const base::FilePath& file_name) {
+  std::string out_str = TracesToJSON();
   base::WriteFile(file_name, out_str.data(), static_cast<int>(out_str.size()));
 }
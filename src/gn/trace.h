@@ -5,9 +5,12 @@
 #ifndef TOOLS_GN_TRACE_H_
 #define TOOLS_GN_TRACE_H_
 
+#include <stdint.h>
+
 #include <string>
-#include <thread>
+#include <vector>
 
+#include "gn/string_atom.h"
 #include "util/ticks.h"
 
 class Label;
@@ -17,6 +20,9 @@ class CommandLine;
 class FilePath;
 }  // namespace base
 
+// A single completed trace event. Trace items are small value types: all
+// strings are interned so that recording an event never allocates once a
+// given name has been seen.
 class TraceItem {
  public:
   enum Type {
@@ -32,14 +38,23 @@ class TraceItem {
     TRACE_ON_RESOLVED,
     TRACE_CHECK_HEADER,   // One file.
     TRACE_CHECK_HEADERS,  // All files.
+    TRACE_RESOLVE,        // Builder resolution of one item.
+    TRACE_TARGET_WRITE,   // Ninja file for one target.
+    TRACE_JUMBO_WRITE,    // Jumbo files for one target.
+    TRACE_RUNTIME_DEPS,   // One runtime deps file.
+    TRACE_IDE_WRITE,      // One IDE or project writer.
   };
 
-  TraceItem(Type type, const std::string& name, std::thread::id thread_id);
-  ~TraceItem();
+  TraceItem() = default;
+  TraceItem(Type type, StringAtom name);
 
   Type type() const { return type_; }
-  const std::string& name() const { return name_; }
-  std::thread::id thread_id() const { return thread_id_; }
+  const std::string& name() const { return name_.str(); }
+
+  // Index of the thread that recorded this item, assigned in the order in
+  // which threads first record a trace event. Set when the item is added.
+  int thread_index() const { return thread_index_; }
+  void set_thread_index(int index) { thread_index_ = index; }
 
   Ticks begin() const { return begin_; }
   void set_begin(Ticks b) { begin_ = b; }
@@ -49,23 +64,38 @@ class TraceItem {
   TickDelta delta() const { return TicksDelta(end_, begin_); }
 
   // Optional toolchain label.
-  const std::string& toolchain() const { return toolchain_; }
-  void set_toolchain(const std::string& t) { toolchain_ = t; }
+  const std::string& toolchain() const { return toolchain_.str(); }
+  void set_toolchain(StringAtom t) { toolchain_ = t; }
 
   // Optional command line.
-  const std::string& cmdline() const { return cmdline_; }
-  void set_cmdline(const std::string& c) { cmdline_ = c; }
+  const std::string& cmdline() const { return cmdline_.str(); }
+  void set_cmdline(StringAtom c) { cmdline_ = c; }
 
  private:
-  Type type_;
-  std::string name_;
-  std::thread::id thread_id_;
+  Type type_ = TRACE_SETUP;
+  int thread_index_ = 0;
+  StringAtom name_;
+
+  Ticks begin_ = 0;
+  Ticks end_ = 0;
 
-  Ticks begin_;
-  Ticks end_;
+  StringAtom toolchain_;
+  StringAtom cmdline_;
+};
+
+// Counter tracks. Each sample records the value of one counter at a point in
+// time, and is shown as a graph when the trace is loaded.
+enum class TraceCounter {
+  kWorkerPoolQueueDepth,
+  kWorkerPoolIoQueueDepth,
+  kPendingLoads,
+  kResidentMemory,
+};
 
-  std::string toolchain_;
-  std::string cmdline_;
+struct TraceCounterSample {
+  TraceCounter counter = TraceCounter::kWorkerPoolQueueDepth;
+  int64_t value = 0;
+  Ticks time = 0;
 };
 
 class ScopedTrace {
@@ -80,23 +110,45 @@ class ScopedTrace {
   void Done();
 
  private:
-  TraceItem* item_;
+  TraceItem item_;
+  bool active_;
   bool done_;
 };
 
 // Call to turn tracing on. It's off by default.
 void EnableTracing();
 
+// Turns tracing off again. The events already recorded are kept, and are
+// reported again if tracing is re-enabled.
+void DisableTracing();
+
 // Returns whether tracing is enabled.
 bool TracingEnabled();
 
-// Adds a trace event to the log. Takes ownership of the pointer.
-void AddTrace(TraceItem* item);
+// Adds a trace event to the log of the calling thread. Does not take any
+// locks after the first event recorded on a given thread.
+void AddTrace(const TraceItem& item);
+
+// Records a sample of the given counter on the calling thread. Does nothing
+// if tracing is not enabled.
+void AddTraceCounter(TraceCounter counter, int64_t value);
+
+// Returns a copy of all trace events recorded so far, from all threads. This
+// is intended to be called once all traced work has completed.
+std::vector<TraceItem> GetAllTraces();
+
+// Returns a copy of all counter samples recorded so far, from all threads,
+// ordered by time.
+std::vector<TraceCounterSample> GetAllTraceCounters();
 
 // Returns a summary of the current traces, or the empty string if tracing is
 // not enabled.
 std::string SummarizeTraces();
 
+// Returns the current traces in the Chrome JSON trace event format, which is
+// understood by both chrome://tracing and Perfetto.
+std::string TracesToJSON();
+
 // Saves the current traces to the given filename in JSON format.
 void SaveTraces(const base::FilePath& file_name);
 
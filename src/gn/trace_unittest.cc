@@ -0,0 +1,131 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gn/trace.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "util/test/test.h"
+
+namespace {
+
+// Enables tracing for the lifetime of a test, so that it is left off for the
+// following tests whatever the outcome.
+class ScopedTracing {
+ public:
+  ScopedTracing() { EnableTracing(); }
+  ~ScopedTracing() { DisableTracing(); }
+};
+
+// Returns the traces with the given name.
+std::vector<TraceItem> FindTraces(const std::string& name) {
+  std::vector<TraceItem> result;
+  for (const TraceItem& item : GetAllTraces()) {
+    if (item.name() == name)
+      result.push_back(item);
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(Trace, PerThreadBuffers) {
+  ScopedTracing tracing;
+
+  // Enough events to span several chunks per thread.
+  constexpr int kThreads = 4;
+  constexpr int kEventsPerThread = 3000;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; i++) {
+    threads.emplace_back([]() {
+      for (int j = 0; j < kEventsPerThread; j++)
+        ScopedTrace trace(TraceItem::TRACE_RESOLVE, "trace_unittest_threads");
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  std::vector<TraceItem> items = FindTraces("trace_unittest_threads");
+  ASSERT_EQ(static_cast<size_t>(kThreads * kEventsPerThread), items.size());
+
+  // Every thread recorded into its own buffer.
+  std::vector<int> thread_indices;
+  for (const TraceItem& item : items) {
+    EXPECT_EQ(TraceItem::TRACE_RESOLVE, item.type());
+    EXPECT_LE(item.begin(), item.end());
+    thread_indices.push_back(item.thread_index());
+  }
+  std::sort(thread_indices.begin(), thread_indices.end());
+  thread_indices.erase(
+      std::unique(thread_indices.begin(), thread_indices.end()),
+      thread_indices.end());
+  EXPECT_EQ(static_cast<size_t>(kThreads), thread_indices.size());
+}
+
+TEST(Trace, CountersAndJSON) {
+  ScopedTracing tracing;
+
+  {
+    ScopedTrace trace(TraceItem::TRACE_JUMBO_WRITE, "trace_unittest_\"json\"");
+  }
+  AddTraceCounter(TraceCounter::kPendingLoads, 3);
+  AddTraceCounter(TraceCounter::kPendingLoads, 2);
+
+  std::vector<TraceCounterSample> counters = GetAllTraceCounters();
+  std::vector<int64_t> pending;
+  for (size_t i = 0; i < counters.size(); i++) {
+    if (i > 0) {
+      EXPECT_LE(counters[i - 1].time, counters[i].time);
+    }
+    if (counters[i].counter == TraceCounter::kPendingLoads)
+      pending.push_back(counters[i].value);
+  }
+  ASSERT_LE(2u, pending.size());
+  EXPECT_EQ(3, pending[pending.size() - 2]);
+  EXPECT_EQ(2, pending[pending.size() - 1]);
+
+  std::string json = TracesToJSON();
+  EXPECT_NE(std::string::npos,
+            json.find("\"name\":\"trace_unittest_\\\"json\\\"\","
+                      "\"cat\":\"jumbo_write\""));
+  EXPECT_NE(std::string::npos,
+            json.find("\"ph\":\"C\",\"name\":\"Pending loads\","
+                      "\"args\":{\"value\":2}"));
+  EXPECT_NE(std::string::npos,
+            json.find("\"args\":{\"name\":\"Main thread\"}"));
+  EXPECT_EQ(0u, json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  EXPECT_EQ(json.size() - 2, json.rfind("]}"));
+}
+
+TEST(Trace, Disable) {
+  {
+    ScopedTracing tracing;
+    EXPECT_TRUE(TracingEnabled());
+  }
+  EXPECT_FALSE(TracingEnabled());
+
+  // Nothing is recorded while tracing is off.
+  {
+    ScopedTrace trace(TraceItem::TRACE_RESOLVE, "trace_unittest_disabled");
+  }
+  AddTraceCounter(TraceCounter::kPendingLoads, 1);
+  EXPECT_TRUE(GetAllTraces().empty());
+  EXPECT_TRUE(GetAllTraceCounters().empty());
+}
+
+TEST(Trace, DisableWhileScopedTraceIsOpen) {
+  // Tracing is turned off before the trace completes, which must not record
+  // nor crash.
+  {
+    ScopedTracing tracing;
+    ScopedTrace trace(TraceItem::TRACE_RESOLVE, "trace_unittest_outlives");
+    DisableTracing();
+  }
+  EXPECT_FALSE(TracingEnabled());
+
+  ScopedTracing tracing;
+  EXPECT_TRUE(FindTraces("trace_unittest_outlives").empty());
+}
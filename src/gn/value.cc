@@ -49,7 +49,11 @@ Value::Value(const ParseNode* origin, const char* str_val)
     : type_(STRING), origin_(origin), string_value_(str_val) {}
 
 Value::Value(const ParseNode* origin, std::unique_ptr<Scope> scope)
-    : type_(SCOPE), origin_(origin), scope_value_(std::move(scope)) {}
+    : type_(SCOPE), origin_(origin), scope_value_(std::move(scope)) {
+  // Scopes belong to the toolchain they're created in.
+  if (ImportProbe* probe = ImportProbe::Current())
+    probe->set_depends_on_toolchain();
+}
 
 Value::Value(const Value& other) : type_(other.type_), origin_(other.origin_) {
   switch (type_) {
@@ -154,6 +158,8 @@ const char* Value::DescribeType(Type t) {
 void Value::SetScopeValue(std::unique_ptr<Scope> scope) {
   DCHECK(type_ == SCOPE);
   scope_value_ = std::move(scope);
+  if (ImportProbe* probe = ImportProbe::Current())
+    probe->set_depends_on_toolchain();
 }
 
 std::string Value::ToString(bool quote_string) const {
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "gn/label_pattern.h"
+#include "gn/label_pattern_set.h"
 #include "gn/source_dir.h"
 
 namespace base {
@@ -63,7 +64,8 @@ class Visibility {
   static bool FillItemVisibility(Item* item, Scope* scope, Err* err);
 
  private:
-  std::vector<LabelPattern> patterns_;
+  // Checked for every dependency edge, so compiled for fast matching.
+  LabelPatternSet patterns_;
 
   Visibility(const Visibility&) = delete;
   Visibility& operator=(const Visibility&) = delete;
@@ -109,20 +109,24 @@ class VisualStudioWriter {
                      const std::string& win_kit);
   ~VisualStudioWriter();
 
-  bool WriteProjectFiles(const Target* target,
-                         const std::string& ninja_extra_args,
-                         const std::string& ninja_executable,
-                         Err* err);
+  // Writes the project and filters files for the given target and returns
+  // its solution entry, or null on error. Safe to call from several threads.
+  std::unique_ptr<SolutionProject> WriteProjectFiles(
+      const Target* target,
+      const std::string& ninja_extra_args,
+      const std::string& ninja_executable,
+      Err* err) const;
   bool WriteProjectFileContents(std::ostream& out,
                                 const SolutionProject& solution_project,
                                 const Target* target,
                                 const std::string& ninja_extra_args,
                                 const std::string& ninja_executable,
                                 SourceFileCompileTypePairs* source_types,
-                                Err* err);
-  void WriteFiltersFileContents(std::ostream& out,
-                                const Target* target,
-                                const SourceFileCompileTypePairs& source_types);
+                                Err* err) const;
+  void WriteFiltersFileContents(
+      std::ostream& out,
+      const Target* target,
+      const SourceFileCompileTypePairs& source_types) const;
   bool WriteSolutionFile(const std::string& sln_name, Err* err);
   void WriteSolutionFileContents(std::ostream& out,
                                  const base::FilePath& solution_dir_path);
@@ -131,7 +135,7 @@ class VisualStudioWriter {
   // and updates |root_folder_dir_|. Also sets |parent_folder| for |projects_|.
   void ResolveSolutionFolders();
 
-  std::string GetNinjaTarget(const Target* target);
+  std::string GetNinjaTarget(const Target* target) const;
 
   const BuildSettings* build_settings_;
 
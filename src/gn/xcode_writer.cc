@@ -4,6 +4,7 @@
 
 #include "gn/xcode_writer.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iterator>
 #include <map>
@@ -37,6 +38,7 @@
 #include "gn/value.h"
 #include "gn/variables.h"
 #include "gn/xcode_object.h"
+#include "util/worker_pool.h"
 
 namespace {
 
@@ -106,6 +108,10 @@ const char* kXCTestFileSuffixes[] = {
 const char kXCTestModuleTargetNamePostfix[] = "_module";
 const char kXCUITestRunnerTargetNamePostfix[] = "_runner";
 
+// Number of targets whose files are collected by a single task when looking
+// for the project sources.
+constexpr size_t kTargetsPerSourcesTask = 64;
+
 struct SafeEnvironmentVariableInfo {
   const char* name;
   bool capture_at_generation;
@@ -606,6 +612,11 @@ class XcodeProject {
   // Returns whether the file should be added to the project.
   bool ShouldIncludeFileInProject(const SourceFile& source) const;
 
+  // Appends the files of |target| that should be added to the project to
+  // |sources|. Safe to call from several threads.
+  void CollectTargetSources(const Target* target,
+                            std::vector<SourceFile>* sources) const;
+
   const BuildSettings* build_settings_;
   XcodeWriter::Options options_;
   PBXProject project_;
@@ -632,37 +643,60 @@ bool XcodeProject::ShouldIncludeFileInProject(const SourceFile& source) const {
   return true;
 }
 
-bool XcodeProject::AddSourcesFromBuilder(const Builder& builder, Err* err) {
-  SourceFileSet sources;
+void XcodeProject::CollectTargetSources(
+    const Target* target,
+    std::vector<SourceFile>* sources) const {
+  for (const SourceFile& source : target->sources()) {
+    if (ShouldIncludeFileInProject(source))
+      sources->push_back(source);
+  }
 
-  // Add sources from all targets.
-  for (const Target* target : builder.GetAllResolvedTargets()) {
-    for (const SourceFile& source : target->sources()) {
-      if (ShouldIncludeFileInProject(source))
-        sources.insert(source);
-    }
+  for (const SourceFile& source : target->config_values().inputs()) {
+    if (ShouldIncludeFileInProject(source))
+      sources->push_back(source);
+  }
 
-    for (const SourceFile& source : target->config_values().inputs()) {
-      if (ShouldIncludeFileInProject(source))
-        sources.insert(source);
-    }
+  for (const SourceFile& source : target->public_headers()) {
+    if (ShouldIncludeFileInProject(source))
+      sources->push_back(source);
+  }
 
-    for (const SourceFile& source : target->public_headers()) {
-      if (ShouldIncludeFileInProject(source))
-        sources.insert(source);
-    }
+  const SourceFile& bridge_header = target->swift_values().bridge_header();
+  if (!bridge_header.is_null() && ShouldIncludeFileInProject(bridge_header)) {
+    sources->push_back(bridge_header);
+  }
 
-    const SourceFile& bridge_header = target->swift_values().bridge_header();
-    if (!bridge_header.is_null() && ShouldIncludeFileInProject(bridge_header)) {
-      sources.insert(bridge_header);
-    }
+  if (target->output_type() == Target::ACTION ||
+      target->output_type() == Target::ACTION_FOREACH) {
+    if (ShouldIncludeFileInProject(target->action_values().script()))
+      sources->push_back(target->action_values().script());
+  }
+}
+
+bool XcodeProject::AddSourcesFromBuilder(const Builder& builder, Err* err) {
+  SourceFileSet sources;
 
-    if (target->output_type() == Target::ACTION ||
-        target->output_type() == Target::ACTION_FOREACH) {
-      if (ShouldIncludeFileInProject(target->action_values().script()))
-        sources.insert(target->action_values().script());
+  // Add sources from all targets. The targets are independent so they are
+  // split in batches processed on a worker pool, each batch writing to its
+  // own vector. The results are sorted below so the project does not depend
+  // on the order in which batches complete.
+  const std::vector<const Target*> targets = builder.GetAllResolvedTargets();
+  std::vector<std::vector<SourceFile>> target_sources(
+      (targets.size() + kTargetsPerSourcesTask - 1) / kTargetsPerSourcesTask);
+  {
+    TaskGroup tasks(WorkerPool::Get());
+    for (size_t batch = 0; batch < target_sources.size(); batch++) {
+      tasks.PostTask([this, &targets, &target_sources, batch]() {
+        const size_t begin = batch * kTargetsPerSourcesTask;
+        const size_t end =
+            std::min(targets.size(), begin + kTargetsPerSourcesTask);
+        for (size_t i = begin; i < end; i++)
+          CollectTargetSources(targets[i], &target_sources[batch]);
+      });
     }
   }
+  for (const std::vector<SourceFile>& batch_sources : target_sources)
+    sources.insert(batch_sources.begin(), batch_sources.end());
 
   // Add BUILD.gn and *.gni for targets, configs and toolchains.
   for (const Item* item : builder.GetAllResolvedItems()) {
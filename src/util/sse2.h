@@ -0,0 +1,56 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can
+// be found in the LICENSE file.
+
+#ifndef UTIL_SSE2_H_
+#define UTIL_SSE2_H_
+
+// Helpers for scanning strings 16 bytes at a time. They are only available
+// when HAS_SSE2 is defined; callers keep a scalar loop for the other
+// architectures and for the tail of the input.
+//
+// GCC and Clang define __SSE2__ when targeting SSE2, which x86-64 always
+// supports. MSVC doesn't, but defines _M_X64, or _M_IX86_FP to 2 or more on
+// 32-bit x86 when SSE2 code generation is enabled.
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HAS_SSE2 1
+#endif
+
+#if defined(HAS_SSE2)
+#include <emmintrin.h>
+#include <stddef.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Returns the index of the lowest set bit of a non-zero |mask|.
+inline size_t LowestSetBit(unsigned mask) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return index;
+#else
+  return __builtin_ctz(mask);
+#endif
+}
+
+inline __m128i Load16(const char* data) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+// Returns 0xFF in the bytes of |chunk| equal to |c|, and 0 in the others.
+inline __m128i BytesEqual(__m128i chunk, char c) {
+  return _mm_cmpeq_epi8(chunk, _mm_set1_epi8(c));
+}
+
+// Returns 0xFF in the bytes of |chunk| in [lo, hi], and 0 in the others.
+// Bytes are compared as signed, so both bounds must be ASCII.
+inline __m128i BytesInRange(__m128i chunk, char lo, char hi) {
+  return _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8(lo - 1)),
+                       _mm_cmplt_epi8(chunk, _mm_set1_epi8(hi + 1)));
+}
+#endif  // defined(HAS_SSE2)
+
+#endif  // UTIL_SSE2_H_
@@ -4,6 +4,11 @@
 
 #include "util/sys_info.h"
 
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+
 #include "base/logging.h"
 #include "util/build_config.h"
 
@@ -12,10 +17,118 @@
 #include <unistd.h>
 #endif
 
+#if defined(OS_LINUX)
+#include <sched.h>
+#include <string.h>
+#endif
+
+#if defined(OS_MACOSX)
+#include <mach/mach.h>
+#endif
+
 #if defined(OS_WIN)
 #include <windows.h>
+
+#include <psapi.h>
+#endif
+
+namespace {
+
+#if defined(OS_LINUX)
+// Returns the path of the cgroup v2 directory of the current process relative
+// to the cgroup mount point, or "/" if it can't be determined.
+std::string CgroupV2Path() {
+  FILE* file = fopen("/proc/self/cgroup", "r");
+  if (!file)
+    return "/";
+  std::string result = "/";
+  char line[4096];
+  while (fgets(line, sizeof(line), file)) {
+    // The unified hierarchy is the one with id 0 and no controllers.
+    if (strncmp(line, "0::", 3) == 0) {
+      result = line + 3;
+      if (!result.empty() && result.back() == '\n')
+        result.pop_back();
+      break;
+    }
+  }
+  fclose(file);
+  return result;
+}
+
+// Reads a single number from |path|, returning false if it can't be read.
+bool ReadNumberFromFile(const std::string& path, long long* value) {
+  FILE* file = fopen(path.c_str(), "r");
+  if (!file)
+    return false;
+  int fields = fscanf(file, "%lld", value);
+  fclose(file);
+  return fields == 1;
+}
+
+// Returns the number of CPUs the cgroup of the current process is allowed to
+// use, or 0 if it isn't limited. Supports both the cgroup v2 "cpu.max" files
+// and the cgroup v1 CFS quota files. For cgroup v1 only the quota of the
+// hierarchy root is read, which is the cgroup of the process when it runs in a
+// container with its own cgroup namespace, but misses the quotas of nested
+// cgroups otherwise.
+int CgroupCpuLimit() {
+  if (access("/sys/fs/cgroup/cgroup.controllers", F_OK) == 0)
+    return CgroupV2CpuLimit("/sys/fs/cgroup", CgroupV2Path());
+
+  // cgroup v1 keeps the quota and the period in separate files. A quota of -1
+  // means no limit.
+  for (const char* dir : {"/sys/fs/cgroup/cpu,cpuacct", "/sys/fs/cgroup/cpu"}) {
+    long long quota = 0;
+    long long period = 0;
+    if (ReadNumberFromFile(std::string(dir) + "/cpu.cfs_quota_us", &quota) &&
+        ReadNumberFromFile(std::string(dir) + "/cpu.cfs_period_us", &period)) {
+      return CpuLimitFromQuota(std::to_string(quota), period);
+    }
+  }
+  return 0;
+}
 #endif
 
+}  // namespace
+
+int CpuLimitFromQuota(const std::string& quota, long long period) {
+  if (quota == "max" || period <= 0)
+    return 0;
+  long long value = atoll(quota.c_str());
+  if (value <= 0)
+    return 0;
+  return static_cast<int>((value + period - 1) / period);
+}
+
+int CgroupV2CpuLimit(const std::string& mount_point, const std::string& path) {
+  int result = 0;
+  std::string dir = path;
+  while (true) {
+    while (!dir.empty() && dir.back() == '/')
+      dir.pop_back();
+    // Each "cpu.max" file contains the quota, or "max" for no limit, and the
+    // period. The limit of a cgroup also applies to all of its descendants, so
+    // the strictest one along the path wins.
+    FILE* file = fopen((mount_point + dir + "/cpu.max").c_str(), "r");
+    if (file) {
+      char quota[32] = {};
+      long long period = 0;
+      if (fscanf(file, "%31s %lld", quota, &period) == 2) {
+        int limit = CpuLimitFromQuota(quota, period);
+        if (limit > 0 && (result == 0 || limit < result))
+          result = limit;
+      }
+      fclose(file);
+    }
+    if (dir.empty())
+      break;
+    size_t slash = dir.rfind('/');
+    dir.erase(slash == std::string::npos ? 0 : slash);
+  }
+  return result;
+}
+
 std::string OperatingSystemArchitecture() {
 #if defined(OS_POSIX)
   struct utsname info;
@@ -88,3 +201,55 @@ int NumberOfProcessors() {
 #error
 #endif
 }
+
+uint64_t ResidentMemoryBytes() {
+#if defined(OS_LINUX)
+  // The second field of statm is the number of resident pages.
+  FILE* file = fopen("/proc/self/statm", "r");
+  if (!file)
+    return 0;
+  unsigned long long size = 0;
+  unsigned long long resident = 0;
+  int fields = fscanf(file, "%llu %llu", &size, &resident);
+  fclose(file);
+  if (fields != 2)
+    return 0;
+  return static_cast<uint64_t>(resident) *
+         static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#elif defined(OS_MACOSX)
+  mach_task_basic_info_data_t info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) {
+    return 0;
+  }
+  return info.resident_size;
+#elif defined(OS_WIN)
+  PROCESS_MEMORY_COUNTERS counters = {};
+  if (!::K32GetProcessMemoryInfo(::GetCurrentProcess(), &counters,
+                                 sizeof(counters))) {
+    return 0;
+  }
+  return counters.WorkingSetSize;
+#else
+  return 0;
+#endif
+}
+
+int NumberOfAvailableProcessors() {
+  int processors = NumberOfProcessors();
+#if defined(OS_LINUX)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+    int affinity = CPU_COUNT(&cpu_set);
+    if (affinity > 0)
+      processors = std::min(processors, affinity);
+  }
+
+  int cgroup_limit = CgroupCpuLimit();
+  if (cgroup_limit > 0)
+    processors = std::min(processors, cgroup_limit);
+#endif
+  return std::max(processors, 1);
+}
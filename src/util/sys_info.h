@@ -5,9 +5,30 @@
 #ifndef UTIL_SYS_INFO_H_
 #define UTIL_SYS_INFO_H_
 
+#include <stdint.h>
+
 #include <string>
 
 std::string OperatingSystemArchitecture();
 int NumberOfProcessors();
 
+// Returns the number of processors the current process can actually use,
+// taking into account its CPU affinity and, on Linux, the CPU quota of its
+// cgroup. Always at least 1 and at most NumberOfProcessors().
+int NumberOfAvailableProcessors();
+
+// Returns the resident set size of the current process in bytes, or 0 if it
+// can't be determined on this platform.
+uint64_t ResidentMemoryBytes();
+
+// Returns the number of CPUs allowed by a cgroup CPU |quota| and |period|,
+// rounded up, or 0 if they don't describe a limit. The quota is "max" or
+// negative when there is no limit. Exposed for testing.
+int CpuLimitFromQuota(const std::string& quota, long long period);
+
+// Returns the strictest CPU limit set by the "cpu.max" files of the cgroup v2
+// |path| under |mount_point| and of all of its ancestors, or 0 if none of them
+// is limited. Exposed for testing.
+int CgroupV2CpuLimit(const std::string& mount_point, const std::string& path);
+
 #endif  // UTIL_SYS_INFO_H_
@@ -0,0 +1,74 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "util/sys_info.h"
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "util/test/test.h"
+
+namespace {
+
+// Writes a "cpu.max" file with the given contents in |dir|, creating it.
+bool WriteCpuMax(const base::FilePath& dir, const std::string& contents) {
+  if (!base::CreateDirectory(dir))
+    return false;
+  int size = static_cast<int>(contents.size());
+  return base::WriteFile(dir.AppendASCII("cpu.max"), contents.data(), size) ==
+         size;
+}
+
+}  // namespace
+
+TEST(SysInfo, CpuLimitFromQuota) {
+  // No limit.
+  EXPECT_EQ(0, CpuLimitFromQuota("max", 100000));
+  EXPECT_EQ(0, CpuLimitFromQuota("-1", 100000));
+  EXPECT_EQ(0, CpuLimitFromQuota("0", 100000));
+  EXPECT_EQ(0, CpuLimitFromQuota("50000", 0));
+
+  // A quota smaller than the period still allows one CPU.
+  EXPECT_EQ(1, CpuLimitFromQuota("50000", 100000));
+  EXPECT_EQ(1, CpuLimitFromQuota("100000", 100000));
+
+  // Partial CPUs are rounded up.
+  EXPECT_EQ(2, CpuLimitFromQuota("150000", 100000));
+  EXPECT_EQ(4, CpuLimitFromQuota("400000", 100000));
+}
+
+TEST(SysInfo, CgroupV2CpuLimit) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath& root = temp_dir.GetPath();
+  std::string mount_point = root.As8Bit();
+
+  // Nothing limited.
+  EXPECT_EQ(0, CgroupV2CpuLimit(mount_point, "/a/b"));
+
+  base::FilePath a = root.AppendASCII("a");
+  base::FilePath b = a.AppendASCII("b");
+  base::FilePath c = b.AppendASCII("c");
+  ASSERT_TRUE(WriteCpuMax(root, "max 100000\n"));
+  ASSERT_TRUE(WriteCpuMax(a, "200000 100000\n"));
+  ASSERT_TRUE(WriteCpuMax(b, "max 100000\n"));
+  ASSERT_TRUE(WriteCpuMax(c, "400000 100000\n"));
+
+  // A stricter ancestor wins over the limit of the cgroup itself, and
+  // unlimited cgroups in between don't reset it.
+  EXPECT_EQ(2, CgroupV2CpuLimit(mount_point, "/a/b/c"));
+  EXPECT_EQ(2, CgroupV2CpuLimit(mount_point, "/a/b/c/"));
+  EXPECT_EQ(2, CgroupV2CpuLimit(mount_point, "/a/b"));
+  EXPECT_EQ(0, CgroupV2CpuLimit(mount_point, "/"));
+
+  // A stricter descendant wins over its ancestors.
+  ASSERT_TRUE(WriteCpuMax(c, "50000 100000\n"));
+  EXPECT_EQ(1, CgroupV2CpuLimit(mount_point, "/a/b/c"));
+
+  // Directories missing from the mount, as when the process sees the path of
+  // its cgroup on the host, still pick up the limits above them.
+  EXPECT_EQ(2, CgroupV2CpuLimit(mount_point, "/a/missing/deeper"));
+}
@@ -7,6 +7,7 @@
 #include "base/command_line.h"
 #include "base/strings/string_number_conversions.h"
 #include "gn/switches.h"
+#include "gn/trace.h"
 #include "util/build_config.h"
 #include "util/sys_info.h"
 
@@ -63,6 +64,14 @@ int GetThreadCount() {
     return result;
   }
 
+  // When the process is restricted to fewer processors than the machine has,
+  // through its affinity mask or a cgroup CPU quota as is common in CI
+  // containers, use exactly what is available: blocking work runs in the I/O
+  // lane so there is no need to oversubscribe to hide its latency.
+  int available = NumberOfAvailableProcessors();
+  if (available < NumberOfProcessors())
+    return available;
+
   // Base the default number of worker threads on number of cores in the
   // system. When building large projects, the speed can be limited by how fast
   // the main thread can dispatch work and connect the dependency graph. If
@@ -81,70 +90,165 @@ int GetThreadCount() {
   return std::max(num_cores - 1, 8);
 }
 
+// Threads in the I/O lane spend most of their time waiting, so there are a few
+// of them even on small machines.
+int GetIoThreadCount(int thread_count) {
+  return std::max(thread_count / 2, 4);
+}
+
+// The pool and lane the current thread works for, if any.
+thread_local WorkerPool* current_pool = nullptr;
+thread_local void* current_lane = nullptr;
+
 }  // namespace
 
+// static
+WorkerPool* WorkerPool::Get() {
+  static WorkerPool* pool = [] {
+    int thread_count = GetThreadCount();
+    return new WorkerPool(thread_count, GetIoThreadCount(thread_count));
+  }();
+  return pool;
+}
+
 WorkerPool::WorkerPool() : WorkerPool(GetThreadCount()) {}
 
-WorkerPool::WorkerPool(size_t thread_count) : should_stop_processing_(false) {
+WorkerPool::WorkerPool(size_t thread_count, size_t io_thread_count)
+    : should_stop_processing_(false) {
+  // The CPU lane has extra threads that only pick up work while other tasks
+  // are blocked, see ScopedBlockingCall.
+  cpu_lane_.max_running = thread_count;
+  io_lane_.max_running = io_thread_count;
+  StartThreads(&cpu_lane_, thread_count + io_thread_count);
+  StartThreads(&io_lane_, io_thread_count);
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::unique_lock<std::mutex> queue_lock(queue_mutex_);
+    should_stop_processing_ = true;
+  }
+
+  cpu_lane_.notifier.notify_all();
+  io_lane_.notifier.notify_all();
+
+  for (Lane* lane : {&cpu_lane_, &io_lane_}) {
+    for (auto& task_thread : lane->threads)
+      task_thread.join();
+  }
+}
+
+void WorkerPool::PostTask(std::function<void()> work) {
+  Post(&cpu_lane_, std::move(work));
+}
+
+void WorkerPool::PostBlockingTask(std::function<void()> work) {
+  Post(io_lane_.threads.empty() ? &cpu_lane_ : &io_lane_, std::move(work));
+}
+
+void WorkerPool::StartThreads(Lane* lane, size_t thread_count) {
 #if defined(OS_WIN)
   ProcessorGroupSetter processor_group_setter;
 #endif
 
-  threads_.reserve(thread_count);
+  lane->threads.reserve(thread_count);
   for (size_t i = 0; i < thread_count; ++i) {
-    threads_.emplace_back([this]() { Worker(); });
+    lane->threads.emplace_back([this, lane]() { Worker(lane); });
 
 #if defined(OS_WIN)
     // Set thread processor group. This is needed for systems with more than 64
     // logical processors, wherein available processors are divided into groups,
     // and applications that need to use more than one group's processors must
     // manually assign their threads to groups.
-    processor_group_setter.SetProcessorGroup(&threads_.back());
+    processor_group_setter.SetProcessorGroup(&lane->threads.back());
 #endif
   }
 }
 
-WorkerPool::~WorkerPool() {
+void WorkerPool::Post(Lane* lane, std::function<void()> work) {
   {
     std::unique_lock<std::mutex> queue_lock(queue_mutex_);
-    should_stop_processing_ = true;
+    CHECK(!should_stop_processing_);
+    lane->task_queue.emplace(std::move(work));
+    AddTraceCounter(lane == &io_lane_ ? TraceCounter::kWorkerPoolIoQueueDepth
+                                      : TraceCounter::kWorkerPoolQueueDepth,
+                    lane->task_queue.size());
   }
 
-  pool_notifier_.notify_all();
+  lane->notifier.notify_one();
+}
+
+void WorkerPool::Worker(Lane* lane) {
+  current_pool = this;
+  current_lane = lane;
+  const TraceCounter queue_depth_counter =
+      lane == &io_lane_ ? TraceCounter::kWorkerPoolIoQueueDepth
+                        : TraceCounter::kWorkerPoolQueueDepth;
+
+  std::unique_lock<std::mutex> queue_lock(queue_mutex_);
+  for (;;) {
+    lane->notifier.wait(queue_lock, [this, lane]() {
+      return should_stop_processing_ ||
+             (!lane->task_queue.empty() &&
+              lane->running < lane->max_running + lane->blocked);
+    });
+
+    if (lane->task_queue.empty())
+      return;  // |should_stop_processing_| is set and all work is done.
+
+    std::function<void()> task = std::move(lane->task_queue.front());
+    lane->task_queue.pop();
+    lane->running++;
+    AddTraceCounter(queue_depth_counter, lane->task_queue.size());
 
-  for (auto& task_thread : threads_) {
-    task_thread.join();
+    queue_lock.unlock();
+    task();
+    task = nullptr;
+    queue_lock.lock();
+
+    // Another thread may have been waiting for this one to finish to respect
+    // |max_running|.
+    lane->running--;
+    if (!lane->task_queue.empty())
+      lane->notifier.notify_one();
   }
 }
 
-void WorkerPool::PostTask(std::function<void()> work) {
+ScopedBlockingCall::ScopedBlockingCall()
+    : pool_(current_pool),
+      lane_(static_cast<WorkerPool::Lane*>(current_lane)) {
+  if (!pool_)
+    return;
   {
-    std::unique_lock<std::mutex> queue_lock(queue_mutex_);
-    CHECK(!should_stop_processing_);
-    task_queue_.emplace(std::move(work));
+    std::unique_lock<std::mutex> queue_lock(pool_->queue_mutex_);
+    lane_->blocked++;
   }
-
-  pool_notifier_.notify_one();
+  lane_->notifier.notify_one();
 }
 
-void WorkerPool::Worker() {
-  for (;;) {
-    std::function<void()> task;
-
-    {
-      std::unique_lock<std::mutex> queue_lock(queue_mutex_);
-
-      pool_notifier_.wait(queue_lock, [this]() {
-        return (!task_queue_.empty()) || should_stop_processing_;
-      });
+ScopedBlockingCall::~ScopedBlockingCall() {
+  if (!pool_)
+    return;
+  std::unique_lock<std::mutex> queue_lock(pool_->queue_mutex_);
+  lane_->blocked--;
+}
 
-      if (should_stop_processing_ && task_queue_.empty())
-        return;
+TaskGroup::TaskGroup(WorkerPool* pool) : pool_(pool) {}
 
-      task = std::move(task_queue_.front());
-      task_queue_.pop();
-    }
+TaskGroup::~TaskGroup() {
+  std::unique_lock<std::mutex> lock(lock_);
+  done_.wait(lock, [this]() { return pending_ == 0; });
+}
 
-    task();
+void TaskGroup::PostTask(std::function<void()> work) {
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    pending_++;
   }
+  pool_->PostTask([this, work = std::move(work)]() {
+    work();
+    std::lock_guard<std::mutex> lock(lock_);
+    if (--pending_ == 0)
+      done_.notify_all();
+  });
 }
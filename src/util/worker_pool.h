@@ -13,25 +13,94 @@
 
 #include "base/logging.h"
 
+// A pool of threads with two lanes: one for CPU-bound work and one for work
+// that mostly waits on I/O. Keeping them apart means that threads blocked on
+// reading files can't prevent parsing and writing from making progress, and
+// the other way around.
 class WorkerPool {
  public:
+  // Returns the process-wide pool, creating it on first use. Its size is based
+  // on the --threads switch or the number of available processors. It is never
+  // destroyed, so callers must wait for their own tasks to complete.
+  static WorkerPool* Get();
+
   WorkerPool();
-  WorkerPool(size_t thread_count);
+
+  // Creates a pool with |thread_count| threads for CPU-bound work. If
+  // |io_thread_count| is 0, blocking tasks share the CPU lane.
+  explicit WorkerPool(size_t thread_count, size_t io_thread_count = 0);
   ~WorkerPool();
 
+  // Posts CPU-bound work.
   void PostTask(std::function<void()> work);
 
+  // Posts work that spends most of its time blocked on I/O, such as reading
+  // a file.
+  void PostBlockingTask(std::function<void()> work);
+
  private:
-  void Worker();
+  friend class ScopedBlockingCall;
+
+  struct Lane {
+    std::vector<std::thread> threads;
+    std::queue<std::function<void()>> task_queue;
+    std::condition_variable_any notifier;
+
+    // Number of tasks allowed to run at once, not counting the ones that are
+    // blocked (see ScopedBlockingCall).
+    size_t max_running = 0;
+    size_t running = 0;
+    size_t blocked = 0;
+  };
 
-  std::vector<std::thread> threads_;
-  std::queue<std::function<void()>> task_queue_;
+  void StartThreads(Lane* lane, size_t thread_count);
+  void Post(Lane* lane, std::function<void()> work);
+  void Worker(Lane* lane);
+
+  Lane cpu_lane_;
+  Lane io_lane_;
   std::mutex queue_mutex_;
-  std::condition_variable_any pool_notifier_;
   bool should_stop_processing_;
 
   WorkerPool(const WorkerPool&) = delete;
   WorkerPool& operator=(const WorkerPool&) = delete;
 };
 
+// Declares that the current task is about to block, for example waiting on a
+// child process. While it exists, the lane running the task may start another
+// one in its place so that the pool stays busy. Does nothing when not called
+// from a worker thread.
+class ScopedBlockingCall {
+ public:
+  ScopedBlockingCall();
+  ~ScopedBlockingCall();
+
+ private:
+  WorkerPool* pool_;
+  WorkerPool::Lane* lane_;
+
+  ScopedBlockingCall(const ScopedBlockingCall&) = delete;
+  ScopedBlockingCall& operator=(const ScopedBlockingCall&) = delete;
+};
+
+// Posts CPU-bound tasks to a pool and waits for all of them to complete when
+// destroyed. It must not be destroyed from a task running on the same pool,
+// since waiting would hold one of its threads.
+class TaskGroup {
+ public:
+  explicit TaskGroup(WorkerPool* pool);
+  ~TaskGroup();
+
+  void PostTask(std::function<void()> work);
+
+ private:
+  WorkerPool* pool_;
+  std::mutex lock_;
+  std::condition_variable done_;
+  size_t pending_ = 0;
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+};
+
 #endif  // UTIL_WORKER_POOL_H_
@@ -0,0 +1,123 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "util/worker_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "util/test/test.h"
+
+namespace {
+
+// Counts the tasks running at once and remembers the highest count.
+class ConcurrencyTracker {
+ public:
+  void Enter() {
+    std::lock_guard<std::mutex> lock(lock_);
+    running_++;
+    max_running_ = std::max(max_running_, running_);
+  }
+
+  void Leave() {
+    std::lock_guard<std::mutex> lock(lock_);
+    running_--;
+  }
+
+  int max_running() {
+    std::lock_guard<std::mutex> lock(lock_);
+    return max_running_;
+  }
+
+ private:
+  std::mutex lock_;
+  int running_ = 0;
+  int max_running_ = 0;
+};
+
+}  // namespace
+
+TEST(WorkerPool, TaskGroupWaitsForAllTasks) {
+  WorkerPool pool(4);
+  std::atomic<int> done(0);
+  {
+    TaskGroup group(&pool);
+    for (int i = 0; i < 100; i++) {
+      group.PostTask([&done]() {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        done++;
+      });
+    }
+  }
+  EXPECT_EQ(100, done.load());
+}
+
+TEST(WorkerPool, BlockedTaskLetsAnotherRun) {
+  // One CPU thread, plus the spare thread the I/O lane adds to the CPU lane.
+  WorkerPool pool(1, 1);
+
+  std::mutex lock;
+  std::condition_variable cv;
+  bool second_ran = false;
+  bool first_saw_second = false;
+  {
+    TaskGroup group(&pool);
+    group.PostTask([&]() {
+      ScopedBlockingCall blocking;
+      std::unique_lock<std::mutex> guard(lock);
+      first_saw_second = cv.wait_for(guard, std::chrono::seconds(10),
+                                     [&]() { return second_ran; });
+    });
+    group.PostTask([&]() {
+      std::lock_guard<std::mutex> guard(lock);
+      second_ran = true;
+      cv.notify_all();
+    });
+  }
+  EXPECT_TRUE(first_saw_second);
+}
+
+TEST(WorkerPool, CpuLaneCap) {
+  WorkerPool pool(2, 2);
+  ConcurrencyTracker tracker;
+  {
+    TaskGroup group(&pool);
+    for (int i = 0; i < 20; i++) {
+      group.PostTask([&tracker]() {
+        tracker.Enter();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        tracker.Leave();
+      });
+    }
+  }
+  EXPECT_LE(tracker.max_running(), 2);
+}
+
+TEST(WorkerPool, IoLaneCap) {
+  WorkerPool pool(4, 2);
+  ConcurrencyTracker tracker;
+  std::mutex lock;
+  std::condition_variable cv;
+  int remaining = 20;
+  for (int i = 0; i < 20; i++) {
+    pool.PostBlockingTask([&]() {
+      tracker.Enter();
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      tracker.Leave();
+      std::lock_guard<std::mutex> guard(lock);
+      if (--remaining == 0)
+        cv.notify_all();
+    });
+  }
+  {
+    std::unique_lock<std::mutex> guard(lock);
+    cv.wait(guard, [&]() { return remaining == 0; });
+  }
+  EXPECT_LE(tracker.max_running(), 2);
+  EXPECT_GE(tracker.max_running(), 1);
+}